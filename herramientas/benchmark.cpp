@@ -0,0 +1,541 @@
+/**
+ * @file benchmark.cpp
+ * @brief Microbenchmarks del decodificador PRT-7 con resultados en JSON
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ * @details Mide ns/op y reservas de memoria/op de las operaciones del camino
+ *          crítico para tamaños de 10 a 10^8 tramas. Las reservas se cuentan
+ *          reemplazando el operator new global con un contador atómico: los
+ *          casos sesiones_N_hilos_H reparten N sesiones entre H hilos con
+ *          GestorDeSesiones y sus reservas también se cuentan.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include "RotorGenerico.h"
+#include "ListaDeCarga.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "PoolDeTramas.h"
+#include "ParserTramas.h"
+#include "ClasificacionLote.h"
+#include "ProgramaDeTramas.h"
+#include "BufferDeReorden.h"
+#include "DecodificacionLote.h"
+#include "FuenteDeLineas.h"
+#include "SesionDecodificacion.h"
+#include "GestorDeSesiones.h"
+#include "Registro.h"
+
+static std::atomic<long long> reservas(0); ///< Llamadas a operator new desde el inicio
+static volatile int sumidero;   ///< Evita que el compilador descarte los resultados
+
+void* operator new(std::size_t tamanio) {
+    reservas.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(tamanio > 0 ? tamanio : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t tamanio) {
+    reservas.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(tamanio > 0 ? tamanio : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/**
+ * @brief Tiempo y reservas de una ejecución de un caso
+ */
+struct Medicion {
+    long long ns;       ///< Nanosegundos de la región medida
+    long long reservas; ///< Reservas de memoria en la región medida
+};
+
+/**
+ * @class Cronometro
+ * @brief Marca el inicio de la región medida de un caso
+ */
+class Cronometro {
+private:
+    std::chrono::steady_clock::time_point inicio; ///< Instante de inicio
+    long long reservasIniciales;                   ///< Contador de reservas al inicio
+
+public:
+    Cronometro() : inicio(std::chrono::steady_clock::now()), reservasIniciales(reservas.load()) {}
+
+    /**
+     * @brief Cierra la región medida
+     * @return Tiempo y reservas transcurridos desde la construcción
+     */
+    Medicion detener() const {
+        Medicion m;
+        m.reservas = reservas.load() - reservasIniciales;
+        m.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - inicio).count();
+        return m;
+    }
+};
+
+/// Texto de entrada para los casos que mapean caracteres (64 bytes)
+static const char TEXTO[] = "HOLAMUNDO DECODIFICADOR PRT-7 ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456";
+
+/// Líneas de entrada para los casos de parseo
+static const char* LINEAS[16] = {
+    "L,H", "L,O", "L,L", "M,2", "L,A", "L, ", "L,W", "M,-2",
+    "L,O", "L,R", "L,L", "L,D", "M,13", "L,Z", "M,-25", "L,Q"
+};
+
+static Medicion casoRotar(long long n) {
+    static const int pasos[8] = { 1, -3, 5, -7, 11, 2, -13, 4 };
+    RotorDeMapeo rotor;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        rotor.rotar(pasos[i & 7]);
+    }
+    Medicion m = cronometro.detener();
+    sumidero = rotor.getPosicion();
+    return m;
+}
+
+static Medicion casoGetMapeo(long long n) {
+    RotorDeMapeo rotor;
+    rotor.rotar(7);
+    int acumulado = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        acumulado += rotor.getMapeo(TEXTO[i & 63]);
+    }
+    Medicion m = cronometro.detener();
+    sumidero = acumulado;
+    return m;
+}
+
+static Medicion casoGetMapeoCascada(long long n) {
+    // Tres rotores con avance por carga: el costo no debe crecer con K
+    CascadaDeRotores cascada;
+    cascada.configurar("EKMFLGDQVZNTOWYHXUSPAIBRCJ:Q,AJDKSIRUXBLHWTMCQGZNPYFVOE:E,"
+                       "BDFHJLCPRTXVZNYEIWGAKMUSQO:V", true);
+    RotorDeMapeo rotor;
+    rotor.rotar(7);
+    rotor.setCascada(&cascada);
+    int acumulado = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        acumulado += rotor.getMapeo(TEXTO[i & 63]);
+    }
+    Medicion m = cronometro.detener();
+    sumidero = acumulado;
+    return m;
+}
+
+template <typename Alfabeto>
+static Medicion casoGetMapeoGenerico(long long n) {
+    RotorGenerico<Alfabeto> rotor;
+    rotor.rotar(7);
+    int acumulado = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        acumulado += rotor.getMapeo(TEXTO[i & 63]);
+    }
+    Medicion m = cronometro.detener();
+    sumidero = acumulado;
+    return m;
+}
+
+static Medicion casoInsertarAlFinal(long long n) {
+    ListaDeCarga* carga = new ListaDeCarga();
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        carga->insertarAlFinal(TEXTO[i & 63]);
+    }
+    Medicion m = cronometro.detener();
+    sumidero = carga->getTamanio();
+    delete carga;
+    return m;
+}
+
+static Medicion casoParsearTrama(long long n) {
+    int acumulado = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        TramaBase* trama = parsearTrama(LINEAS[i & 15]);
+        acumulado += (trama != nullptr);
+        delete trama;
+    }
+    Medicion m = cronometro.detener();
+    sumidero = acumulado;
+    return m;
+}
+
+static Medicion casoParsearTramaPool(long long n) {
+    PoolDeTramas pool;
+    int acumulado = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        acumulado += (parsearTrama(LINEAS[i & 15], &pool) != nullptr);
+    }
+    Medicion m = cronometro.detener();
+    sumidero = acumulado;
+    return m;
+}
+
+/**
+ * @brief Clasifica n líneas con clasificarLote() sobre un buffer de texto que se recorre en ciclo
+ * @param lineas Líneas que forman el buffer, repetidas en orden
+ * @param numLineas Número de líneas distintas (divide a LINEAS_BUFFER)
+ * @param n Líneas a clasificar
+ */
+static Medicion medirClasificarLote(const char* const* lineas, int numLineas, long long n) {
+    static const int LINEAS_BUFFER = 16384;
+    static const int CAPACIDAD = 1024;
+    size_t longitud = 0;
+    for (int i = 0; i < numLineas; i++) longitud += strlen(lineas[i]) + 1;
+    longitud *= LINEAS_BUFFER / numLineas;
+    char* texto = new char[longitud];
+    size_t escritos = 0;
+    for (int i = 0; i < LINEAS_BUFFER; i++) {
+        size_t largo = strlen(lineas[i % numLineas]);
+        memcpy(texto + escritos, lineas[i % numLineas], largo);
+        texto[escritos + largo] = '\n';
+        escritos += largo + 1;
+    }
+    TramaCompacta* salida = new TramaCompacta[CAPACIDAD];
+
+    int acumulado = 0;
+    size_t posicion = 0;
+    long long hechas = 0;
+    Cronometro cronometro;
+    while (hechas < n) {
+        int capacidad = (n - hechas < CAPACIDAD) ? (int)(n - hechas) : CAPACIDAD;
+        ResultadoLote lote = clasificarLote(texto + posicion, longitud - posicion, salida, capacidad);
+        acumulado += salida[lote.tramas - 1].valor;
+        hechas += lote.lineas;
+        posicion += lote.consumidos;
+        if (posicion == longitud) posicion = 0;
+    }
+    Medicion m = cronometro.detener();
+
+    sumidero = acumulado;
+    delete[] salida;
+    delete[] texto;
+    return m;
+}
+
+static Medicion casoClasificarLote(long long n) {
+    static const char* CARGAS[16] = {
+        "L,H", "L,O", "L,L", "L,A", "L,M", "L,U", "L,N", "L,D",
+        "L,O", "L, ", "L,P", "L,R", "L,T", "L,-", "L,7", "L,Q"
+    };
+    return medirClasificarLote(CARGAS, 16, n);
+}
+
+static Medicion casoClasificarLoteMixto(long long n) {
+    return medirClasificarLote(LINEAS, 16, n);
+}
+
+static Medicion casoEjecutarPrograma(long long n) {
+    // Las mismas tramas que los casos de parseo, compiladas fuera de la región medida
+    TramaCompacta tramas[16];
+    for (int i = 0; i < 16; i++) {
+        tramas[i] = clasificarTrama(LINEAS[i], (int)strlen(LINEAS[i]));
+    }
+    RotorDeMapeo* rotor = new RotorDeMapeo();
+    ListaDeCarga* carga = new ListaDeCarga();
+    ProgramaDeTramas* programa = new ProgramaDeTramas(rotor->getTamanio());
+    for (long long i = 0; i + 16 <= n; i += 16) programa->compilar(tramas, 16);
+    programa->compilar(tramas, (int)(n % 16));
+
+    Cronometro cronometro;
+    programa->ejecutar(rotor, carga);
+    Medicion m = cronometro.detener();
+
+    sumidero = carga->getTamanio();
+    delete programa;
+    delete carga;
+    delete rotor;
+    return m;
+}
+
+static Medicion casoReordenar(long long n) {
+    // Cada par de tramas llega invertido: la mitad espera en la ventana a la anterior
+    TramaCompacta trama = clasificarTrama("L,A", 3);
+    TramaCompacta salida[2];
+    BufferDeReorden* reorden = new BufferDeReorden(BufferDeReorden::CAPACIDAD_POR_DEFECTO,
+                                                   BufferDeReorden::ESPERA_POR_DEFECTO_MS);
+    reorden->fijarInicio(0);
+    OrigenTrama origen;
+    origen.byte = -1;
+    origen.sinNumero = 0;
+    long long entregadas = 0;
+
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        origen.linea = i;
+        reorden->insertar((unsigned int)(i ^ 1), trama, origen);
+        entregadas += reorden->extraer(salida, 2);
+    }
+    Medicion m = cronometro.detener();
+
+    sumidero = (int)entregadas;
+    delete reorden;
+    return m;
+}
+
+static Medicion casoProcesarVirtual(long long n) {
+    TramaBase* tramas[16];
+    for (int i = 0; i < 16; i++) {
+        tramas[i] = parsearTrama(LINEAS[i]);
+    }
+    RotorDeMapeo* rotor = new RotorDeMapeo();
+    ListaDeCarga* carga = new ListaDeCarga();
+
+    Cronometro cronometro;
+    for (long long i = 0; i < n; i++) {
+        tramas[i & 15]->procesar(carga, rotor);
+    }
+    Medicion m = cronometro.detener();
+
+    sumidero = carga->getTamanio();
+    delete carga;
+    delete rotor;
+    for (int i = 0; i < 16; i++) {
+        delete tramas[i];
+    }
+    return m;
+}
+
+/**
+ * @class FuenteMemoria
+ * @brief Fuente de líneas sobre un texto en memoria, que nunca espera datos
+ */
+class FuenteMemoria : public FuenteDeLineas {
+private:
+    const char* datos; ///< Texto de la captura (no se libera)
+    size_t tamanio;    ///< Bytes del texto
+    size_t posicion;   ///< Siguiente byte sin consumir
+
+public:
+    FuenteMemoria(const char* texto, size_t bytes) : datos(texto), tamanio(bytes), posicion(0) {}
+
+    virtual int leerLineaDisponible(const char** linea, int* longitud) override {
+        if (posicion >= tamanio) return FIN_DE_FUENTE;
+        const char* inicio = datos + posicion;
+        const char* nl = (const char*)memchr(inicio, '\n', tamanio - posicion);
+        const char* fin = nl != nullptr ? nl : datos + tamanio;
+        posicion = (size_t)(fin - datos) + (nl != nullptr ? 1 : 0);
+        if (fin > inicio && fin[-1] == '\r') fin--;
+        *linea = inicio;
+        *longitud = (int)(fin - inicio);
+        return LINEA_OBTENIDA;
+    }
+
+    virtual int asomarBytes(const char** bytes, size_t* longitud) override {
+        if (posicion >= tamanio) return FIN_DE_FUENTE;
+        *bytes = datos + posicion;
+        *longitud = tamanio - posicion;
+        return LINEA_OBTENIDA;
+    }
+
+    virtual void consumirBytes(size_t cantidad) override {
+        posicion += cantidad;
+    }
+};
+
+template <int Sesiones, int Hilos>
+static Medicion casoSesiones(long long n) {
+    // Cada sesión decodifica n / Sesiones líneas del mismo texto; el gestor fija la sesión i al hilo i % Hilos
+    long long lineas = (n + Sesiones - 1) / Sesiones;
+    size_t bytes = 0;
+    for (long long i = 0; i < lineas; i++) bytes += strlen(LINEAS[i & 15]) + 1;
+    char* texto = new char[bytes > 0 ? bytes : 1];
+    size_t escritos = 0;
+    for (long long i = 0; i < lineas; i++) {
+        size_t longitud = strlen(LINEAS[i & 15]);
+        memcpy(texto + escritos, LINEAS[i & 15], longitud);
+        texto[escritos + longitud] = '\n';
+        escritos += longitud + 1;
+    }
+
+    FuenteMemoria* fuentes[Sesiones];
+    SesionDecodificacion* sesiones[Sesiones];
+    GestorDeSesiones* gestor = new GestorDeSesiones(Hilos);
+    for (int i = 0; i < Sesiones; i++) {
+        fuentes[i] = new FuenteMemoria(texto, bytes);
+        sesiones[i] = new SesionDecodificacion("memoria", fuentes[i]);
+        gestor->agregarSesion(sesiones[i]);
+    }
+
+    Cronometro cronometro;
+    gestor->ejecutar();
+    Medicion m = cronometro.detener();
+
+    long long total = 0;
+    for (int i = 0; i < Sesiones; i++) {
+        total += sesiones[i]->getCarga()->getTamanio();
+        delete sesiones[i];
+        delete fuentes[i];
+    }
+    sumidero = (int)total;
+    delete gestor;
+    delete[] texto;
+    return m;
+}
+
+/**
+ * @brief Caso de benchmark con nombre
+ */
+struct Caso {
+    const char* nombre;             ///< Nombre en el JSON
+    Medicion (*ejecutar)(long long); ///< Ejecuta n operaciones
+};
+
+static const Caso CASOS[] = {
+    { "rotar", casoRotar },
+    { "getMapeo", casoGetMapeo },
+    { "getMapeo_cascada", casoGetMapeoCascada },
+    { "getMapeo_generico26", casoGetMapeoGenerico<AlfabetoMayusculas> },
+    { "getMapeo_generico36", casoGetMapeoGenerico<AlfabetoAlfanumerico> },
+    { "getMapeo_generico64", casoGetMapeoGenerico<AlfabetoBase64> },
+    { "getMapeo_generico256", casoGetMapeoGenerico<AlfabetoBytes> },
+    { "insertarAlFinal", casoInsertarAlFinal },
+    { "parsearTrama", casoParsearTrama },
+    { "parsearTrama_pool", casoParsearTramaPool },
+    { "clasificarLote", casoClasificarLote },
+    { "clasificarLote_mixto", casoClasificarLoteMixto },
+    { "ejecutarPrograma", casoEjecutarPrograma },
+    { "reordenar", casoReordenar },
+    { "procesar_virtual", casoProcesarVirtual },
+    { "sesiones_8_hilos_1", casoSesiones<8, 1> },
+    { "sesiones_8_hilos_2", casoSesiones<8, 2> },
+    { "sesiones_8_hilos_4", casoSesiones<8, 4> },
+    { "sesiones_8_hilos_8", casoSesiones<8, 8> },
+    { "sesiones_6_hilos_4", casoSesiones<6, 4> }
+};
+static const int NUM_CASOS = sizeof(CASOS) / sizeof(CASOS[0]);
+
+/**
+ * @brief Muestra las opciones de línea de comandos
+ * @param programa Nombre del ejecutable
+ */
+static void mostrarUso(const char* programa) {
+    fprintf(stderr,
+            "Uso: %s [--min N] [--max N] [--min-ms M] [--caso NOMBRE] [--salida RUTA]\n"
+            "     --min N         tamaño inicial en tramas (default: 10)\n"
+            "     --max N         tamaño final en tramas, por potencias de 10 (default: 100000000)\n"
+            "     --min-ms M      tiempo mínimo por tamaño; los tamaños chicos se repiten (default: 50)\n"
+            "     --caso NOMBRE   ejecutar sólo un caso\n"
+            "     --salida RUTA   escribir el JSON en un archivo en lugar de stdout\n"
+            "Casos:",
+            programa);
+    for (int c = 0; c < NUM_CASOS; c++) {
+        fprintf(stderr, " %s", CASOS[c].nombre);
+    }
+    fprintf(stderr, "\n");
+}
+
+/**
+ * @brief Función principal del benchmark
+ * @param argc Número de argumentos
+ * @param argv Argumentos
+ */
+int main(int argc, char* argv[]) {
+    long long minimo = 10;
+    long long maximo = 100000000LL;
+    long long minimoNs = 50LL * 1000000LL;
+    const char* soloCaso = nullptr;
+    const char* rutaSalida = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min") == 0 && i + 1 < argc) {
+            minimo = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            maximo = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            minimoNs = atoll(argv[++i]) * 1000000LL;
+        } else if (strcmp(argv[i], "--caso") == 0 && i + 1 < argc) {
+            soloCaso = argv[++i];
+        } else if (strcmp(argv[i], "--salida") == 0 && i + 1 < argc) {
+            rutaSalida = argv[++i];
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    if (minimo < 1 || maximo < minimo) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+
+    FILE* salida = stdout;
+    if (rutaSalida != nullptr) {
+        salida = fopen(rutaSalida, "w");
+        if (salida == nullptr) {
+            fprintf(stderr, "Error: No se pudo crear %s\n", rutaSalida);
+            return 1;
+        }
+    }
+
+    // Las operaciones medidas no deben escribir nada
+    Registro::setNivel(REGISTRO_SILENCIOSO);
+
+    fprintf(salida, "{\n  \"implementacion_lote\": \"%s\",\n", getImplementacionLote());
+    fprintf(salida, "  \"nivel_registro_maximo\": %d,\n", PRT7_NIVEL_REGISTRO_MAXIMO);
+    fprintf(salida, "  \"resultados\": [");
+
+    bool primero = true;
+    for (int c = 0; c < NUM_CASOS; c++) {
+        if (soloCaso != nullptr && strcmp(soloCaso, CASOS[c].nombre) != 0) continue;
+
+        for (long long n = minimo; n <= maximo; n *= 10) {
+            // Los tamaños chicos se repiten hasta acumular un tiempo mínimo
+            long long totalNs = 0;
+            long long totalReservas = 0;
+            long long repeticiones = 0;
+            std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+            do {
+                Medicion m = CASOS[c].ejecutar(n);
+                totalNs += m.ns;
+                totalReservas += m.reservas;
+                repeticiones++;
+            } while (std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - inicio).count() < minimoNs);
+
+            double operaciones = (double)n * (double)repeticiones;
+            fprintf(salida, "%s\n    {\"caso\": \"%s\", \"tramas\": %lld, \"repeticiones\": %lld, "
+                            "\"ns_por_op\": %.3f, \"reservas_por_op\": %.6f}",
+                    primero ? "" : ",", CASOS[c].nombre, n, repeticiones,
+                    (double)totalNs / operaciones, (double)totalReservas / operaciones);
+            primero = false;
+            fflush(salida);
+
+            if (n > maximo / 10) break;
+        }
+    }
+
+    fprintf(salida, "\n  ]\n}\n");
+    if (salida != stdout) fclose(salida);
+    return 0;
+}
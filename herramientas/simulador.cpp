@@ -0,0 +1,645 @@
+/**
+ * @file simulador.cpp
+ * @brief Simulador del Arduino PRT-7 sobre un pseudo-terminal para pruebas de extremo a extremo
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ * @details Abre un par pty, escribe tráfico PRT-7 sintético en el maestro a la
+ *          tasa y velocidad pedidas, y decodifica el esclavo con SerialReader y
+ *          SesionDecodificacion en otro hilo, igual que el programa principal.
+ *          Al final compara el mensaje decodificado con el esperado y reporta
+ *          la tasa sostenida. Con --secuencia las tramas se numeran (S,n,TRAMA)
+ *          y se pueden desordenar o perder, como en un puente UDP o de radio.
+ *          Con --puertos N el tráfico se reparte entre N pseudo-terminales, que
+ *          se decodifican con un hilo por puerto o, con --eventos, con
+ *          BucleEventos en un solo hilo.
+ *          Sólo funciona en sistemas tipo Unix.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "SerialReader.h"
+#include "FuenteDeLineas.h"
+#include "SesionDecodificacion.h"
+#include "Metricas.h"
+#include "RotorDeMapeo.h"
+#include "BufferDeReorden.h"
+#include "GestorDeSesiones.h"
+#include "BucleEventos.h"
+#include "Registro.h"
+
+/**
+ * @brief Parámetros del tráfico simulado
+ */
+struct OpcionesSimulador {
+    long long tramas;      ///< Tramas válidas a generar
+    double tasa;           ///< Tramas por segundo (0 = sin límite)
+    int baudios;           ///< Velocidad simulada del enlace (10 bits por byte)
+    int rafaga;            ///< Tramas que se envían juntas
+    double malformadas;    ///< Porcentaje de líneas malformadas intercaladas
+    double largas;         ///< Porcentaje de líneas muy largas intercaladas
+    int longitudLarga;     ///< Bytes de cada línea larga
+    long long pausaCada;   ///< Tramas entre pausas (0 = sin pausas)
+    int pausaMs;           ///< Duración de cada pausa
+    bool descartar;        ///< Descartar tramas en lugar de esperar si el pty está lleno
+    bool secuencia;        ///< Enviar la variante numerada S,n,TRAMA
+    double desorden;       ///< Porcentaje de tramas numeradas que se envían tarde
+    int retraso;           ///< Tramas que se adelantan a cada trama demorada
+    double perdidas;       ///< Porcentaje de tramas numeradas que no se envían
+    int reorden;           ///< Ranuras del buffer de reorden del decodificador
+    int esperaReorden;     ///< Espera del decodificador por una trama faltante, en ms
+    int puertos;           ///< Pseudo-terminales simulados a la vez
+    bool eventos;          ///< Decodificar todos los puertos con BucleEventos en un solo hilo
+    unsigned long long semilla; ///< Semilla del generador
+};
+
+/**
+ * @brief Estado compartido con el hilo decodificador
+ */
+struct ContextoDecodificador {
+    GestorDeSesiones* gestor;   ///< Un hilo por puerto (sin --eventos)
+    BucleEventos* bucle;        ///< Un solo hilo para todos los puertos (con --eventos)
+    std::atomic<bool> terminado; ///< Todas las sesiones recibieron "END" o se detuvieron
+    long long finNs;            ///< Fin de la decodificación
+};
+
+/// Espera máxima por el decodificador tras enviar "END"
+static const long long ESPERA_FINAL_NS = 2000000000LL;
+
+/// Líneas malformadas que el decodificador debe descartar
+static const char* MALFORMADAS[] = { "X,A", "L", "L;A", "L,AB", "M", ",,,", "Z,9", "LA" };
+static const int NUM_MALFORMADAS = sizeof(MALFORMADAS) / sizeof(MALFORMADAS[0]);
+
+/**
+ * @brief Trama numerada que se envía después de las siguientes
+ */
+struct TramaDemorada {
+    char linea[32]; ///< Línea completa, con su número
+    int longitud;   ///< Bytes de la línea
+    bool ocupada;   ///< Hay una trama esperando en esta posición
+};
+
+/**
+ * @brief Generador xorshift64: rápido y reproducible con la misma semilla
+ * @param estado Estado del generador (se actualiza)
+ * @return Siguiente número pseudoaleatorio
+ */
+static unsigned long long siguienteAleatorio(unsigned long long* estado) {
+    unsigned long long x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *estado = x;
+    return x;
+}
+
+/**
+ * @brief Devuelve true con la probabilidad indicada
+ * @param estado Estado del generador
+ * @param porcentaje Probabilidad en porcentaje
+ */
+static bool sortear(unsigned long long* estado, double porcentaje) {
+    if (porcentaje <= 0.0) return false;
+    return (double)(siguienteAleatorio(estado) % 1000000ULL) < porcentaje * 10000.0;
+}
+
+/**
+ * @brief Hilo decodificador: atiende todas las sesiones hasta "END" o hasta que se detenga
+ */
+static void decodificar(ContextoDecodificador* contexto) {
+    if (contexto->bucle != nullptr) {
+        contexto->bucle->ejecutar();
+    } else {
+        contexto->gestor->ejecutar();
+    }
+    contexto->finNs = Metricas::ahoraNs();
+    contexto->terminado.store(true);
+}
+
+/**
+ * @class Escritor
+ * @brief Escribe en el maestro del pty con buffer, respetando el modo de descarte
+ */
+class Escritor {
+private:
+    int fd;              ///< Maestro del pty
+    char buffer[4096];   ///< Tramas pendientes de escribir
+    int pendientes;      ///< Bytes en buffer
+    long long enviados;  ///< Bytes escritos en total
+
+    /**
+     * @brief Escribe todos los bytes, esperando con poll() si el pty está lleno
+     */
+    void escribirCompleto(const char* datos, int cantidad) {
+        while (cantidad > 0) {
+            ssize_t n = write(fd, datos, (size_t)cantidad);
+            if (n < 0) {
+                if (errno != EAGAIN && errno != EINTR) return;
+                struct pollfd pfd;
+                pfd.fd = fd;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                poll(&pfd, 1, 100);
+                continue;
+            }
+            datos += n;
+            cantidad -= (int)n;
+            enviados += n;
+        }
+    }
+
+public:
+    Escritor(int descriptor) : fd(descriptor), pendientes(0), enviados(0) {}
+
+    /**
+     * @brief Envía una línea
+     * @param linea Bytes de la línea, sin '\n'
+     * @param longitud Longitud de la línea
+     * @param descartable true si puede descartarse cuando el pty está lleno
+     * @return false si la línea se descartó
+     */
+    bool enviar(const char* linea, int longitud, bool descartable) {
+        if (descartable) {
+            // En modo descarte cada trama es una escritura: o entra completa o no entra
+            vaciar();
+            char trama[64];
+            if (longitud + 1 > (int)sizeof(trama)) return false;
+            memcpy(trama, linea, (size_t)longitud);
+            trama[longitud] = '\n';
+            ssize_t n = write(fd, trama, (size_t)longitud + 1);
+            if (n < 0) return false;
+            enviados += n;
+            if (n < longitud + 1) escribirCompleto(trama + n, longitud + 1 - (int)n);
+            return true;
+        }
+        if (pendientes + longitud + 1 > (int)sizeof(buffer)) vaciar();
+        if (longitud + 1 > (int)sizeof(buffer)) {
+            escribirCompleto(linea, longitud);
+            escribirCompleto("\n", 1);
+            return true;
+        }
+        memcpy(buffer + pendientes, linea, (size_t)longitud);
+        buffer[pendientes + longitud] = '\n';
+        pendientes += longitud + 1;
+        return true;
+    }
+
+    /**
+     * @brief Escribe lo pendiente en el buffer
+     */
+    void vaciar() {
+        escribirCompleto(buffer, pendientes);
+        pendientes = 0;
+    }
+
+    /**
+     * @brief Bytes enviados más los pendientes
+     * @return Bytes
+     */
+    long long getBytes() const {
+        return enviados + pendientes;
+    }
+};
+
+/**
+ * @brief Un pseudo-terminal simulado con su sesión y su mensaje esperado
+ */
+struct PuertoSimulado {
+    int maestro;                 ///< Maestro del pty (lado del Arduino)
+    char nombre[64];             ///< Ruta del esclavo
+    SerialReader* lector;        ///< Esclavo abierto como puerto serial
+    FuenteSerial* fuente;        ///< Fuente de líneas sobre el esclavo
+    SesionDecodificacion* sesion; ///< Sesión que decodifica el esclavo
+    Escritor* escritor;          ///< Escritor sobre el maestro
+    RotorDeMapeo* referencia;    ///< Rotor de referencia para el mensaje esperado
+    char* esperado;              ///< Mensaje que debe decodificarse
+    long long longitudEsperada;  ///< Caracteres en esperado
+    TramaDemorada* enEspera;     ///< Tramas demoradas, por turno módulo retraso
+    bool iniciado;               ///< Ya salió alguna trama: la sesión numerada ya se reconoce
+};
+
+/**
+ * @brief Muestra las opciones de línea de comandos
+ * @param programa Nombre del ejecutable
+ */
+static void mostrarUso(const char* programa) {
+    fprintf(stderr,
+            "Uso: %s [opciones]\n"
+            "     --tramas N          tramas válidas a enviar (default: 100000)\n"
+            "     --tasa F            tramas por segundo (default: 0 = sin límite)\n"
+            "     --baudios B         velocidad simulada del enlace (default: 115200, 0 = sin límite)\n"
+            "     --rafaga K          tramas por ráfaga (default: 1)\n"
+            "     --malformadas P     %% de líneas malformadas intercaladas (default: 0)\n"
+            "     --largas P          %% de líneas muy largas intercaladas (default: 0)\n"
+            "     --longitud-larga N  bytes de cada línea larga (default: 4096)\n"
+            "     --pausa-cada N      pausa cada N tramas (default: 0 = nunca)\n"
+            "     --pausa-ms M        duración de cada pausa (default: 200)\n"
+            "     --descartar         descartar tramas si el pty está lleno en lugar de esperar\n"
+            "     --secuencia         numerar las tramas (S,n,TRAMA)\n"
+            "     --desorden P        %% de tramas numeradas que se envían tarde (default: 0)\n"
+            "     --retraso K         tramas que se adelantan a cada trama demorada (default: 8)\n"
+            "     --perdidas P        %% de tramas numeradas que se pierden (default: 0)\n"
+            "     --reorden N         ranuras del buffer de reorden del decodificador (default: 256)\n"
+            "     --reorden-espera MS espera del decodificador por una trama faltante (default: 50)\n"
+            "     --puertos N         pseudo-terminales simulados a la vez (default: 1)\n"
+            "     --eventos           decodificarlos con el bucle de eventos en un solo hilo\n"
+            "                         (default: un hilo por puerto)\n"
+            "     --semilla S         semilla del generador (default: 1)\n",
+            programa);
+}
+
+/**
+ * @brief Interpreta la línea de comandos
+ * @return false si hay una opción inválida
+ */
+static bool interpretarOpciones(int argc, char* argv[], OpcionesSimulador* o) {
+    o->tramas = 100000;
+    o->tasa = 0.0;
+    o->baudios = 115200;
+    o->rafaga = 1;
+    o->malformadas = 0.0;
+    o->largas = 0.0;
+    o->longitudLarga = 4096;
+    o->pausaCada = 0;
+    o->pausaMs = 200;
+    o->descartar = false;
+    o->secuencia = false;
+    o->desorden = 0.0;
+    o->retraso = 8;
+    o->perdidas = 0.0;
+    o->reorden = BufferDeReorden::CAPACIDAD_POR_DEFECTO;
+    o->esperaReorden = BufferDeReorden::ESPERA_POR_DEFECTO_MS;
+    o->puertos = 1;
+    o->eventos = false;
+    o->semilla = 1;
+
+    for (int i = 1; i < argc; i++) {
+        bool hayValor = i + 1 < argc;
+        if (strcmp(argv[i], "--tramas") == 0 && hayValor) {
+            o->tramas = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--tasa") == 0 && hayValor) {
+            o->tasa = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--baudios") == 0 && hayValor) {
+            o->baudios = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rafaga") == 0 && hayValor) {
+            o->rafaga = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--malformadas") == 0 && hayValor) {
+            o->malformadas = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--largas") == 0 && hayValor) {
+            o->largas = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--longitud-larga") == 0 && hayValor) {
+            o->longitudLarga = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--pausa-cada") == 0 && hayValor) {
+            o->pausaCada = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--pausa-ms") == 0 && hayValor) {
+            o->pausaMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--descartar") == 0) {
+            o->descartar = true;
+        } else if (strcmp(argv[i], "--secuencia") == 0) {
+            o->secuencia = true;
+        } else if (strcmp(argv[i], "--desorden") == 0 && hayValor) {
+            o->desorden = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--retraso") == 0 && hayValor) {
+            o->retraso = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--perdidas") == 0 && hayValor) {
+            o->perdidas = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--reorden") == 0 && hayValor) {
+            o->reorden = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reorden-espera") == 0 && hayValor) {
+            o->esperaReorden = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--puertos") == 0 && hayValor) {
+            o->puertos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--eventos") == 0) {
+            o->eventos = true;
+        } else if (strcmp(argv[i], "--semilla") == 0 && hayValor) {
+            o->semilla = strtoull(argv[++i], nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+    if (o->semilla == 0) o->semilla = 1;
+    return o->tramas >= 0 && o->rafaga >= 1 && o->longitudLarga >= 3 && o->baudios >= 0 && o->retraso >= 1 &&
+           o->puertos >= 1;
+}
+
+/**
+ * @brief Función principal del simulador
+ * @param argc Número de argumentos
+ * @param argv Argumentos
+ * @return 0 si el mensaje decodificado coincide, 2 si no, 1 ante errores
+ */
+int main(int argc, char* argv[]) {
+    OpcionesSimulador opciones;
+    if (!interpretarOpciones(argc, argv, &opciones)) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+    if (opciones.eventos && !BucleEventos::estaDisponible()) {
+        fprintf(stderr, "Error: --eventos requiere epoll (Linux)\n");
+        return 1;
+    }
+    Registro::setNivel(REGISTRO_SILENCIOSO);
+
+    int numPuertos = opciones.puertos;
+    long long tramasPorPuerto = (opciones.tramas + numPuertos - 1) / numPuertos;
+    PuertoSimulado* puertos = new PuertoSimulado[numPuertos];
+    int abiertos = 0;
+    bool error = false;
+    for (; abiertos < numPuertos; abiertos++) {
+        PuertoSimulado* p = &puertos[abiertos];
+        p->nombre[0] = '\0';
+        p->maestro = posix_openpt(O_RDWR | O_NOCTTY);
+        if (p->maestro < 0 || grantpt(p->maestro) != 0 || unlockpt(p->maestro) != 0) {
+            perror("Error: No se pudo crear el pseudo-terminal");
+            if (p->maestro >= 0) close(p->maestro);
+            error = true;
+            break;
+        }
+        snprintf(p->nombre, sizeof(p->nombre), "%s", ptsname(p->maestro));
+        if (opciones.descartar) fcntl(p->maestro, F_SETFL, fcntl(p->maestro, F_GETFL) | O_NONBLOCK);
+
+        p->lector = new SerialReader(p->nombre, opciones.baudios > 0 ? opciones.baudios : 115200);
+        if (!p->lector->estaConectado()) {
+            delete p->lector;
+            close(p->maestro);
+            error = true;
+            break;
+        }
+        p->fuente = new FuenteSerial(p->lector);
+        p->sesion = new SesionDecodificacion(p->nombre, p->fuente);
+        p->sesion->setReorden(opciones.reorden, opciones.esperaReorden);
+        p->escritor = new Escritor(p->maestro);
+        // El mensaje esperado se calcula con un rotor de referencia a medida que se envía
+        p->referencia = new RotorDeMapeo();
+        p->esperado = new char[tramasPorPuerto > 0 ? tramasPorPuerto : 1];
+        p->longitudEsperada = 0;
+        p->enEspera = new TramaDemorada[opciones.retraso];
+        for (int k = 0; k < opciones.retraso; k++) p->enEspera[k].ocupada = false;
+        p->iniciado = false;
+    }
+
+    GestorDeSesiones gestor(numPuertos);
+    BucleEventos bucle;
+    ContextoDecodificador contexto;
+    contexto.gestor = &gestor;
+    contexto.bucle = opciones.eventos ? &bucle : nullptr;
+    contexto.terminado.store(false);
+    contexto.finNs = 0;
+    for (int p = 0; p < abiertos; p++) {
+        if (opciones.eventos) {
+            bucle.agregarSesion(puertos[p].sesion);
+        } else {
+            gestor.agregarSesion(puertos[p].sesion);
+        }
+    }
+
+    char* lineaLarga = new char[opciones.longitudLarga];
+    lineaLarga[0] = 'L';
+    lineaLarga[1] = ',';
+    memset(lineaLarga + 2, 'A', (size_t)opciones.longitudLarga - 2);
+
+    unsigned long long aleatorio = opciones.semilla;
+    long long descartadas = 0;
+    long long malformadas = 0;
+    long long largas = 0;
+    long long perdidas = 0;
+    long long demoradas = 0;
+    double bytesPorSegundo = opciones.baudios / 10.0;
+    long long bytesEnviados = 0;
+    long long desfaseNs = 0;
+    long long inicio = Metricas::ahoraNs();
+    long long finEscritura = inicio;
+
+    if (!error) {
+        std::thread decodificador(decodificar, &contexto);
+
+        for (long long i = 0; i < opciones.tramas; i++) {
+            // Cada ráfaga sale cuando lo permiten la tasa y la velocidad de los enlaces,
+            // que transmiten en paralelo
+            if (i % opciones.rafaga == 0) {
+                long long objetivo = 0;
+                if (opciones.tasa > 0.0) objetivo = (long long)(i / opciones.tasa * 1e9);
+                if (bytesPorSegundo > 0.0) {
+                    long long porEnlace = (long long)(bytesEnviados / numPuertos / bytesPorSegundo * 1e9);
+                    if (porEnlace > objetivo) objetivo = porEnlace;
+                }
+                objetivo += inicio + desfaseNs;
+                if (objetivo > Metricas::ahoraNs()) {
+                    for (int p = 0; p < numPuertos; p++) puertos[p].escritor->vaciar();
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(objetivo - Metricas::ahoraNs()));
+                }
+            }
+            if (opciones.pausaCada > 0 && i > 0 && i % opciones.pausaCada == 0) {
+                for (int p = 0; p < numPuertos; p++) puertos[p].escritor->vaciar();
+                std::this_thread::sleep_for(std::chrono::milliseconds(opciones.pausaMs));
+                desfaseNs += (long long)opciones.pausaMs * 1000000LL;
+            }
+
+            // Las tramas se reparten entre los puertos por turno; cada puerto numera las suyas
+            PuertoSimulado* puerto = &puertos[i % numPuertos];
+            long long n = i / numPuertos;
+            Escritor* escritor = puerto->escritor;
+            long long bytesAntes = escritor->getBytes();
+
+            // Una sesión numerada se reconoce por su primera línea: la basura va después
+            bool admiteBasura = !opciones.secuencia || puerto->iniciado;
+            if (admiteBasura && sortear(&aleatorio, opciones.malformadas)) {
+                const char* linea = MALFORMADAS[siguienteAleatorio(&aleatorio) % NUM_MALFORMADAS];
+                escritor->enviar(linea, (int)strlen(linea), false);
+                malformadas++;
+            }
+            if (admiteBasura && sortear(&aleatorio, opciones.largas)) {
+                escritor->enviar(lineaLarga, opciones.longitudLarga, false);
+                largas++;
+            }
+
+            // La trama demorada hace retraso tramas sale antes que la de este turno
+            TramaDemorada* turno = &puerto->enEspera[n % opciones.retraso];
+            if (turno->ocupada) {
+                escritor->enviar(turno->linea, turno->longitud, false);
+                turno->ocupada = false;
+                puerto->iniciado = true;
+            }
+
+            char linea[32];
+            int longitud = 0;
+            if (opciones.secuencia) {
+                longitud = snprintf(linea, sizeof(linea), "S,%u,", (unsigned int)n);
+            }
+            bool esCarga = siguienteAleatorio(&aleatorio) % 5 != 0;
+            char caracter = 0;
+            int rotacion = 0;
+            if (esCarga) {
+                int k = (int)(siguienteAleatorio(&aleatorio) % 27);
+                caracter = k == 26 ? ' ' : (char)('A' + k);
+                longitud += snprintf(linea + longitud, sizeof(linea) - longitud, "L,%c", caracter);
+            } else {
+                rotacion = (int)(siguienteAleatorio(&aleatorio) % 101) - 50;
+                longitud += snprintf(linea + longitud, sizeof(linea) - longitud, "M,%d", rotacion);
+            }
+
+            // Una trama perdida no llega nunca: el mensaje esperado tampoco la incluye
+            if (opciones.secuencia && sortear(&aleatorio, opciones.perdidas)) {
+                perdidas++;
+                bytesEnviados += escritor->getBytes() - bytesAntes;
+                continue;
+            }
+            bool enviada = true;
+            if (opciones.secuencia && sortear(&aleatorio, opciones.desorden)) {
+                memcpy(turno->linea, linea, (size_t)longitud);
+                turno->longitud = longitud;
+                turno->ocupada = true;
+                demoradas++;
+            } else if (!escritor->enviar(linea, longitud, opciones.descartar)) {
+                descartadas++;
+                enviada = false;
+            }
+            bytesEnviados += escritor->getBytes() - bytesAntes;
+            if (!enviada) continue;
+            if (!turno->ocupada) puerto->iniciado = true;
+            RotorDeMapeo* referencia = puerto->referencia;
+            if (esCarga) {
+                puerto->esperado[puerto->longitudEsperada++] = referencia->getMapeo(caracter);
+            } else if (referencia->getTamanio() > 0) {
+                referencia->setPosicion(referencia->getPosicion() + rotacion % referencia->getTamanio());
+            }
+        }
+        for (int p = 0; p < numPuertos; p++) {
+            PuertoSimulado* puerto = &puertos[p];
+            long long propias = (opciones.tramas - p + numPuertos - 1) / numPuertos;
+            for (long long k = propias; k < propias + opciones.retraso; k++) {
+                TramaDemorada* turno = &puerto->enEspera[k % opciones.retraso];
+                if (turno->ocupada) puerto->escritor->enviar(turno->linea, turno->longitud, false);
+            }
+            puerto->escritor->enviar("END", 3, false);
+            puerto->escritor->vaciar();
+        }
+        finEscritura = Metricas::ahoraNs();
+
+        // Si algún "END" no llega (p. ej. descartado), el decodificador se detiene a tiempo
+        while (!contexto.terminado.load() && Metricas::ahoraNs() - finEscritura < ESPERA_FINAL_NS) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (!contexto.terminado.load()) {
+            if (opciones.eventos) {
+                bucle.detener();
+            } else {
+                gestor.detener();
+            }
+        }
+        decodificador.join();
+    }
+
+    // Comparar el mensaje decodificado de cada puerto con el esperado
+    long long lineas = 0;
+    long long invalidas = 0;
+    long long reordenadas = 0;
+    long long perdidasReorden = 0;
+    long long tardias = 0;
+    long long duplicadas = 0;
+    long long caracteresEsperados = 0;
+    long long caracteresObtenidos = 0;
+    long long bytes = 0;
+    int sinFin = -1;
+    int conDiferencia = -1;
+    long long primeraDiferencia = -1;
+    for (int p = 0; p < abiertos; p++) {
+        PuertoSimulado* puerto = &puertos[p];
+        SesionDecodificacion* sesion = puerto->sesion;
+        ListaDeCarga* carga = sesion->getCarga();
+        char* obtenido = new char[puerto->longitudEsperada + 1];
+        long long longitudObtenida = carga->getTamanio();
+        long long copiados = carga->copiarContenido(obtenido, puerto->longitudEsperada);
+        long long diferencia = -1;
+        for (long long i = 0; i < copiados && diferencia < 0; i++) {
+            if (obtenido[i] != puerto->esperado[i]) diferencia = i;
+        }
+        if (diferencia < 0 && longitudObtenida != puerto->longitudEsperada) {
+            diferencia = copiados;
+        }
+        delete[] obtenido;
+        if (!sesion->estaTerminada() && sinFin < 0) sinFin = p;
+        if (diferencia >= 0 && conDiferencia < 0) {
+            conDiferencia = p;
+            primeraDiferencia = diferencia;
+        }
+
+        lineas += sesion->getLineas();
+        invalidas += sesion->getInvalidas();
+        caracteresEsperados += puerto->longitudEsperada;
+        caracteresObtenidos += longitudObtenida;
+        bytes += puerto->escritor->getBytes();
+        const BufferDeReorden* reorden = sesion->getReorden();
+        if (reorden != nullptr) {
+            reordenadas += reorden->getReordenadas();
+            perdidasReorden += reorden->getPerdidas();
+            tardias += reorden->getTardias();
+            duplicadas += reorden->getDuplicadas();
+        }
+    }
+    bool correcto = !error && sinFin < 0 && conDiferencia < 0;
+
+    double segundosEscritura = (finEscritura - inicio) / 1e9;
+    double segundosDecodificacion = contexto.finNs > inicio ? (contexto.finNs - inicio) / 1e9 : 0.0;
+    long long enviadas = opciones.tramas - descartadas - perdidas;
+
+    if (numPuertos == 1) {
+        printf("=== Simulador PRT-7 sobre %s ===\n", puertos[0].nombre);
+    } else {
+        printf("=== Simulador PRT-7 sobre %d pseudo-terminales ===\n", numPuertos);
+    }
+    if (opciones.eventos) {
+        printf("Decodificación: bucle de eventos en 1 hilo (%lld turnos en %lld esperas)\n",
+               bucle.getTurnos(), bucle.getEsperas());
+    } else {
+        printf("Decodificación: %d hilo%s, uno por puerto\n", numPuertos, numPuertos == 1 ? "" : "s");
+    }
+    printf("Tramas enviadas: %lld (descartadas: %lld, malformadas: %lld, largas: %lld)\n",
+           enviadas, descartadas, malformadas, largas);
+    if (opciones.secuencia) {
+        printf("Tramas numeradas: %lld perdidas y %lld demoradas %d posiciones\n",
+               perdidas, demoradas, opciones.retraso);
+    }
+    printf("Bytes enviados: %lld en %.3f s\n", bytes, segundosEscritura);
+    printf("Tasa objetivo: %.0f tramas/s, enviada: %.0f tramas/s, decodificada: %.0f tramas/s\n",
+           opciones.tasa, segundosEscritura > 0 ? enviadas / segundosEscritura : 0.0,
+           segundosDecodificacion > 0 ? lineas / segundosDecodificacion : 0.0);
+    printf("Líneas leídas: %lld, inválidas: %lld\n", lineas, invalidas);
+    if (opciones.secuencia) {
+        printf("Reorden: %lld esperaron a una anterior, %lld perdidas, %lld tardías, %lld duplicadas\n",
+               reordenadas, perdidasReorden, tardias, duplicadas);
+    }
+    printf("Caracteres esperados: %lld, decodificados: %lld\n", caracteresEsperados, caracteresObtenidos);
+    if (error) {
+        printf("Resultado: FALLO (sólo se abrieron %d de %d pseudo-terminales)\n", abiertos, numPuertos);
+    } else if (sinFin >= 0) {
+        printf("Resultado: FALLO (no llegó \"END\" a %s)\n", puertos[sinFin].nombre);
+    } else if (conDiferencia >= 0) {
+        printf("Resultado: FALLO (primera diferencia en el carácter %lld de %s)\n",
+               primeraDiferencia, puertos[conDiferencia].nombre);
+    } else {
+        printf("Resultado: OK\n");
+    }
+
+    for (int p = 0; p < abiertos; p++) {
+        PuertoSimulado* puerto = &puertos[p];
+        delete[] puerto->enEspera;
+        delete[] puerto->esperado;
+        delete puerto->referencia;
+        delete puerto->escritor;
+        delete puerto->sesion;
+        delete puerto->fuente;
+        delete puerto->lector;
+        close(puerto->maestro);
+    }
+    delete[] puertos;
+    delete[] lineaLarga;
+    return correcto ? 0 : (error ? 1 : 2);
+}
@@ -0,0 +1,130 @@
+/**
+ * @file prueba_decodificacion_lote.cpp
+ * @brief Compara cada kernel de decodificación por lotes con RotorDeMapeo::getMapeo()
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ * @details Fuerza cada implementación (AVX2, SSE2 y escalar) sobre los 256
+ *          valores de byte, las 26 posiciones del rotor, desplazamientos de
+ *          entrada y salida no alineados y longitudes que no son múltiplo del
+ *          ancho del vector, también decodificando en el mismo buffer. Las
+ *          implementaciones que el procesador no soporta se omiten.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "DecodificacionLote.h"
+#include "RotorDeMapeo.h"
+#include "Registro.h"
+
+/// Implementaciones a comparar
+static const char* IMPLEMENTACIONES[] = { "avx2", "sse2", "escalar" };
+static const int NUM_IMPLEMENTACIONES = sizeof(IMPLEMENTACIONES) / sizeof(IMPLEMENTACIONES[0]);
+
+/// Longitudes mayores que las que se prueban una por una
+static const int LONGITUDES_LARGAS[] = { 255, 256, 257, 1000, 4095, 4096, 4099 };
+static const int NUM_LONGITUDES_LARGAS = sizeof(LONGITUDES_LARGAS) / sizeof(LONGITUDES_LARGAS[0]);
+
+/// Desplazamientos de inicio probados (cubren las alineaciones de 32 bytes)
+static const int DESPLAZAMIENTOS = 33;
+
+/// Bytes de guarda tras la salida, que ninguna implementación debe tocar
+static const int GUARDA = 64;
+
+/// Tamaño de los buffers de prueba
+static const int TAMANIO_BUFFER = 4099 + DESPLAZAMIENTOS + GUARDA;
+
+/**
+ * @brief Prueba una implementación con una posición, un desplazamiento y una longitud
+ * @return false (y reporta) en la primera diferencia
+ */
+static bool probarCaso(const char* implementacion, const char* esperadoPorByte, int posicion,
+                       int desplazamiento, int longitud, bool mismoBuffer) {
+    static char entrada[TAMANIO_BUFFER];
+    static char salida[TAMANIO_BUFFER];
+    for (int i = 0; i < TAMANIO_BUFFER; i++) {
+        // Cada longitud recorre los 256 valores desde un punto distinto
+        entrada[i] = (char)(unsigned char)((i - desplazamiento) * 7 + longitud);
+        salida[i] = (char)0xA5;
+    }
+    char* destino = mismoBuffer ? entrada + desplazamiento : salida + (DESPLAZAMIENTOS - 1 - desplazamiento);
+    char original[TAMANIO_BUFFER];
+    memcpy(original, entrada, TAMANIO_BUFFER);
+
+    decodificarLoteCon(implementacion, entrada + desplazamiento, destino, longitud, posicion);
+
+    for (int i = 0; i < longitud; i++) {
+        unsigned char c = (unsigned char)original[desplazamiento + i];
+        if (destino[i] != esperadoPorByte[c]) {
+            printf("FALLO %s: posición %d, desplazamiento %d, longitud %d%s, byte %d (0x%02X): "
+                   "se obtuvo 0x%02X y se esperaba 0x%02X\n",
+                   implementacion, posicion, desplazamiento, longitud, mismoBuffer ? " (mismo buffer)" : "",
+                   i, c, (unsigned char)destino[i], (unsigned char)esperadoPorByte[c]);
+            return false;
+        }
+    }
+    for (int i = longitud; i < longitud + GUARDA; i++) {
+        char guarda = mismoBuffer ? original[desplazamiento + i] : (char)0xA5;
+        if (destino[i] != guarda) {
+            printf("FALLO %s: posición %d, longitud %d: escribió más allá del lote (byte %d)\n",
+                   implementacion, posicion, longitud, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Prueba una implementación con todas las posiciones, desplazamientos y longitudes
+ * @return Número de casos fallidos (se detiene en el primero de cada posición)
+ */
+static int probarImplementacion(const char* implementacion) {
+    int fallos = 0;
+    RotorDeMapeo rotor;
+    for (int posicion = 0; posicion < 26; posicion++) {
+        rotor.setPosicion(posicion);
+        char esperadoPorByte[256];
+        for (int c = 0; c < 256; c++) {
+            esperadoPorByte[c] = rotor.getMapeo((char)c);
+        }
+        int posicionCero = rotor.getPosicion();
+
+        bool correcto = true;
+        for (int d = 0; d < DESPLAZAMIENTOS && correcto; d++) {
+            for (int n = 0; n <= 96 && correcto; n++) {
+                correcto = probarCaso(implementacion, esperadoPorByte, posicionCero, d, n, false) &&
+                           probarCaso(implementacion, esperadoPorByte, posicionCero, d, n, true);
+            }
+            for (int k = 0; k < NUM_LONGITUDES_LARGAS && correcto; k++) {
+                int n = LONGITUDES_LARGAS[k];
+                correcto = probarCaso(implementacion, esperadoPorByte, posicionCero, d, n, false) &&
+                           probarCaso(implementacion, esperadoPorByte, posicionCero, d, n, true);
+            }
+        }
+        if (!correcto) fallos++;
+    }
+    return fallos;
+}
+
+/**
+ * @brief Función principal de la prueba
+ * @return 0 si todas las implementaciones disponibles coinciden con getMapeo()
+ */
+int main() {
+    Registro::setNivel(REGISTRO_SILENCIOSO);
+    int fallos = 0;
+    int probadas = 0;
+    for (int i = 0; i < NUM_IMPLEMENTACIONES; i++) {
+        const char* implementacion = IMPLEMENTACIONES[i];
+        char prueba = 'A';
+        if (!decodificarLoteCon(implementacion, &prueba, &prueba, 1, 0)) {
+            printf("%-8s omitida (no disponible en este procesador)\n", implementacion);
+            continue;
+        }
+        int f = probarImplementacion(implementacion);
+        printf("%-8s %s\n", implementacion, f == 0 ? "OK" : "FALLO");
+        fallos += f;
+        probadas++;
+    }
+    printf("Implementación elegida por decodificarLote(): %s\n", getImplementacionLote());
+    return fallos == 0 && probadas > 0 ? 0 : 1;
+}
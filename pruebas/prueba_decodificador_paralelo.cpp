@@ -0,0 +1,201 @@
+/**
+ * @file prueba_decodificador_paralelo.cpp
+ * @brief Compara DecodificadorParalelo con la decodificación secuencial de SesionDecodificacion
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ * @details Genera capturas de texto con cargas, rotaciones, giros de la
+ *          cascada, líneas inválidas, vacías y con '\r', con y sin '\n' final
+ *          y con "END" en medio o al final. Cada una se decodifica con una
+ *          sesión (el camino secuencial) y con el decodificador paralelo sobre
+ *          el mapeo de la misma captura, con varios números de hilos; la carga,
+ *          las líneas, las inválidas y la posición final del rotor deben coincidir.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "DecodificadorParalelo.h"
+#include "SesionDecodificacion.h"
+#include "FuenteDeLineas.h"
+#include "LectorCaptura.h"
+#include "CascadaDeRotores.h"
+#include "Registro.h"
+
+/// Captura temporal, en el directorio de trabajo de la prueba
+static const char* RUTA_CAPTURA = "prueba_decodificador_paralelo.txt";
+
+/// Cascada de los casos con cascada (dos rotores)
+static const char* CASCADA = "EKMFLGDQVZNTOWYHXUSPAIBRCJ:Q,AJDKSIRUXBLHWTMCQGZNPYFVOE:E";
+
+/// Hilos con los que se prueba cada captura
+static const int HILOS[] = { 1, 2, 3, 4, 7, 8 };
+static const int NUM_HILOS = sizeof(HILOS) / sizeof(HILOS[0]);
+
+/**
+ * @brief Resultado de decodificar una captura
+ */
+struct Resultado {
+    std::string carga;  ///< Caracteres decodificados
+    long long lineas;   ///< Líneas consumidas
+    long long invalidas; ///< Líneas inválidas
+    int posicion;       ///< Posición final del rotor
+};
+
+/**
+ * @brief Generador congruencial con semilla fija (la prueba es reproducible)
+ */
+static unsigned int siguienteAleatorio(unsigned int* estado) {
+    *estado = *estado * 1103515245u + 12345u;
+    return (*estado >> 8) & 0xFFFFFF;
+}
+
+/**
+ * @brief Genera una captura de texto sin numerar
+ * @param lineas Líneas a generar
+ * @param semilla Semilla del generador
+ * @param lineaFin Índice de la línea "END" (-1 = ninguna)
+ * @param conSaltoFinal La última línea termina en '\n'
+ */
+static std::string generarCaptura(int lineas, unsigned int semilla, int lineaFin, bool conSaltoFinal) {
+    std::string captura;
+    captura.reserve((size_t)lineas * 5);
+    unsigned int estado = semilla;
+    char linea[32];
+    for (int i = 0; i < lineas; i++) {
+        unsigned int k = siguienteAleatorio(&estado) % 100;
+        if (i == lineaFin) {
+            snprintf(linea, sizeof(linea), "END");
+        } else if (k < 70) {
+            unsigned int c = siguienteAleatorio(&estado) % 27;
+            snprintf(linea, sizeof(linea), "L,%c", c == 26 ? ' ' : (char)('A' + c));
+        } else if (k < 85) {
+            snprintf(linea, sizeof(linea), "M,%d", (int)(siguienteAleatorio(&estado) % 121) - 60);
+        } else if (k < 88) {
+            snprintf(linea, sizeof(linea), "R,%u,%d", siguienteAleatorio(&estado) % 3 + 1,
+                     (int)(siguienteAleatorio(&estado) % 11) - 5);
+        } else if (k < 91) {
+            linea[0] = '\0';
+        } else if (k < 94) {
+            snprintf(linea, sizeof(linea), "L,%c\r", (char)('A' + siguienteAleatorio(&estado) % 26));
+        } else if (k < 97) {
+            snprintf(linea, sizeof(linea), "X,%u", k);
+        } else {
+            snprintf(linea, sizeof(linea), "M,abc");
+        }
+        captura += linea;
+        if (i + 1 < lineas || conSaltoFinal) captura += '\n';
+    }
+    return captura;
+}
+
+/**
+ * @brief Copia el contenido de una lista de carga
+ */
+static std::string contenido(const ListaDeCarga* carga) {
+    std::string texto((size_t)carga->getTamanio(), '\0');
+    if (!texto.empty()) carga->copiarContenido(&texto[0], (long long)texto.size());
+    return texto;
+}
+
+/**
+ * @brief Decodifica la captura temporal con una sesión, línea a línea en orden
+ */
+static Resultado decodificarSecuencial(bool conCascada) {
+    LectorCaptura captura(RUTA_CAPTURA);
+    FuenteCaptura fuente(&captura);
+    SesionDecodificacion sesion(RUTA_CAPTURA, &fuente);
+    CascadaDeRotores cascada;
+    if (conCascada) {
+        cascada.configurar(CASCADA, true);
+        sesion.getRotor()->setCascada(&cascada);
+    }
+    while (!sesion.estaTerminada()) {
+        sesion.procesarDisponibles(1024);
+    }
+    Resultado resultado;
+    resultado.carga = contenido(sesion.getCarga());
+    resultado.lineas = sesion.getLineas();
+    resultado.invalidas = sesion.getInvalidas();
+    resultado.posicion = sesion.getRotor()->getPosicion();
+    return resultado;
+}
+
+/**
+ * @brief Decodifica la captura temporal con el decodificador paralelo sobre su mapeo
+ */
+static Resultado decodificarParalelo(int hilos, bool conCascada) {
+    LectorCaptura captura(RUTA_CAPTURA);
+    const char* datos = nullptr;
+    size_t disponibles = 0;
+    captura.asomarBytes(&datos, &disponibles);
+
+    RotorDeMapeo rotor;
+    ListaDeCarga carga;
+    CascadaDeRotores cascada;
+    if (conCascada) {
+        cascada.configurar(CASCADA, true);
+        rotor.setCascada(&cascada);
+    }
+    DecodificadorParalelo decodificador(hilos);
+    Resultado resultado;
+    resultado.invalidas = decodificador.procesar(datos, (long long)disponibles, &carga, &rotor, &resultado.lineas);
+    resultado.carga = contenido(&carga);
+    resultado.posicion = rotor.getPosicion();
+    return resultado;
+}
+
+/**
+ * @brief Escribe una captura, la decodifica de las dos formas y compara
+ * @return Número de comparaciones fallidas
+ */
+static int probarCaptura(const char* nombre, const std::string& texto, bool conCascada) {
+    FILE* archivo = fopen(RUTA_CAPTURA, "wb");
+    if (archivo == nullptr || fwrite(texto.data(), 1, texto.size(), archivo) != texto.size()) {
+        printf("FALLO %s: no se pudo escribir %s\n", nombre, RUTA_CAPTURA);
+        if (archivo != nullptr) fclose(archivo);
+        return 1;
+    }
+    fclose(archivo);
+
+    Resultado esperado = decodificarSecuencial(conCascada);
+    int fallos = 0;
+    for (int i = 0; i < NUM_HILOS; i++) {
+        Resultado obtenido = decodificarParalelo(HILOS[i], conCascada);
+        if (obtenido.carga != esperado.carga || obtenido.lineas != esperado.lineas ||
+            obtenido.invalidas != esperado.invalidas || obtenido.posicion != esperado.posicion) {
+            printf("FALLO %s con %d hilos: %lld líneas, %lld inválidas, %zu caracteres, posición %d; "
+                   "se esperaban %lld, %lld, %zu y %d\n",
+                   nombre, HILOS[i], obtenido.lineas, obtenido.invalidas, obtenido.carga.size(),
+                   obtenido.posicion, esperado.lineas, esperado.invalidas, esperado.carga.size(),
+                   esperado.posicion);
+            fallos++;
+        }
+    }
+    if (fallos == 0) {
+        printf("%s: OK (%lld líneas, %zu caracteres)\n", nombre, esperado.lineas, esperado.carga.size());
+    }
+    return fallos;
+}
+
+/**
+ * @brief Función principal de la prueba
+ * @return 0 si el decodificador paralelo coincide con la sesión en todas las capturas
+ */
+int main() {
+    Registro::setNivel(REGISTRO_SILENCIOSO);
+
+    // Suficientes líneas para que cada uno de 8 hilos reciba más de BYTES_MINIMOS_POR_HILO
+    const int lineas = 2600000;
+    int fallos = 0;
+    fallos += probarCaptura("con salto final", generarCaptura(lineas, 1, -1, true), false);
+    fallos += probarCaptura("sin salto final", generarCaptura(lineas, 2, -1, false), false);
+    fallos += probarCaptura("END a la mitad", generarCaptura(lineas, 3, lineas / 2 + 7, true), false);
+    fallos += probarCaptura("END al final sin salto", generarCaptura(lineas, 4, lineas - 1, false), false);
+    fallos += probarCaptura("END en la primera línea", generarCaptura(lineas, 5, 0, true), false);
+    fallos += probarCaptura("captura pequeña", generarCaptura(1000, 6, -1, false), false);
+    fallos += probarCaptura("captura vacía", std::string(), false);
+    fallos += probarCaptura("con cascada", generarCaptura(lineas / 4, 7, -1, true), true);
+
+    remove(RUTA_CAPTURA);
+    return fallos == 0 ? 0 : 1;
+}
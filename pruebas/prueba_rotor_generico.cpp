@@ -0,0 +1,108 @@
+/**
+ * @file prueba_rotor_generico.cpp
+ * @brief Compara RotorGenerico con RotorDeMapeo en cada alfabeto
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ * @details RotorGenerico<> debe reproducir el mapeo A-Z de RotorDeMapeo, y cada
+ *          otra instancia el de un RotorDeMapeo con el mismo alfabeto elegido
+ *          con setAlfabeto(). Tras cada rotación aleatoria se comparan los 256
+ *          valores de byte con getMapeo() y getMapeoLote(), la posición y el
+ *          carácter en la posición cero.
+ */
+
+#include <cstdio>
+#include "RotorGenerico.h"
+#include "RotorDeMapeo.h"
+#include "Registro.h"
+
+/// Rotaciones aleatorias con el alfabeto A-Z
+static const int ROTACIONES_AZ = 200000;
+
+/// Rotaciones aleatorias con cada uno de los otros alfabetos
+static const int ROTACIONES_OTROS = 20000;
+
+/**
+ * @brief Generador congruencial con semilla fija (la prueba es reproducible)
+ */
+static unsigned int siguienteAleatorio(unsigned int* estado) {
+    *estado = *estado * 1103515245u + 12345u;
+    return (*estado >> 8) & 0xFFFFFF;
+}
+
+/**
+ * @brief Rota los dos rotores igual y compara su mapeo tras cada rotación
+ * @tparam Alfabeto Alfabeto de RotorGenerico
+ * @param nombre Nombre del mismo alfabeto para RotorDeMapeo::buscarAlfabeto()
+ * @param rotaciones Número de rotaciones aleatorias
+ * @return 0 si coinciden siempre, 1 en la primera diferencia (que se reporta)
+ */
+template <typename Alfabeto>
+static int probarAlfabeto(const char* nombre, int rotaciones) {
+    RotorGenerico<Alfabeto> generico;
+    RotorDeMapeo rotor;
+    const AlfabetoRotor* alfabeto = RotorDeMapeo::buscarAlfabeto(nombre);
+    if (alfabeto == nullptr || alfabeto->tamanio != RotorGenerico<Alfabeto>::TAMANIO) {
+        printf("FALLO %s: RotorDeMapeo no tiene este alfabeto\n", nombre);
+        return 1;
+    }
+    rotor.setAlfabeto(alfabeto);
+
+    char bytes[256];
+    for (int c = 0; c < 256; c++) bytes[c] = (char)c;
+    char loteGenerico[256];
+    char loteRotor[256];
+
+    unsigned int estado = 7;
+    for (int r = 0; r <= rotaciones; r++) {
+        if (r > 0) {
+            // Rotaciones grandes y negativas, no sólo dentro del alfabeto
+            int n = (int)(siguienteAleatorio(&estado) % 2001) - 1000;
+            generico.rotar(n);
+            rotor.rotar(n);
+        }
+        if (generico.getPosicion() != rotor.getPosicion() ||
+            generico.getCaracterCero() != rotor.getCaracterCero()) {
+            printf("FALLO %s: rotación %d: posición %d ('%c') y se esperaba %d ('%c')\n", nombre, r,
+                   generico.getPosicion(), generico.getCaracterCero(), rotor.getPosicion(),
+                   rotor.getCaracterCero());
+            return 1;
+        }
+        generico.getMapeoLote(bytes, loteGenerico, 256);
+        rotor.getMapeoLote(bytes, loteRotor, 256);
+        for (int c = 0; c < 256; c++) {
+            char esperado = rotor.getMapeo((char)c);
+            if (generico.getMapeo((char)c) != esperado || loteGenerico[c] != esperado || loteRotor[c] != esperado) {
+                printf("FALLO %s: rotación %d, posición %d, byte 0x%02X: getMapeo 0x%02X, lote 0x%02X, "
+                       "lote de RotorDeMapeo 0x%02X; se esperaba 0x%02X\n",
+                       nombre, r, rotor.getPosicion(), c, (unsigned char)generico.getMapeo((char)c),
+                       (unsigned char)loteGenerico[c], (unsigned char)loteRotor[c], (unsigned char)esperado);
+                return 1;
+            }
+        }
+    }
+    printf("%-12s OK (%d símbolos, %d rotaciones)\n", nombre, RotorGenerico<Alfabeto>::TAMANIO, rotaciones);
+    return 0;
+}
+
+/**
+ * @brief Función principal de la prueba
+ * @return 0 si RotorGenerico coincide con RotorDeMapeo en todos los alfabetos
+ */
+int main() {
+    Registro::setNivel(REGISTRO_SILENCIOSO);
+    int fallos = 0;
+
+    // El rotor por defecto de RotorDeMapeo es el de RotorGenerico<>
+    RotorDeMapeo porDefecto;
+    if (porDefecto.getAlfabeto() != RotorDeMapeo::buscarAlfabeto("mayusculas") || !porDefecto.esAlfabetoEstandar()) {
+        printf("FALLO: RotorDeMapeo no empieza con el alfabeto A-Z\n");
+        fallos++;
+    }
+
+    fallos += probarAlfabeto<AlfabetoMayusculas>("mayusculas", ROTACIONES_AZ);
+    fallos += probarAlfabeto<AlfabetoMinusculas>("minusculas", ROTACIONES_OTROS);
+    fallos += probarAlfabeto<AlfabetoAlfanumerico>("alfanumerico", ROTACIONES_OTROS);
+    fallos += probarAlfabeto<AlfabetoBase64>("base64", ROTACIONES_OTROS);
+    fallos += probarAlfabeto<AlfabetoBytes>("bytes", ROTACIONES_OTROS);
+    return fallos == 0 ? 0 : 1;
+}
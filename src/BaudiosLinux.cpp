@@ -0,0 +1,48 @@
+/**
+ * @file BaudiosLinux.cpp
+ * @brief Implementación de velocidades arbitrarias con termios2/BOTHER
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "BaudiosLinux.h"
+
+#if defined(__linux__)
+    #include <asm/termbits.h>
+    #include <sys/ioctl.h>
+#endif
+
+bool configurarBaudiosPersonalizados(int fd, int baudios) {
+#if defined(__linux__) && defined(BOTHER) && defined(TCGETS2)
+    struct termios2 opciones;
+    if (ioctl(fd, TCGETS2, &opciones) != 0) {
+        return false;
+    }
+
+    opciones.c_cflag &= ~CBAUD;
+    opciones.c_cflag |= BOTHER;
+    opciones.c_ispeed = (speed_t)baudios;
+    opciones.c_ospeed = (speed_t)baudios;
+    #ifdef IBSHIFT
+    opciones.c_cflag &= ~(CBAUD << IBSHIFT);
+    opciones.c_cflag |= BOTHER << IBSHIFT;
+    #endif
+
+    if (ioctl(fd, TCSETS2, &opciones) != 0) {
+        return false;
+    }
+
+    // Confirmar que el controlador no ajustó la velocidad fuera de la
+    // tolerancia de un UART (alrededor de 3%)
+    if (ioctl(fd, TCGETS2, &opciones) != 0) {
+        return false;
+    }
+    long diferencia = (long)opciones.c_ospeed - (long)baudios;
+    if (diferencia < 0) diferencia = -diferencia;
+    return diferencia * 100 <= (long)baudios * 3;
+#else
+    (void)fd;
+    (void)baudios;
+    return false;
+#endif
+}
@@ -0,0 +1,22 @@
+/**
+ * @file BaudiosLinux.h
+ * @brief Configuración de velocidades arbitrarias del puerto serial en Linux (termios2/BOTHER)
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef BAUDIOS_LINUX_H
+#define BAUDIOS_LINUX_H
+
+/**
+ * @brief Configura una velocidad no estándar mediante termios2 y BOTHER
+ * @param fd Descriptor del puerto ya configurado en 8N1
+ * @param baudios Velocidad deseada en baudios
+ * @return true si el controlador aceptó la velocidad
+ * @details Vive en su propia unidad de traducción porque <asm/termbits.h> no
+ *          puede incluirse junto con <termios.h>. En sistemas que no son Linux
+ *          siempre devuelve false.
+ */
+bool configurarBaudiosPersonalizados(int fd, int baudios);
+
+#endif // BAUDIOS_LINUX_H
@@ -0,0 +1,164 @@
+/**
+ * @file BucleEventos.cpp
+ * @brief Implementación del bucle de eventos con epoll
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "BucleEventos.h"
+#include "SesionDecodificacion.h"
+#include "FuenteDeLineas.h"
+#include "Metricas.h"
+#include <iostream>
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <sys/epoll.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Cola circular de índices de sesión, cada uno a lo sumo una vez
+ */
+struct ColaListas {
+    int* indices;    ///< Índices en orden de llegada
+    bool* presentes; ///< Sesiones que ya están en la cola
+    int capacidad;   ///< Número de sesiones
+    int primero;     ///< Posición del primer índice
+    int cantidad;    ///< Índices en la cola
+
+    ColaListas(int sesiones) : capacidad(sesiones), primero(0), cantidad(0) {
+        indices = new int[sesiones];
+        presentes = new bool[sesiones];
+        for (int i = 0; i < sesiones; i++) presentes[i] = false;
+    }
+
+    ~ColaListas() {
+        delete[] indices;
+        delete[] presentes;
+    }
+
+    void agregar(int sesion) {
+        if (presentes[sesion]) return;
+        int posicion = primero + cantidad;
+        if (posicion >= capacidad) posicion -= capacidad;
+        indices[posicion] = sesion;
+        presentes[sesion] = true;
+        cantidad++;
+    }
+
+    int sacar() {
+        int sesion = indices[primero];
+        presentes[sesion] = false;
+        if (++primero == capacidad) primero = 0;
+        cantidad--;
+        return sesion;
+    }
+};
+
+BucleEventos::BucleEventos()
+    : detenido(false), turnos(0), esperas(0) {}
+
+void BucleEventos::agregarSesion(SesionDecodificacion* sesion) {
+    sesiones.agregar(sesion);
+}
+
+bool BucleEventos::ejecutar() {
+    turnos = 0;
+    esperas = 0;
+#if defined(__linux__)
+    int cantidad = sesiones.getCantidad();
+    if (cantidad == 0) return true;
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll < 0) {
+        std::cerr << "Error: No se pudo crear la instancia de epoll" << std::endl;
+        return false;
+    }
+
+    ColaListas listas(cantidad);
+    bool* registradas = new bool[cantidad];
+    int activas = 0;
+    for (int i = 0; i < cantidad; i++) {
+        registradas[i] = false;
+        if (sesiones.obtener(i)->estaTerminada()) continue;
+        activas++;
+        int fd = sesiones.obtener(i)->getFuente()->getDescriptor();
+        if (fd >= 0) {
+            struct epoll_event evento;
+            evento.events = EPOLLIN;
+            evento.data.u32 = (unsigned int)i;
+            registradas[i] = epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &evento) == 0;
+        }
+        // Primer turno para todas: puede haber datos leídos antes de registrarse
+        listas.agregar(i);
+    }
+
+    struct epoll_event eventos[EVENTOS_POR_ESPERA];
+    long long periodoNs = (long long)ESPERA_INACTIVO_MS * 1000000LL;
+    long long proximaRevision = Metricas::ahoraNs() + periodoNs;
+    while (activas > 0 && !detenido.load(std::memory_order_relaxed)) {
+        // Con sesiones listas sólo se recogen los eventos nuevos, sin dormir
+        int n = epoll_wait(epoll, eventos, EVENTOS_POR_ESPERA, listas.cantidad > 0 ? 0 : ESPERA_INACTIVO_MS);
+        esperas++;
+        if (n < 0 && errno != EINTR) {
+            std::cerr << "Error: epoll_wait falló; se detiene el bucle de eventos" << std::endl;
+            break;
+        }
+        for (int k = 0; k < n; k++) {
+            listas.agregar((int)eventos[k].data.u32);
+        }
+
+        // Las tramas numeradas que esperan un hueco vencen aunque el puerto calle
+        long long ahora = Metricas::ahoraNs();
+        if (ahora >= proximaRevision) {
+            for (int i = 0; i < cantidad; i++) {
+                if (!sesiones.obtener(i)->estaTerminada() && sesiones.obtener(i)->tieneTramasEnEspera()) listas.agregar(i);
+            }
+            proximaRevision = ahora + periodoNs;
+        }
+
+        // Una vuelta: cada sesión lista recibe un turno acotado, en orden de llegada
+        int enVuelta = listas.cantidad;
+        for (int t = 0; t < enVuelta; t++) {
+            int i = listas.sacar();
+            SesionDecodificacion* sesion = sesiones.obtener(i);
+            int consumidas = sesion->procesarDisponibles(LINEAS_POR_TURNO);
+            turnos++;
+            if (sesion->estaTerminada()) {
+                if (registradas[i]) epoll_ctl(epoll, EPOLL_CTL_DEL, sesion->getFuente()->getDescriptor(), nullptr);
+                activas--;
+                continue;
+            }
+            // Si consumió algo puede quedar más en su buffer; si no, espera a epoll
+            if (consumidas > 0 || !registradas[i]) listas.agregar(i);
+        }
+    }
+
+    delete[] registradas;
+    close(epoll);
+    return true;
+#else
+    std::cerr << "Error: El bucle de eventos requiere epoll (Linux)" << std::endl;
+    return false;
+#endif
+}
+
+void BucleEventos::detener() {
+    detenido.store(true);
+}
+
+long long BucleEventos::getTurnos() const {
+    return turnos;
+}
+
+long long BucleEventos::getEsperas() const {
+    return esperas;
+}
+
+bool BucleEventos::estaDisponible() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,91 @@
+/**
+ * @file BucleEventos.h
+ * @brief Atiende muchas sesiones de decodificación desde un solo hilo con epoll
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef BUCLE_EVENTOS_H
+#define BUCLE_EVENTOS_H
+
+#include <atomic>
+#include "ListaDeSesiones.h"
+
+/**
+ * @class BucleEventos
+ * @brief Bucle de eventos de un solo hilo para cientos de puertos
+ * @details GestorDeSesiones recorre todas sus sesiones en cada vuelta y cada
+ *          consulta a un puerto sin datos es una llamada al sistema, así que
+ *          con cientos de puertos hace falta un hilo por grupo de puertos. Aquí
+ *          los descriptores se registran en epoll y sólo se atienden las
+ *          sesiones cuyo puerto tiene datos: una vuelta cuesta O(sesiones
+ *          listas), no O(sesiones).
+ *
+ *          Las sesiones listas esperan en una cola circular y cada una consume
+ *          a lo sumo LINEAS_POR_TURNO líneas por turno; si todavía tenía datos
+ *          vuelve al final de la cola. Eso da a cada puerto su propia
+ *          contrapresión: un puerto que envía más rápido de lo que se decodifica
+ *          no acapara el hilo ni crece en memoria (su buffer de lectura es
+ *          fijo), lo que no se lee se queda en el controlador y frena al emisor,
+ *          y los demás puertos siguen recibiendo su turno.
+ *
+ *          Las fuentes sin descriptor (capturas) están siempre listas. Las
+ *          sesiones con tramas numeradas esperando un hueco se revisan cada
+ *          ESPERA_INACTIVO_MS aunque su puerto no tenga datos. Sólo existe en
+ *          Linux (ver estaDisponible()).
+ */
+class BucleEventos {
+private:
+    ListaDeSesiones sesiones;   ///< Sesiones registradas
+    std::atomic<bool> detenido; ///< Solicitud de parada anticipada
+    long long turnos;           ///< Turnos dados a las sesiones en la última ejecución
+    long long esperas;          ///< Llamadas a epoll_wait en la última ejecución
+
+public:
+    static const int LINEAS_POR_TURNO = 1024;  ///< Líneas que consume una sesión antes de ceder el turno
+    static const int ESPERA_INACTIVO_MS = 10;  ///< Espera máxima en epoll_wait (y período de revisión de huecos)
+    static const int EVENTOS_POR_ESPERA = 256; ///< Eventos que devuelve cada epoll_wait como máximo
+
+    /**
+     * @brief Constructor: bucle sin sesiones
+     */
+    BucleEventos();
+
+    /**
+     * @brief Registra una sesión; debe llamarse antes de ejecutar()
+     * @param sesion Sesión a atender
+     */
+    void agregarSesion(SesionDecodificacion* sesion);
+
+    /**
+     * @brief Atiende todas las sesiones desde el hilo que llama
+     * @return false si no se pudo crear la instancia de epoll
+     * @details Regresa cuando todas las sesiones terminaron o se llamó a detener().
+     */
+    bool ejecutar();
+
+    /**
+     * @brief Solicita que ejecutar() regrese lo antes posible (seguro desde otro hilo)
+     */
+    void detener();
+
+    /**
+     * @brief Obtiene los turnos dados en la última ejecución
+     * @return Llamadas a procesarDisponibles()
+     */
+    long long getTurnos() const;
+
+    /**
+     * @brief Obtiene las esperas de la última ejecución
+     * @return Llamadas a epoll_wait
+     */
+    long long getEsperas() const;
+
+    /**
+     * @brief Indica si el sistema tiene epoll
+     * @return true en Linux
+     */
+    static bool estaDisponible();
+};
+
+#endif // BUCLE_EVENTOS_H
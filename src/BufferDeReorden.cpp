@@ -0,0 +1,233 @@
+/**
+ * @file BufferDeReorden.cpp
+ * @brief Implementación del buffer de reorden de tramas numeradas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "BufferDeReorden.h"
+#include "Metricas.h"
+
+/// Tope de ranuras: la ventana es memoria fija por sesión
+static const int CAPACIDAD_MAXIMA = 1 << 20;
+
+/// Distancias desde aquí (2^31) en adelante son números que ya pasaron
+static const unsigned int MEDIO_RANGO = 0x80000000u;
+
+BufferDeReorden::BufferDeReorden(int capacidad, int esperaMs)
+    : capacidad(1), esperaNs((long long)(esperaMs > 0 ? esperaMs : 0) * 1000000LL), siguiente(0),
+      iniciado(false), minimo(0), maximo(0), pendientes(0), inicioHueco(0), huecoEn(0), huecoVencido(false), hayRetenida(false),
+      secuenciaRetenida(0), finalizado(false), tardiasSeguidas(0), entregadas(0), reordenadas(0), perdidas(0),
+      duplicadas(0), tardias(0) {
+    if (capacidad > CAPACIDAD_MAXIMA) capacidad = CAPACIDAD_MAXIMA;
+    while (this->capacidad < capacidad) this->capacidad <<= 1;
+    mascara = (unsigned int)this->capacidad - 1;
+    ranuras = new TramaCompacta[this->capacidad];
+    origenes = new OrigenTrama[this->capacidad];
+    ocupadas = new bool[this->capacidad];
+    for (int i = 0; i < this->capacidad; i++) ocupadas[i] = false;
+    retenida.tipo = TRAMA_INVALIDA;
+    retenida.valor = 0;
+    retenida.indice = 0;
+    origenRetenida.byte = -1;
+    origenRetenida.linea = 0;
+    origenRetenida.sinNumero = 0;
+}
+
+BufferDeReorden::~BufferDeReorden() {
+    delete[] ranuras;
+    delete[] origenes;
+    delete[] ocupadas;
+}
+
+void BufferDeReorden::guardar(unsigned int secuencia, const TramaCompacta& trama, const OrigenTrama& origen) {
+    unsigned int ranura = secuencia & mascara;
+    if (ocupadas[ranura]) {
+        duplicadas++;
+        return;
+    }
+    ranuras[ranura] = trama;
+    origenes[ranura] = origen;
+    ocupadas[ranura] = true;
+    pendientes++;
+    if (iniciado && secuencia != siguiente) reordenadas++;
+}
+
+bool BufferDeReorden::esperarInicio(unsigned int secuencia) {
+    if (pendientes == 0) {
+        minimo = secuencia;
+        maximo = secuencia;
+        return true;
+    }
+    unsigned int nuevoMinimo = (secuencia - minimo >= MEDIO_RANGO) ? secuencia : minimo;
+    unsigned int nuevoMaximo = (secuencia - maximo < MEDIO_RANGO) ? secuencia : maximo;
+    if (nuevoMaximo - nuevoMinimo > mascara) {
+        // Ya no caben en una ventana: el inicio no puede ser anterior al menor recibido
+        fijarInicio(minimo);
+        return false;
+    }
+    if (secuencia != nuevoMaximo) reordenadas++;
+    minimo = nuevoMinimo;
+    maximo = nuevoMaximo;
+    return true;
+}
+
+void BufferDeReorden::fijarInicio(unsigned int secuencia) {
+    siguiente = secuencia;
+    iniciado = true;
+    inicioHueco = 0;
+    huecoVencido = false;
+}
+
+void BufferDeReorden::insertar(unsigned int secuencia, const TramaCompacta& trama, const OrigenTrama& origen) {
+    if (!iniciado && esperarInicio(secuencia)) {
+        guardar(secuencia, trama, origen);
+        return;
+    }
+    unsigned int distancia = secuencia - siguiente;
+    if (distancia >= MEDIO_RANGO) {
+        // Una ventana entera de tramas atrasadas y nada esperando: el emisor reinició la numeración
+        if (++tardiasSeguidas < capacidad || pendientes > 0) {
+            tardias++;
+            return;
+        }
+        siguiente = secuencia;
+        distancia = 0;
+    }
+    tardiasSeguidas = 0;
+    if (distancia > mascara) {
+        hayRetenida = true;
+        secuenciaRetenida = secuencia;
+        retenida = trama;
+        origenRetenida = origen;
+        return;
+    }
+    guardar(secuencia, trama, origen);
+}
+
+int BufferDeReorden::extraer(TramaCompacta* salida, int capacidadSalida) {
+    if (!iniciado) {
+        if (pendientes == 0 || !finalizado) return 0;
+        fijarInicio(minimo);
+    }
+    int n = 0;
+    while (n < capacidadSalida) {
+        if (hayRetenida && secuenciaRetenida - siguiente <= mascara) {
+            hayRetenida = false;
+            guardar(secuenciaRetenida, retenida, origenRetenida);
+        }
+
+        unsigned int ranura = siguiente & mascara;
+        if (ocupadas[ranura]) {
+            salida[n++] = ranuras[ranura];
+            ocupadas[ranura] = false;
+            pendientes--;
+            siguiente++;
+            entregadas++;
+            huecoVencido = false;
+            continue;
+        }
+
+        // Falta la trama que toca; sólo es un hueco si hay otras esperando detrás
+        if (pendientes == 0 && !hayRetenida) {
+            huecoVencido = false;
+            break;
+        }
+        if (pendientes == 0) {
+            // Entre siguiente y la retenida no hay nada: se avanza de una vez lo justo para que quepa
+            unsigned int salto = secuenciaRetenida - mascara - siguiente;
+            siguiente += salto;
+            perdidas += salto;
+            continue;
+        }
+        if (!hayRetenida && !finalizado && !huecoVencido) break;
+        siguiente++;
+        perdidas++;
+    }
+    return n;
+}
+
+void BufferDeReorden::revisarEspera() {
+    if (!iniciado) {
+        if (pendientes == 0) return;
+        long long ahora = Metricas::ahoraNs();
+        if (inicioHueco == 0) {
+            inicioHueco = ahora;
+        } else if (ahora - inicioHueco >= esperaNs) {
+            // Nada anterior llegó a tiempo: la secuencia empieza en el menor número recibido
+            fijarInicio(minimo);
+        }
+        return;
+    }
+    unsigned int ranura = siguiente & mascara;
+    if (pendientes == 0 || ocupadas[ranura] || huecoVencido) {
+        inicioHueco = 0;
+        return;
+    }
+    long long ahora = Metricas::ahoraNs();
+    if (inicioHueco == 0 || huecoEn != siguiente) {
+        inicioHueco = ahora;
+        huecoEn = siguiente;
+    }
+    if (ahora - inicioHueco >= esperaNs) huecoVencido = true;
+}
+
+void BufferDeReorden::finalizar() {
+    finalizado = true;
+}
+
+bool BufferDeReorden::admiteTramas() const {
+    return !hayRetenida;
+}
+
+bool BufferDeReorden::estaVacio() const {
+    return pendientes == 0 && !hayRetenida;
+}
+
+bool BufferDeReorden::estaIniciado() const {
+    return iniciado;
+}
+
+unsigned int BufferDeReorden::getSiguiente() const {
+    return siguiente;
+}
+
+bool BufferDeReorden::getOrigenMasAntiguo(OrigenTrama* origen) const {
+    bool hay = false;
+    if (hayRetenida) {
+        *origen = origenRetenida;
+        hay = true;
+    }
+    if (pendientes == 0) return hay;
+    for (int i = 0; i < capacidad; i++) {
+        if (ocupadas[i] && (!hay || origenes[i].linea < origen->linea)) {
+            *origen = origenes[i];
+            hay = true;
+        }
+    }
+    return hay;
+}
+
+int BufferDeReorden::getCapacidad() const {
+    return capacidad;
+}
+
+long long BufferDeReorden::getEntregadas() const {
+    return entregadas;
+}
+
+long long BufferDeReorden::getReordenadas() const {
+    return reordenadas;
+}
+
+long long BufferDeReorden::getPerdidas() const {
+    return perdidas;
+}
+
+long long BufferDeReorden::getDuplicadas() const {
+    return duplicadas;
+}
+
+long long BufferDeReorden::getTardias() const {
+    return tardias;
+}
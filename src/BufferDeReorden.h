@@ -0,0 +1,231 @@
+/**
+ * @file BufferDeReorden.h
+ * @brief Buffer acotado que devuelve a su orden las tramas numeradas de un transporte con pérdidas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef BUFFER_DE_REORDEN_H
+#define BUFFER_DE_REORDEN_H
+
+#include "TramaCompacta.h"
+
+/**
+ * @brief Lugar de la fuente donde se leyó una trama numerada
+ * @details Lo necesario para volver a leerla: un punto de control tomado
+ *          mientras la trama espera retrocede hasta aquí.
+ */
+struct OrigenTrama {
+    long long byte;      ///< Desplazamiento de la línea en la fuente (-1 si no se puede posicionar)
+    long long linea;     ///< Líneas leídas antes de ésta
+    long long sinNumero; ///< Líneas sin número de secuencia leídas antes de ésta
+};
+
+/**
+ * @class BufferDeReorden
+ * @brief Ventana circular de tramas indexada por número de secuencia
+ * @details Por UART las tramas llegan en orden, pero por UDP o por radio
+ *          pueden llegar desordenadas, repetidas o no llegar. Cada trama
+ *          numerada se guarda en la ranura secuencia % capacidad y extraer()
+ *          entrega, en orden, las que siguen a la última entregada. Si falta
+ *          una trama y ya hay otras esperando detrás, el hueco se salta (y sus
+ *          números se cuentan como perdidos) cuando pasa el tiempo de espera o
+ *          cuando llega una trama que no cabe en la ventana. Una trama que
+ *          llega después de que su turno pasó se descarta: nunca se aplica
+ *          fuera de orden al rotor.
+ *
+ *          Insertar y entregar una trama cuesta O(1); saltar un hueco cuesta
+ *          O(1) por número perdido, con un tope de capacidad ranuras por salto.
+ *          Los números de secuencia son de 32 bits y pueden dar la vuelta: se
+ *          comparan por diferencia módulo 2^32.
+ *
+ *          La primera trama recibida no es necesariamente la primera de la
+ *          secuencia: mientras el inicio no se conoce no se entrega nada. El
+ *          inicio se fija en el menor número recibido cuando vence el tiempo
+ *          de espera, cuando las tramas recibidas ya no caben en una ventana o
+ *          al finalizar(); también se puede fijar explícitamente con
+ *          fijarInicio(), por ejemplo al reanudar. Si después llega una
+ *          ventana entera de tramas atrasadas sin nada en espera, se toma como
+ *          un reinicio del emisor y la secuencia se vuelve a fijar.
+ */
+class BufferDeReorden {
+private:
+    TramaCompacta* ranuras;   ///< Tramas en espera, en la ranura secuencia & mascara
+    OrigenTrama* origenes;    ///< Origen en la fuente de cada trama en espera
+    bool* ocupadas;           ///< Ranuras con trama
+    int capacidad;            ///< Número de ranuras (potencia de dos)
+    unsigned int mascara;     ///< capacidad - 1
+    long long esperaNs;       ///< Tiempo máximo que un hueco detiene la entrega
+    unsigned int siguiente;   ///< Número de secuencia que toca entregar
+    bool iniciado;            ///< Ya se fijó el inicio de la secuencia
+    unsigned int minimo;      ///< Menor número recibido antes de fijar el inicio
+    unsigned int maximo;      ///< Mayor número recibido antes de fijar el inicio
+    int pendientes;           ///< Tramas en la ventana
+    long long inicioHueco;    ///< Instante en que se vio detenida la entrega en huecoEn, o en que
+                              ///< se vio la primera trama sin inicio fijo (0 = no se vio)
+    unsigned int huecoEn;     ///< Número que faltaba cuando se tomó inicioHueco
+    bool huecoVencido;        ///< El hueco actual ya esperó lo suficiente: se salta
+    bool hayRetenida;         ///< Hay una trama que no cabía en la ventana
+    unsigned int secuenciaRetenida; ///< Número de la trama retenida
+    TramaCompacta retenida;   ///< Trama retenida hasta que la ventana avance
+    OrigenTrama origenRetenida; ///< Origen en la fuente de la trama retenida
+    bool finalizado;          ///< No llegarán más tramas: los huecos ya no se esperan
+    int tardiasSeguidas;      ///< Tramas atrasadas recibidas una tras otra
+
+    long long entregadas;     ///< Tramas entregadas en orden
+    long long reordenadas;    ///< Tramas que llegaron antes que alguna anterior
+    long long perdidas;       ///< Números de secuencia saltados sin recibir su trama
+    long long duplicadas;     ///< Tramas repetidas que aún estaban en la ventana
+    long long tardias;        ///< Tramas que llegaron después de su turno (o repetidas ya entregadas)
+
+    /**
+     * @brief Guarda una trama que cabe en la ventana
+     * @param secuencia Número de la trama
+     * @param trama Trama
+     * @param origen Lugar de la fuente donde se leyó
+     */
+    void guardar(unsigned int secuencia, const TramaCompacta& trama, const OrigenTrama& origen);
+
+    /**
+     * @brief Acomoda una trama mientras el inicio no está fijo
+     * @param secuencia Número de la trama
+     * @return true si la trama cabe junto a las recibidas; false si ya no
+     *         cabe, en cuyo caso el inicio quedó fijo en el menor número
+     */
+    bool esperarInicio(unsigned int secuencia);
+
+public:
+    static const int CAPACIDAD_POR_DEFECTO = 256; ///< Ranuras si no se indica otra cosa
+    static const int ESPERA_POR_DEFECTO_MS = 50;  ///< Espera por un hueco si no se indica otra cosa
+
+    /**
+     * @brief Constructor
+     * @param capacidad Tramas que pueden esperar a la vez (se redondea a potencia de dos)
+     * @param esperaMs Milisegundos que un hueco puede detener la entrega (0 = no esperar)
+     */
+    BufferDeReorden(int capacidad, int esperaMs);
+
+    /**
+     * @brief Destructor: libera las ranuras
+     */
+    ~BufferDeReorden();
+
+    /**
+     * @brief Recibe una trama numerada
+     * @param secuencia Número de secuencia de la trama
+     * @param trama Trama (puede ser inválida: ocupa su número igual)
+     * @param origen Lugar de la fuente donde se leyó
+     * @details Si la trama no cabe en la ventana queda retenida y la
+     *          siguiente extraer() salta los huecos necesarios para hacerle
+     *          lugar; mientras tanto admiteTramas() devuelve false.
+     */
+    void insertar(unsigned int secuencia, const TramaCompacta& trama, const OrigenTrama& origen);
+
+    /**
+     * @brief Fija el número de la siguiente trama a entregar
+     * @param secuencia Primer número de la secuencia (o el que seguía al reanudar)
+     * @details Sólo se llama antes de insertar o cuando el inicio aún no está
+     *          fijo; las tramas ya recibidas con números anteriores se pierden.
+     */
+    void fijarInicio(unsigned int secuencia);
+
+    /**
+     * @brief Entrega en orden las tramas que ya se pueden aplicar
+     * @param salida Destino de las tramas
+     * @param capacidadSalida Máximo de tramas a entregar
+     * @return Tramas escritas en salida
+     * @details No consulta el reloj: un hueco sólo se salta si ya venció
+     *          (ver revisarEspera()), si hay una trama retenida o tras finalizar().
+     *          Mientras el inicio no está fijo no entrega nada.
+     */
+    int extraer(TramaCompacta* salida, int capacidadSalida);
+
+    /**
+     * @brief Revisa si el hueco que detiene la entrega ya esperó demasiado
+     * @details Se llama una vez por turno de lectura, no por trama: la
+     *          primera revisión que ve detenida la entrega toma la hora, y una
+     *          posterior que la sigue viendo detenida en el mismo número marca
+     *          el hueco como vencido si pasó el tiempo de espera. La espera
+     *          efectiva es la configurada más, a lo sumo, un turno. Mientras el
+     *          inicio no está fijo mide igual la espera desde la primera trama.
+     */
+    void revisarEspera();
+
+    /**
+     * @brief Indica que no llegarán más tramas
+     * @details Las siguientes llamadas a extraer() entregan todo lo pendiente
+     *          sin esperar por los huecos.
+     */
+    void finalizar();
+
+    /**
+     * @brief Indica si se puede llamar a insertar()
+     * @return false si hay una trama retenida que extraer() todavía no acomodó
+     */
+    bool admiteTramas() const;
+
+    /**
+     * @brief Indica si ya no queda nada por entregar
+     * @return true si la ventana está vacía y no hay trama retenida
+     */
+    bool estaVacio() const;
+
+    /**
+     * @brief Indica si el inicio de la secuencia ya está fijo
+     * @return true si getSiguiente() es el número que toca entregar
+     */
+    bool estaIniciado() const;
+
+    /**
+     * @brief Obtiene el número de la siguiente trama a entregar
+     * @return Número que toca (sin sentido si estaIniciado() es false)
+     */
+    unsigned int getSiguiente() const;
+
+    /**
+     * @brief Obtiene el origen de la trama en espera que se leyó primero
+     * @param origen Recibe el origen
+     * @return false si no hay tramas en espera
+     * @details Recorre la ventana (O(capacidad)); se usa al escribir un punto de control.
+     */
+    bool getOrigenMasAntiguo(OrigenTrama* origen) const;
+
+    /**
+     * @brief Obtiene el número de ranuras
+     * @return Capacidad de la ventana
+     */
+    int getCapacidad() const;
+
+    /**
+     * @brief Obtiene las tramas entregadas
+     * @return Tramas entregadas en orden
+     */
+    long long getEntregadas() const;
+
+    /**
+     * @brief Obtiene las tramas que llegaron desordenadas
+     * @return Tramas que tuvieron que esperar a una anterior (antes de fijar el
+     *         inicio, las que llegaron detrás de una posterior)
+     */
+    long long getReordenadas() const;
+
+    /**
+     * @brief Obtiene los números de secuencia perdidos
+     * @return Números saltados sin recibir su trama
+     */
+    long long getPerdidas() const;
+
+    /**
+     * @brief Obtiene las tramas repetidas descartadas
+     * @return Tramas cuyo número ya estaba en la ventana
+     */
+    long long getDuplicadas() const;
+
+    /**
+     * @brief Obtiene las tramas descartadas por llegar tarde
+     * @return Tramas cuyo turno ya había pasado
+     */
+    long long getTardias() const;
+};
+
+#endif // BUFFER_DE_REORDEN_H
@@ -0,0 +1,259 @@
+/**
+ * @file CascadaDeRotores.cpp
+ * @brief Implementación de la clase CascadaDeRotores
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "CascadaDeRotores.h"
+#include <iostream>
+#include <cstring>
+
+/**
+ * @brief Convierte una letra (mayúscula o minúscula) a su índice en [0, 26)
+ * @return Índice, o -1 si no es una letra A-Z
+ */
+static int indiceLetra(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    return -1;
+}
+
+/**
+ * @brief Constructor: cascada vacía (no modifica ningún carácter)
+ */
+CascadaDeRotores::CascadaDeRotores()
+    : numRotores(0), sucio(false), colaSucia(false), ultimoPorCarga(-1) {
+    for (int i = 0; i < LETRAS; i++) {
+        compuesta[i] = (unsigned char)i;
+        cola[i] = (unsigned char)i;
+    }
+}
+
+/**
+ * @brief Agrega un rotor al final de la cascada, en la posición 0
+ * @param cableado 26 letras distintas: la salida de A, de B, ... de Z
+ * @param muescas Letras de las posiciones que arrastran al rotor siguiente
+ * @param regla Regla de avance del rotor
+ * @return false si el cableado no es una permutación de A-Z o la cascada está llena
+ */
+bool CascadaDeRotores::agregarRotor(const char* cableado, const char* muescas, ReglaPaso regla) {
+    if (numRotores >= MAX_ROTORES) {
+        std::cerr << "Error: La cascada admite a lo más " << MAX_ROTORES << " rotores" << std::endl;
+        return false;
+    }
+
+    Rotor& rotor = rotores[numRotores];
+    int salidas[LETRAS];
+    unsigned int usadas = 0;
+    for (int i = 0; i < LETRAS; i++) {
+        int salida = indiceLetra(cableado[i]);
+        if (salida < 0 || (usadas & (1u << salida))) {
+            std::cerr << "Error: El cableado del rotor " << numRotores
+                      << " no es una permutación de A-Z" << std::endl;
+            return false;
+        }
+        usadas |= 1u << salida;
+        salidas[i] = salida;
+    }
+    if (cableado[LETRAS] != '\0' && cableado[LETRAS] != ':' && cableado[LETRAS] != ',') {
+        std::cerr << "Error: El cableado del rotor " << numRotores << " tiene más de 26 letras" << std::endl;
+        return false;
+    }
+
+    rotor.muescas = 0;
+    for (const char* m = muescas; *m != '\0' && *m != ','; m++) {
+        int posicion = indiceLetra(*m);
+        if (posicion < 0) {
+            std::cerr << "Error: Muesca inválida en el rotor " << numRotores << ": '" << *m << "'" << std::endl;
+            return false;
+        }
+        rotor.muescas |= 1u << posicion;
+    }
+    rotor.regla = regla;
+    rotor.posicion = 0;
+
+    // En la posición p el contacto x toca el cable x + p, y la salida se desplaza -p
+    for (int p = 0; p < LETRAS; p++) {
+        for (int x = 0; x < LETRAS; x++) {
+            int salida = salidas[(x + p) % LETRAS] - p;
+            rotor.tabla[p * LETRAS + x] = (unsigned char)(salida < 0 ? salida + LETRAS : salida);
+        }
+    }
+    if (regla == PASO_POR_CARGA) ultimoPorCarga = numRotores;
+    numRotores++;
+    sucio = true;
+    colaSucia = true;
+    return true;
+}
+
+/**
+ * @brief Configura la cascada a partir de una especificación de texto
+ * @param especificacion Rotores separados por comas, cada uno "CABLEADO[:MUESCAS]"
+ * @param conAvance true: el rotor 0 avanza por carga y los demás por muesca
+ * @return false si la especificación es inválida (la cascada queda vacía)
+ */
+bool CascadaDeRotores::configurar(const char* especificacion, bool conAvance) {
+    numRotores = 0;
+    ultimoPorCarga = -1;
+
+    const char* actual = especificacion;
+    while (*actual != '\0') {
+        const char* fin = strchr(actual, ',');
+        if (fin == nullptr) fin = actual + strlen(actual);
+        const char* separador = (const char*)memchr(actual, ':', (size_t)(fin - actual));
+
+        ReglaPaso regla = PASO_FIJO;
+        if (conAvance) regla = (numRotores == 0) ? PASO_POR_CARGA : PASO_POR_MUESCA;
+
+        if (fin - actual < LETRAS ||
+            !agregarRotor(actual, separador != nullptr ? separador + 1 : "", regla)) {
+            std::cerr << "Error: Especificación de cascada inválida: " << especificacion << std::endl;
+            numRotores = 0;
+            ultimoPorCarga = -1;
+            return false;
+        }
+        actual = (*fin == ',') ? fin + 1 : fin;
+    }
+    return numRotores > 0;
+}
+
+/**
+ * @brief Recalcula las tablas compuestas que quedaron desactualizadas
+ */
+void CascadaDeRotores::recomponer() {
+    if (colaSucia) {
+        for (int x = 0; x < LETRAS; x++) {
+            int y = x;
+            for (int i = 2; i < numRotores; i++) {
+                y = rotores[i].tabla[rotores[i].posicion * LETRAS + y];
+            }
+            cola[x] = (unsigned char)y;
+        }
+        colaSucia = false;
+    }
+    const unsigned char* segundo = numRotores > 1 ? &rotores[1].tabla[rotores[1].posicion * LETRAS] : nullptr;
+    for (int x = 0; x < LETRAS; x++) {
+        compuesta[x] = segundo != nullptr ? cola[segundo[x]] : (unsigned char)x;
+    }
+    sucio = false;
+}
+
+/**
+ * @brief Marca como desactualizadas las tablas que incluyen a un rotor
+ * @param indice Rotor que se movió
+ */
+void CascadaDeRotores::marcarMovido(int indice) {
+    // El rotor 0 se consulta directamente por posición
+    if (indice >= 1) sucio = true;
+    if (indice >= 2) colaSucia = true;
+}
+
+/**
+ * @brief Aplica las reglas de avance a partir de un rotor
+ * @param inicio Primer rotor a considerar
+ * @param arrastre true si el rotor anterior a inicio salió de una muesca
+ */
+void CascadaDeRotores::avanzarDesde(int inicio, bool arrastre) {
+    for (int i = inicio; i < numRotores; i++) {
+        Rotor& rotor = rotores[i];
+        bool mover = rotor.regla == PASO_POR_CARGA || (arrastre && rotor.regla == PASO_POR_MUESCA);
+        if (!mover) {
+            if (i >= ultimoPorCarga) break;
+            arrastre = false;
+            continue;
+        }
+        // La muesca se evalúa en la posición que el rotor abandona
+        arrastre = ((rotor.muescas >> rotor.posicion) & 1u) != 0;
+        rotor.posicion = (rotor.posicion + 1 == LETRAS) ? 0 : rotor.posicion + 1;
+        marcarMovido(i);
+        if (!arrastre && i >= ultimoPorCarga) break;
+    }
+}
+
+/**
+ * @brief Aplica las reglas de avance de una carga
+ */
+inline void CascadaDeRotores::avanzar() {
+    if (ultimoPorCarga == 0) {
+        Rotor& rotor = rotores[0];
+        bool arrastre = ((rotor.muescas >> rotor.posicion) & 1u) != 0;
+        rotor.posicion = (rotor.posicion + 1 == LETRAS) ? 0 : rotor.posicion + 1;
+        if (arrastre) avanzarDesde(1, true);
+    } else if (ultimoPorCarga > 0) {
+        avanzarDesde(0, false);
+    }
+}
+
+/**
+ * @brief Transforma el carácter de una carga y aplica las reglas de avance
+ * @param entrada Carácter ya mapeado por el rotor principal
+ * @return Carácter transformado por la cascada
+ */
+char CascadaDeRotores::cifrar(char entrada) {
+    if (numRotores == 0) return entrada;
+    if (sucio) recomponer();
+
+    char salida = entrada;
+    if (entrada >= 'A' && entrada <= 'Z') {
+        int x = rotores[0].tabla[rotores[0].posicion * LETRAS + (entrada - 'A')];
+        salida = (char)('A' + compuesta[x]);
+    }
+    // Todas las cargas avanzan la cascada, también las que no son letras
+    avanzar();
+    return salida;
+}
+
+/**
+ * @brief Transforma en el lugar los caracteres de varias cargas consecutivas
+ * @param datos Caracteres a transformar
+ * @param cantidad Número de cargas
+ */
+void CascadaDeRotores::cifrarLote(char* datos, int cantidad) {
+    if (numRotores == 0) return;
+    const Rotor& primero = rotores[0];
+    for (int i = 0; i < cantidad; i++) {
+        if (sucio) recomponer();
+        unsigned int x = (unsigned int)((unsigned char)datos[i] - 'A');
+        if (x < (unsigned int)LETRAS) {
+            datos[i] = (char)('A' + compuesta[primero.tabla[primero.posicion * LETRAS + x]]);
+        }
+        avanzar();
+    }
+}
+
+/**
+ * @brief Rota un rotor de la cascada (trama R,k,N)
+ * @param indice Rotor a rotar, en [0, K)
+ * @param n Posiciones a rotar
+ * @return false si el rotor no existe
+ */
+bool CascadaDeRotores::rotar(int indice, int n) {
+    if (indice < 0 || indice >= numRotores) return false;
+
+    n = n % LETRAS;
+    if (n < 0) n += LETRAS;
+    int posicion = rotores[indice].posicion + n;
+    if (posicion >= LETRAS) posicion -= LETRAS;
+    rotores[indice].posicion = posicion;
+    if (n != 0) marcarMovido(indice);
+    return true;
+}
+
+/**
+ * @brief Obtiene la posición de un rotor
+ * @param indice Rotor, en [0, K)
+ * @return Posición en [0, 26), o -1 si el rotor no existe
+ */
+int CascadaDeRotores::getPosicion(int indice) const {
+    if (indice < 0 || indice >= numRotores) return -1;
+    return rotores[indice].posicion;
+}
+
+/**
+ * @brief Obtiene el número de rotores
+ * @return Rotores configurados
+ */
+int CascadaDeRotores::getNumRotores() const {
+    return numRotores;
+}
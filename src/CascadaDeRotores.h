@@ -0,0 +1,157 @@
+/**
+ * @file CascadaDeRotores.h
+ * @brief Cadena de rotores con cableado arbitrario y avance por carga (estilo Enigma)
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef CASCADA_DE_ROTORES_H
+#define CASCADA_DE_ROTORES_H
+
+/**
+ * @class CascadaDeRotores
+ * @brief K rotores de 26 letras encadenados, cada uno con su propio cableado
+ * @details Una letra entra por el rotor 0 y sale por el rotor K-1. El rotor i
+ *          en la posición p transforma x en cableado[(x + p) mod 26] - p. Los
+ *          caracteres que no son A-Z atraviesan la cascada sin cambios.
+ *
+ *          Reglas de avance, aplicadas después de cada carga:
+ *          - PASO_POR_CARGA: el rotor avanza una posición con cada carga.
+ *          - PASO_POR_MUESCA: el rotor avanza cuando el anterior sale de una
+ *            de sus muescas (como un odómetro).
+ *          - PASO_FIJO: sólo se mueve con tramas R,k,N.
+ *
+ *          Para que cada carga cueste O(1) sin importar K, cada rotor guarda
+ *          su mapeo en cada una de sus 26 posiciones y la composición de los
+ *          rotores 1..K-1 se guarda en una tabla de 26 entradas que sólo se
+ *          recalcula (de forma perezosa, en la siguiente carga) cuando alguno
+ *          de ellos se mueve. Así una carga son dos consultas a tabla. Además
+ *          la composición de los rotores 2..K-1 se guarda aparte: cuando sólo
+ *          avanza el rotor 1 (lo normal al pasar una muesca del rotor 0) el
+ *          recálculo son 26 consultas, y el de O(26·K) queda para cuando se
+ *          mueve uno de los rotores más lentos (por muesca o con R,k,N).
+ */
+class CascadaDeRotores {
+public:
+    static const int LETRAS = 26;      ///< Tamaño del alfabeto de cada rotor
+    static const int MAX_ROTORES = 16; ///< Máximo de rotores en la cascada
+
+    /**
+     * @brief Cuándo avanza un rotor por sí solo
+     */
+    enum ReglaPaso {
+        PASO_FIJO,        ///< Nunca (sólo con tramas R,k,N)
+        PASO_POR_CARGA,   ///< Una posición por cada carga
+        PASO_POR_MUESCA   ///< Cuando el rotor anterior sale de una muesca
+    };
+
+private:
+    /**
+     * @brief Estado de un rotor de la cascada
+     */
+    struct Rotor {
+        unsigned char tabla[LETRAS * LETRAS]; ///< Salida de cada contacto en cada posición, en [0, 26)
+        unsigned int muescas;           ///< Bit p activo si la posición p arrastra al siguiente
+        ReglaPaso regla;                ///< Regla de avance
+        int posicion;                   ///< Posición actual, en [0, 26)
+    };
+
+    Rotor rotores[MAX_ROTORES];       ///< Rotores en orden de paso de la señal
+    int numRotores;                   ///< Rotores configurados
+    unsigned char compuesta[LETRAS];  ///< Composición de los rotores 1..K-1
+    unsigned char cola[LETRAS];       ///< Composición de los rotores 2..K-1
+    bool sucio;                       ///< compuesta no refleja las posiciones actuales
+    bool colaSucia;                   ///< cola no refleja las posiciones actuales
+    int ultimoPorCarga;               ///< Último rotor con PASO_POR_CARGA, o -1
+
+    /**
+     * @brief Recalcula las tablas compuestas que quedaron desactualizadas
+     */
+    void recomponer();
+
+    /**
+     * @brief Marca como desactualizadas las tablas que incluyen a un rotor
+     * @param indice Rotor que se movió
+     */
+    void marcarMovido(int indice);
+
+    /**
+     * @brief Aplica las reglas de avance de una carga
+     * @details Resuelve en línea el caso común (sólo el rotor 0 avanza por
+     *          carga) y delega el resto en avanzarDesde().
+     */
+    void avanzar();
+
+    /**
+     * @brief Aplica las reglas de avance a partir de un rotor
+     * @param inicio Primer rotor a considerar
+     * @param arrastre true si el rotor anterior a inicio salió de una muesca
+     * @details Se detiene en el primer rotor que no se mueve y no tiene otro
+     *          PASO_POR_CARGA detrás.
+     */
+    void avanzarDesde(int inicio, bool arrastre);
+
+public:
+    /**
+     * @brief Constructor: cascada vacía (no modifica ningún carácter)
+     */
+    CascadaDeRotores();
+
+    /**
+     * @brief Agrega un rotor al final de la cascada, en la posición 0
+     * @param cableado 26 letras distintas: la salida de A, de B, ... de Z
+     * @param muescas Letras de las posiciones que arrastran al rotor siguiente ("" = ninguna)
+     * @param regla Regla de avance del rotor
+     * @return false si el cableado no es una permutación de A-Z o la cascada está llena
+     */
+    bool agregarRotor(const char* cableado, const char* muescas, ReglaPaso regla);
+
+    /**
+     * @brief Configura la cascada a partir de una especificación de texto
+     * @param especificacion Rotores separados por comas, cada uno "CABLEADO[:MUESCAS]"
+     * @param conAvance true: el rotor 0 avanza por carga y los demás por muesca;
+     *                  false: todos los rotores son fijos
+     * @return false si la especificación es inválida (la cascada queda vacía)
+     * @details Ejemplo: "EKMFLGDQVZNTOWYHXUSPAIBRCJ:Q,AJDKSIRUXBLHWTMCQGZNPYFVOE:E"
+     */
+    bool configurar(const char* especificacion, bool conAvance);
+
+    /**
+     * @brief Transforma el carácter de una carga y aplica las reglas de avance
+     * @param entrada Carácter ya mapeado por el rotor principal
+     * @return Carácter transformado por la cascada
+     */
+    char cifrar(char entrada);
+
+    /**
+     * @brief Transforma en el lugar los caracteres de varias cargas consecutivas
+     * @param datos Caracteres a transformar
+     * @param cantidad Número de cargas
+     * @details Equivale a llamar a cifrar() con cada carácter, en orden.
+     */
+    void cifrarLote(char* datos, int cantidad);
+
+    /**
+     * @brief Rota un rotor de la cascada (trama R,k,N)
+     * @param indice Rotor a rotar, en [0, K)
+     * @param n Posiciones a rotar (positivo = horario, negativo = antihorario)
+     * @return false si el rotor no existe
+     * @details No arrastra a los rotores siguientes.
+     */
+    bool rotar(int indice, int n);
+
+    /**
+     * @brief Obtiene la posición de un rotor
+     * @param indice Rotor, en [0, K)
+     * @return Posición en [0, 26), o -1 si el rotor no existe
+     */
+    int getPosicion(int indice) const;
+
+    /**
+     * @brief Obtiene el número de rotores
+     * @return Rotores configurados
+     */
+    int getNumRotores() const;
+};
+
+#endif // CASCADA_DE_ROTORES_H
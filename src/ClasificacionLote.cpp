@@ -0,0 +1,173 @@
+/**
+ * @file ClasificacionLote.cpp
+ * @brief Implementación de la clasificación de tramas de texto por lotes
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "ClasificacionLote.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define PRT7_CLASIFICACION_SSE2 1
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define PRT7_CLASIFICACION_AVX2 1
+#endif
+
+/**
+ * @brief Verifica si los 4 bytes siguientes son una trama LOAD completa "L,X\n"
+ * @details X no puede ser '\n' ni '\r': "L,\n" y "L,\r\n" son líneas cortas.
+ */
+static inline bool esCargaCompleta(const char* p) {
+    return (p[0] | 0x20) == 'l' && p[1] == ',' && p[3] == '\n' && p[2] != '\n' && p[2] != '\r';
+}
+
+/**
+ * @brief Escribe una trama LOAD en el arreglo de salida
+ */
+static inline void escribirCarga(TramaCompacta* destino, char caracter) {
+    destino->tipo = TRAMA_LOAD;
+    destino->valor = (unsigned char)caracter;
+    destino->indice = 0;
+}
+
+/**
+ * @brief Reconoce la racha de "L,X\n" al inicio del buffer (versión escalar)
+ * @return Tramas LOAD escritas; ocupan 4 bytes cada una
+ */
+static int clasificarCargasEscalar(const char* datos, size_t longitud, TramaCompacta* salida, int capacidad) {
+    int n = 0;
+    while (n < capacidad && longitud >= 4 && esCargaCompleta(datos)) {
+        escribirCarga(&salida[n++], datos[2]);
+        datos += 4;
+        longitud -= 4;
+    }
+    return n;
+}
+
+#ifdef PRT7_CLASIFICACION_SSE2
+/**
+ * @brief Versión SSE2: 4 tramas "L,X\n" por comparación
+ */
+static int clasificarCargasSSE2(const char* datos, size_t longitud, TramaCompacta* salida, int capacidad) {
+    // Por trama: el tipo sin el bit de minúscula, la coma, el carácter (libre) y el '\n'
+    const __m128i mascara = _mm_set1_epi32((int)0xFF00FFDFu);
+    const __m128i esperado = _mm_set1_epi32((int)(('\n' << 24) | (',' << 8) | 'L'));
+    const __m128i posicionCaracter = _mm_set1_epi32(0x00FF0000);
+    const __m128i saltoLinea = _mm_set1_epi8('\n');
+    const __m128i retorno = _mm_set1_epi8('\r');
+
+    int n = 0;
+    while (n + 4 <= capacidad && longitud >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)datos);
+        __m128i coincide = _mm_cmpeq_epi8(_mm_and_si128(v, mascara), esperado);
+        __m128i prohibido = _mm_and_si128(_mm_or_si128(_mm_cmpeq_epi8(v, saltoLinea), _mm_cmpeq_epi8(v, retorno)),
+                                          posicionCaracter);
+        if (_mm_movemask_epi8(_mm_andnot_si128(prohibido, coincide)) != 0xFFFF) break;
+        for (int i = 0; i < 4; i++) escribirCarga(&salida[n + i], datos[4 * i + 2]);
+        n += 4;
+        datos += 16;
+        longitud -= 16;
+    }
+    return n + clasificarCargasEscalar(datos, longitud, salida + n, capacidad - n);
+}
+#endif
+
+#ifdef PRT7_CLASIFICACION_AVX2
+/**
+ * @brief Versión AVX2: 8 tramas "L,X\n" por comparación
+ */
+__attribute__((target("avx2")))
+static int clasificarCargasAVX2(const char* datos, size_t longitud, TramaCompacta* salida, int capacidad) {
+    const __m256i mascara = _mm256_set1_epi32((int)0xFF00FFDFu);
+    const __m256i esperado = _mm256_set1_epi32((int)(('\n' << 24) | (',' << 8) | 'L'));
+    const __m256i posicionCaracter = _mm256_set1_epi32(0x00FF0000);
+    const __m256i saltoLinea = _mm256_set1_epi8('\n');
+    const __m256i retorno = _mm256_set1_epi8('\r');
+
+    int n = 0;
+    while (n + 8 <= capacidad && longitud >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)datos);
+        __m256i coincide = _mm256_cmpeq_epi8(_mm256_and_si256(v, mascara), esperado);
+        __m256i prohibido = _mm256_and_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, saltoLinea),
+                                                             _mm256_cmpeq_epi8(v, retorno)),
+                                             posicionCaracter);
+        if (_mm256_movemask_epi8(_mm256_andnot_si256(prohibido, coincide)) != -1) break;
+        for (int i = 0; i < 8; i++) escribirCarga(&salida[n + i], datos[4 * i + 2]);
+        n += 8;
+        datos += 32;
+        longitud -= 32;
+    }
+    return n + clasificarCargasEscalar(datos, longitud, salida + n, capacidad - n);
+}
+#endif
+
+typedef int (*FuncionCargas)(const char*, size_t, TramaCompacta*, int);
+
+/**
+ * @brief Elige la mejor implementación disponible en este procesador
+ */
+static FuncionCargas seleccionarImplementacion(const char** nombre) {
+#ifdef PRT7_CLASIFICACION_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *nombre = "avx2";
+        return clasificarCargasAVX2;
+    }
+#endif
+#ifdef PRT7_CLASIFICACION_SSE2
+    *nombre = "sse2";
+    return clasificarCargasSSE2;
+#else
+    *nombre = "escalar";
+    return clasificarCargasEscalar;
+#endif
+}
+
+static const char* nombreImplementacion = "escalar";
+static const FuncionCargas implementacionCargas = seleccionarImplementacion(&nombreImplementacion);
+
+ResultadoLote clasificarLote(const char* datos, size_t longitud, TramaCompacta* salida, int capacidad) {
+    ResultadoLote resultado;
+    resultado.tramas = 0;
+    resultado.lineas = 0;
+    resultado.fin = false;
+
+    const char* actual = datos;
+    const char* final = datos + longitud;
+    while (resultado.lineas < capacidad) {
+        // Primero la racha de cargas de 4 bytes, el caso común
+        int cargas = implementacionCargas(actual, (size_t)(final - actual), salida + resultado.tramas,
+                                          capacidad - resultado.lineas);
+        actual += 4 * cargas;
+        resultado.tramas += cargas;
+        resultado.lineas += cargas;
+        if (resultado.lineas == capacidad) break;
+
+        // Cualquier otra línea: se busca el '\n' y se aplica clasificarTrama()
+        const char* salto = (const char*)memchr(actual, '\n', (size_t)(final - actual));
+        if (salto == nullptr) break;
+        const char* linea = actual;
+        int largo = (int)(salto - actual);
+        if (largo > 0 && linea[largo - 1] == '\r') largo--;
+        actual = salto + 1;
+        resultado.lineas++;
+
+        if (largo == 0) continue;
+        if (largo == 3 && memcmp(linea, "END", 3) == 0) {
+            resultado.fin = true;
+            break;
+        }
+        salida[resultado.tramas++] = clasificarTrama(linea, largo);
+    }
+    resultado.consumidos = (size_t)(actual - datos);
+    return resultado;
+}
+
+const char* getImplementacionClasificacion() {
+    return nombreImplementacion;
+}
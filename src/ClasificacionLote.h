@@ -0,0 +1,47 @@
+/**
+ * @file ClasificacionLote.h
+ * @brief Clasificación de muchas líneas de texto por llamada, sobre un buffer de bytes
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef CLASIFICACION_LOTE_H
+#define CLASIFICACION_LOTE_H
+
+#include <cstddef>
+#include "TramaCompacta.h"
+
+/**
+ * @brief Resultado de clasificarLote()
+ */
+struct ResultadoLote {
+    int tramas;        ///< Entradas escritas en el arreglo de salida
+    int lineas;        ///< Líneas consumidas, incluidas las vacías y la de "END"
+    size_t consumidos; ///< Bytes consumidos; siempre terminan en un '\n'
+    bool fin;          ///< La última línea consumida es "END"
+};
+
+/**
+ * @brief Clasifica las líneas completas de un buffer sin copiar, imprimir ni reservar memoria
+ * @param datos Bytes del flujo de texto (no necesitan terminar en '\0')
+ * @param longitud Número de bytes disponibles
+ * @param salida Arreglo donde se escribe una entrada por línea no vacía
+ * @param capacidad Máximo de líneas a consumir (y por lo tanto de entradas a escribir)
+ * @return Entradas escritas, líneas y bytes consumidos, y si se encontró "END"
+ * @details Sólo consume líneas terminadas en '\n'; una línea incompleta al
+ *          final del buffer queda para la siguiente llamada. Quita un '\r'
+ *          final, se salta las líneas vacías y se detiene después de "END".
+ *          Cada línea se clasifica con las reglas de clasificarTrama(); las
+ *          inválidas se escriben con tipo TRAMA_INVALIDA y el motivo en valor,
+ *          en su lugar del flujo. Las rachas de "L,X\n" se reconocen con
+ *          AVX2 o SSE2 de a 8 o 4 tramas por comparación, según el procesador.
+ */
+ResultadoLote clasificarLote(const char* datos, size_t longitud, TramaCompacta* salida, int capacidad);
+
+/**
+ * @brief Obtiene el nombre de la implementación elegida por clasificarLote()
+ * @return "avx2", "sse2" o "escalar"
+ */
+const char* getImplementacionClasificacion();
+
+#endif // CLASIFICACION_LOTE_H
@@ -0,0 +1,90 @@
+/**
+ * @file CodificacionEnteros.h
+ * @brief Enteros little-endian, varints LEB128 y zigzag de los formatos binarios
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ * @details Los comparten el formato binario de tramas, el programa compilado
+ *          de una captura y el registro de los puntos de control. Son funciones
+ *          cortas que se llaman por cada campo, por eso viven en el header.
+ */
+
+#ifndef CODIFICACION_ENTEROS_H
+#define CODIFICACION_ENTEROS_H
+
+/**
+ * @brief Escribe un entero en little-endian
+ * @param destino Buffer de al menos bytes bytes
+ * @param valor Entero a escribir (se toman sus bytes bajos)
+ * @param bytes Número de bytes (1 a 8)
+ */
+inline void escribirEntero(unsigned char* destino, unsigned long long valor, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        destino[i] = (unsigned char)(valor >> (8 * i));
+    }
+}
+
+/**
+ * @brief Lee un entero en little-endian
+ * @param origen Bytes del entero
+ * @param bytes Número de bytes (1 a 8)
+ * @return Entero leído
+ */
+inline unsigned long long leerEntero(const unsigned char* origen, int bytes) {
+    unsigned long long valor = 0;
+    for (int i = 0; i < bytes; i++) {
+        valor |= (unsigned long long)origen[i] << (8 * i);
+    }
+    return valor;
+}
+
+/**
+ * @brief Escribe un entero sin signo en LEB128 (7 bits por byte, el bit alto indica continuación)
+ * @param valor Entero a escribir
+ * @param destino Buffer de al menos 5 bytes
+ * @return Bytes escritos (1 a 5)
+ */
+inline int escribirVarint(unsigned int valor, unsigned char* destino) {
+    int n = 0;
+    while (valor >= 0x80) {
+        destino[n++] = (unsigned char)((valor & 0x7F) | 0x80);
+        valor >>= 7;
+    }
+    destino[n++] = (unsigned char)valor;
+    return n;
+}
+
+/**
+ * @brief Lee un varint LEB128 de a lo más 5 bytes
+ * @param actual Posición de lectura; avanza sobre el varint
+ * @param fin Final de los datos
+ * @param valor Recibe el valor
+ * @return false si el varint está cortado o es demasiado largo
+ */
+inline bool leerVarint(const unsigned char** actual, const unsigned char* fin, unsigned int* valor) {
+    unsigned int resultado = 0;
+    for (int i = 0; i < 5 && *actual < fin; i++) {
+        unsigned char byte = *(*actual)++;
+        resultado |= (unsigned int)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            *valor = resultado;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Codifica un entero con signo en zigzag: los valores pequeños negativos también son pequeños
+ */
+inline unsigned int codificarZigzag(int valor) {
+    return ((unsigned int)valor << 1) ^ (unsigned int)(valor >> 31);
+}
+
+/**
+ * @brief Decodifica un entero codificado con codificarZigzag()
+ */
+inline int decodificarZigzag(unsigned int codigo) {
+    return (int)((codigo >> 1) ^ (0u - (codigo & 1u)));
+}
+
+#endif // CODIFICACION_ENTEROS_H
@@ -0,0 +1,106 @@
+/**
+ * @file ColaSPSC.h
+ * @brief Cola circular acotada sin candados para un productor y un consumidor
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef COLA_SPSC_H
+#define COLA_SPSC_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class ColaSPSC
+ * @brief Cola circular de capacidad fija para exactamente un hilo productor y uno consumidor
+ * @details Es una plantilla, por eso vive completa en el header. Los índices
+ *          crecen sin límite y se reducen con una máscara, así que la capacidad
+ *          se redondea a potencia de dos. Cada lado guarda una copia local del
+ *          índice del otro para no leer la variable atómica compartida en cada
+ *          operación.
+ */
+template <typename T>
+class ColaSPSC {
+private:
+    T* elementos;      ///< Almacenamiento circular
+    size_t capacidad;  ///< Número de casillas (potencia de dos)
+    size_t mascara;    ///< capacidad - 1
+
+    alignas(64) std::atomic<size_t> cola;   ///< Siguiente casilla a escribir (productor)
+    size_t cabezaVista;                     ///< Última cabeza leída por el productor
+    alignas(64) std::atomic<size_t> cabeza; ///< Siguiente casilla a leer (consumidor)
+    size_t colaVista;                       ///< Última cola leída por el consumidor
+
+    ColaSPSC(const ColaSPSC&);
+    ColaSPSC& operator=(const ColaSPSC&);
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacidadMinima Elementos que debe admitir (se redondea a potencia de dos)
+     */
+    explicit ColaSPSC(size_t capacidadMinima)
+        : capacidad(1), cola(0), cabezaVista(0), cabeza(0), colaVista(0) {
+        while (capacidad < capacidadMinima) capacidad <<= 1;
+        mascara = capacidad - 1;
+        elementos = new T[capacidad];
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~ColaSPSC() {
+        delete[] elementos;
+    }
+
+    /**
+     * @brief Intenta encolar un elemento (sólo desde el hilo productor)
+     * @param elemento Elemento a copiar en la cola
+     * @return false si la cola está llena
+     */
+    bool intentarEncolar(const T& elemento) {
+        size_t posicion = cola.load(std::memory_order_relaxed);
+        if (posicion - cabezaVista == capacidad) {
+            cabezaVista = cabeza.load(std::memory_order_acquire);
+            if (posicion - cabezaVista == capacidad) return false;
+        }
+        elementos[posicion & mascara] = elemento;
+        cola.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Intenta desencolar un elemento (sólo desde el hilo consumidor)
+     * @param elemento Recibe el elemento extraído
+     * @return false si la cola está vacía
+     */
+    bool intentarDesencolar(T* elemento) {
+        size_t posicion = cabeza.load(std::memory_order_relaxed);
+        if (posicion == colaVista) {
+            colaVista = cola.load(std::memory_order_acquire);
+            if (posicion == colaVista) return false;
+        }
+        *elemento = elementos[posicion & mascara];
+        cabeza.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Número aproximado de elementos en la cola (desde cualquier hilo)
+     * @return Elementos encolados
+     */
+    size_t ocupacion() const {
+        return cola.load(std::memory_order_acquire) - cabeza.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Capacidad real de la cola
+     * @return Número de casillas
+     */
+    size_t getCapacidad() const {
+        return capacidad;
+    }
+};
+
+#endif // COLA_SPSC_H
@@ -0,0 +1,146 @@
+/**
+ * @file DecodificacionLote.cpp
+ * @brief Implementación de los kernels de decodificación por lotes
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "DecodificacionLote.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define PRT7_LOTE_SSE2 1
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define PRT7_LOTE_AVX2 1
+#endif
+
+/// Tamaño del bloque intermedio usado por decodificarEInsertar()
+static const int BLOQUE_LOTE = 4096;
+
+void decodificarLoteEscalar(const char* entrada, char* salida, int cantidad, int posicion) {
+    for (int i = 0; i < cantidad; i++) {
+        char c = entrada[i];
+        if (c >= 'A' && c <= 'Z') {
+            int indice = (c - 'A') + posicion;
+            if (indice >= 26) indice -= 26;
+            c = (char)('A' + indice);
+        }
+        salida[i] = c;
+    }
+}
+
+#ifdef PRT7_LOTE_SSE2
+/**
+ * @brief Versión SSE2: 16 caracteres por iteración
+ */
+static void decodificarLoteSSE2(const char* entrada, char* salida, int cantidad, int posicion) {
+    const __m128i menorQueA = _mm_set1_epi8('A' - 1);
+    const __m128i mayorQueZ = _mm_set1_epi8('Z' + 1);
+    const __m128i limiteZ = _mm_set1_epi8('Z');
+    const __m128i desplazamiento = _mm_set1_epi8((char)posicion);
+    const __m128i vuelta = _mm_set1_epi8(26);
+
+    int i = 0;
+    for (; i + 16 <= cantidad; i += 16) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(entrada + i));
+        // Comparaciones con signo: los bytes >= 0x80 quedan fuera de A-Z
+        __m128i esLetra = _mm_and_si128(_mm_cmpgt_epi8(c, menorQueA), _mm_cmplt_epi8(c, mayorQueZ));
+        __m128i v = _mm_add_epi8(c, desplazamiento);
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_cmpgt_epi8(v, limiteZ), vuelta));
+        __m128i r = _mm_or_si128(_mm_and_si128(esLetra, v), _mm_andnot_si128(esLetra, c));
+        _mm_storeu_si128((__m128i*)(salida + i), r);
+    }
+    decodificarLoteEscalar(entrada + i, salida + i, cantidad - i, posicion);
+}
+#endif
+
+#ifdef PRT7_LOTE_AVX2
+/**
+ * @brief Versión AVX2: 32 caracteres por iteración
+ */
+__attribute__((target("avx2")))
+static void decodificarLoteAVX2(const char* entrada, char* salida, int cantidad, int posicion) {
+    const __m256i menorQueA = _mm256_set1_epi8('A' - 1);
+    const __m256i limiteZ = _mm256_set1_epi8('Z');
+    const __m256i desplazamiento = _mm256_set1_epi8((char)posicion);
+    const __m256i vuelta = _mm256_set1_epi8(26);
+
+    int i = 0;
+    for (; i + 32 <= cantidad; i += 32) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(entrada + i));
+        __m256i esLetra = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, limiteZ), _mm256_cmpgt_epi8(c, menorQueA));
+        __m256i v = _mm256_add_epi8(c, desplazamiento);
+        v = _mm256_sub_epi8(v, _mm256_and_si256(_mm256_cmpgt_epi8(v, limiteZ), vuelta));
+        __m256i r = _mm256_blendv_epi8(c, v, esLetra);
+        _mm256_storeu_si256((__m256i*)(salida + i), r);
+    }
+    decodificarLoteEscalar(entrada + i, salida + i, cantidad - i, posicion);
+}
+#endif
+
+typedef void (*FuncionLote)(const char*, char*, int, int);
+
+/**
+ * @brief Elige la mejor implementación disponible en este procesador
+ */
+static FuncionLote seleccionarImplementacion(const char** nombre) {
+#ifdef PRT7_LOTE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *nombre = "avx2";
+        return decodificarLoteAVX2;
+    }
+#endif
+#ifdef PRT7_LOTE_SSE2
+    *nombre = "sse2";
+    return decodificarLoteSSE2;
+#else
+    *nombre = "escalar";
+    return decodificarLoteEscalar;
+#endif
+}
+
+static const char* nombreImplementacion = "escalar";
+static const FuncionLote implementacionLote = seleccionarImplementacion(&nombreImplementacion);
+
+void decodificarLote(const char* entrada, char* salida, int cantidad, int posicion) {
+    implementacionLote(entrada, salida, cantidad, posicion);
+}
+
+const char* getImplementacionLote() {
+    return nombreImplementacion;
+}
+
+bool decodificarLoteCon(const char* implementacion, const char* entrada, char* salida, int cantidad, int posicion) {
+    FuncionLote funcion = nullptr;
+    if (strcmp(implementacion, "escalar") == 0) {
+        funcion = decodificarLoteEscalar;
+    }
+#ifdef PRT7_LOTE_SSE2
+    if (strcmp(implementacion, "sse2") == 0) funcion = decodificarLoteSSE2;
+#endif
+#ifdef PRT7_LOTE_AVX2
+    if (strcmp(implementacion, "avx2") == 0 && __builtin_cpu_supports("avx2")) funcion = decodificarLoteAVX2;
+#endif
+    if (funcion == nullptr) return false;
+    funcion(entrada, salida, cantidad, posicion);
+    return true;
+}
+
+void decodificarEInsertar(const char* entrada, int cantidad, RotorDeMapeo* rotor, ListaDeCarga* carga) {
+    char bloque[BLOQUE_LOTE];
+    CascadaDeRotores* cascada = rotor->getCascada();
+    for (int i = 0; i < cantidad; i += BLOQUE_LOTE) {
+        int n = cantidad - i < BLOQUE_LOTE ? cantidad - i : BLOQUE_LOTE;
+        rotor->getMapeoLote(entrada + i, bloque, n);
+        if (cascada != nullptr) cascada->cifrarLote(bloque, n);
+        carga->insertarLote(bloque, n);
+    }
+}
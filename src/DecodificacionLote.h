@@ -0,0 +1,64 @@
+/**
+ * @file DecodificacionLote.h
+ * @brief Kernels vectorizados para decodificar rachas de tramas LOAD
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef DECODIFICACION_LOTE_H
+#define DECODIFICACION_LOTE_H
+
+class ListaDeCarga;
+class RotorDeMapeo;
+
+/**
+ * @brief Decodifica un lote de caracteres con el alfabeto A-Z (versión escalar)
+ * @param entrada Caracteres de las tramas LOAD
+ * @param salida Destino de los caracteres decodificados (puede ser igual a entrada)
+ * @param cantidad Número de caracteres
+ * @param posicion Posición cero del rotor, en [0, 26)
+ * @details Equivale a llamar RotorDeMapeo::getMapeo() sobre cada carácter: las
+ *          letras A-Z se desplazan `posicion` lugares y el resto pasa sin cambios.
+ */
+void decodificarLoteEscalar(const char* entrada, char* salida, int cantidad, int posicion);
+
+/**
+ * @brief Decodifica un lote de caracteres con el alfabeto A-Z
+ * @param entrada Caracteres de las tramas LOAD
+ * @param salida Destino de los caracteres decodificados (puede ser igual a entrada)
+ * @param cantidad Número de caracteres
+ * @param posicion Posición cero del rotor, en [0, 26)
+ * @details Usa AVX2, SSE2 o la versión escalar según lo que soporte el
+ *          procesador; la selección se hace una sola vez en tiempo de ejecución.
+ */
+void decodificarLote(const char* entrada, char* salida, int cantidad, int posicion);
+
+/**
+ * @brief Obtiene el nombre de la implementación elegida por decodificarLote()
+ * @return "avx2", "sse2" o "escalar"
+ */
+const char* getImplementacionLote();
+
+/**
+ * @brief Decodifica un lote con una implementación concreta (pruebas y benchmarks)
+ * @param implementacion "avx2", "sse2" o "escalar"
+ * @param entrada Caracteres de las tramas LOAD
+ * @param salida Destino de los caracteres decodificados (puede ser igual a entrada)
+ * @param cantidad Número de caracteres
+ * @param posicion Posición cero del rotor, en [0, 26)
+ * @return false si la implementación no está compilada o el procesador no la soporta
+ */
+bool decodificarLoteCon(const char* implementacion, const char* entrada, char* salida, int cantidad, int posicion);
+
+/**
+ * @brief Decodifica una racha de cargas con el rotor actual y la agrega a la lista
+ * @param entrada Caracteres de las tramas LOAD consecutivas
+ * @param cantidad Número de caracteres
+ * @param rotor Rotor en la posición vigente para toda la racha (su cascada avanza)
+ * @param carga Lista donde se insertan los caracteres decodificados
+ * @details Si el rotor tiene una cascada encadenada, se aplica después del
+ *          kernel por lotes y avanza una vez por carga.
+ */
+void decodificarEInsertar(const char* entrada, int cantidad, RotorDeMapeo* rotor, ListaDeCarga* carga);
+
+#endif // DECODIFICACION_LOTE_H
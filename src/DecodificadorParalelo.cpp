@@ -0,0 +1,265 @@
+/**
+ * @file DecodificadorParalelo.cpp
+ * @brief Implementación de la clase DecodificadorParalelo
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "DecodificadorParalelo.h"
+#include "TramaCompacta.h"
+#include "ClasificacionLote.h"
+#include "DecodificacionLote.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include <cstring>
+#include <thread>
+
+/// Líneas clasificadas por llamada a clasificarLote()
+static const int TRAMAS_POR_LOTE = 1024;
+
+/**
+ * @brief Estado de un bloque de bytes asignado a un hilo
+ */
+struct BloqueParalelo {
+    const char* inicio;      ///< Primer byte del bloque (siempre empieza una línea)
+    const char* fin;         ///< Byte siguiente al último del bloque
+    int rotacionNeta;        ///< Rotación acumulada del bloque, en [0, tamanio)
+    long long cargas;        ///< Número de tramas LOAD del bloque
+    long long lineas;        ///< Líneas del bloque, incluidas las vacías y la de "END"
+    long long invalidas;     ///< Número de líneas inválidas del bloque
+    bool terminaEnFin;       ///< El bloque contiene "END": lo que sigue no se procesa
+    int posicionInicial;     ///< Posición del rotor al entrar al bloque
+    long long salidaInicial; ///< Índice de salida del primer carácter del bloque
+};
+
+/**
+ * @brief Normaliza una rotación al rango [0, tamanio)
+ */
+static int normalizarRotacion(int n, int tamanio) {
+    if (tamanio <= 0) return 0;
+    n = n % tamanio;
+    if (n < 0) n += tamanio;
+    return n;
+}
+
+/**
+ * @brief Clasifica las siguientes líneas de un bloque
+ * @return Resultado de clasificarLote(); si sólo queda la última línea de la
+ *         captura, sin '\n', la clasifica como lo hace la fuente al final
+ */
+static ResultadoLote clasificarSiguientes(const char* datos, const char* fin, TramaCompacta* tramas) {
+    ResultadoLote lote = clasificarLote(datos, (size_t)(fin - datos), tramas, TRAMAS_POR_LOTE);
+    if (lote.lineas > 0) return lote;
+
+    int longitud = (int)(fin - datos);
+    lote.consumidos = (size_t)longitud;
+    lote.lineas = 1;
+    if (longitud > 0 && datos[longitud - 1] == '\r') longitud--;
+    lote.fin = (longitud == 3 && memcmp(datos, "END", 3) == 0);
+    if (longitud > 0 && !lote.fin) tramas[lote.tramas++] = clasificarTrama(datos, longitud);
+    return lote;
+}
+
+/**
+ * @brief Decodifica en su lugar una racha de cargas con una posición del rotor
+ */
+static void decodificarRacha(const RotorDeMapeo* rotor, bool estandar, char* racha, int cantidad, int posicion) {
+    if (estandar) {
+        decodificarLote(racha, racha, cantidad, posicion);
+        return;
+    }
+    for (int i = 0; i < cantidad; i++) {
+        racha[i] = rotor->getMapeoEn(racha[i], posicion);
+    }
+}
+
+/**
+ * @brief Recorre las líneas de un bloque
+ * @param bloque Bloque a recorrer
+ * @param rotor Rotor de la sesión (sólo se lee)
+ * @param salida nullptr en la fase 2: sólo se calculan la rotación neta y los
+ *        contadores del bloque. En la fase 4, destino de toda la carga: el
+ *        bloque escribe a partir de salidaInicial con posicionInicial.
+ */
+static void recorrerBloque(BloqueParalelo* bloque, const RotorDeMapeo* rotor, char* salida) {
+    TramaCompacta tramas[TRAMAS_POR_LOTE];
+    int tamanioRotor = rotor->getTamanio();
+    bool estandar = rotor->esAlfabetoEstandar();
+    int posicion = salida != nullptr ? bloque->posicionInicial : 0;
+    long long k = salida != nullptr ? bloque->salidaInicial : 0;
+    long long lineas = 0;
+    long long invalidas = 0;
+    bool fin = false;
+
+    const char* actual = bloque->inicio;
+    while (actual < bloque->fin && !fin) {
+        ResultadoLote lote = clasificarSiguientes(actual, bloque->fin, tramas);
+        actual += lote.consumidos;
+        lineas += lote.lineas;
+        fin = lote.fin;
+
+        // Las rachas se decodifican en su lugar dentro de la salida, como mucho un lote a la vez
+        long long inicioRacha = k;
+        for (int i = 0; i < lote.tramas; i++) {
+            if (tramas[i].tipo == TRAMA_LOAD) {
+                if (salida != nullptr) salida[k] = (char)tramas[i].valor;
+                k++;
+            } else if (tramas[i].tipo == TRAMA_MAP) {
+                if (salida != nullptr && k > inicioRacha) {
+                    decodificarRacha(rotor, estandar, salida + inicioRacha, (int)(k - inicioRacha), posicion);
+                }
+                inicioRacha = k;
+                posicion += normalizarRotacion(tramas[i].valor, tamanioRotor);
+                if (posicion >= tamanioRotor) posicion -= tamanioRotor;
+            } else {
+                invalidas++;
+            }
+        }
+        if (salida != nullptr && k > inicioRacha) {
+            decodificarRacha(rotor, estandar, salida + inicioRacha, (int)(k - inicioRacha), posicion);
+        }
+    }
+
+    if (salida == nullptr) {
+        bloque->rotacionNeta = posicion;
+        bloque->cargas = k;
+        bloque->lineas = lineas;
+        bloque->invalidas = invalidas;
+        bloque->terminaEnFin = fin;
+    }
+}
+
+/**
+ * @brief Decodifica toda la captura en orden, en el hilo actual
+ * @details Se usa cuando el rotor tiene una cascada encadenada: la cascada
+ *          avanza con cada carga, así que el estado al entrar a un bloque no se
+ *          obtiene con una suma de rotaciones. Con un solo hilo también, porque
+ *          recorre la captura una vez en lugar de dos.
+ */
+static long long procesarEnOrden(const char* datos, long long longitud, ListaDeCarga* carga,
+                                 RotorDeMapeo* rotor, long long* lineas) {
+    TramaCompacta tramas[TRAMAS_POR_LOTE];
+    char racha[TRAMAS_POR_LOTE];
+    CascadaDeRotores* cascada = rotor->getCascada();
+    int tamanioRotor = rotor->getTamanio();
+    long long invalidas = 0;
+    bool fin = false;
+
+    const char* actual = datos;
+    const char* finDatos = datos + longitud;
+    while (actual < finDatos && !fin) {
+        ResultadoLote lote = clasificarSiguientes(actual, finDatos, tramas);
+        actual += lote.consumidos;
+        *lineas += lote.lineas;
+        fin = lote.fin;
+
+        int enRacha = 0;
+        for (int i = 0; i < lote.tramas; i++) {
+            if (tramas[i].tipo == TRAMA_LOAD) {
+                racha[enRacha++] = (char)tramas[i].valor;
+                continue;
+            }
+            // Las cargas pendientes se decodifican con el rotor y la cascada anteriores
+            if (enRacha > 0) decodificarEInsertar(racha, enRacha, rotor, carga);
+            enRacha = 0;
+            if (tramas[i].tipo == TRAMA_MAP) {
+                if (tamanioRotor > 0) rotor->setPosicion(rotor->getPosicion() + tramas[i].valor % tamanioRotor);
+            } else if (tramas[i].tipo != TRAMA_ROTOR || cascada == nullptr ||
+                       !cascada->rotar(tramas[i].indice, tramas[i].valor)) {
+                invalidas++;
+            }
+        }
+        if (enRacha > 0) decodificarEInsertar(racha, enRacha, rotor, carga);
+    }
+    return invalidas;
+}
+
+DecodificadorParalelo::DecodificadorParalelo(int hilos) : numHilos(hilos) {
+    if (numHilos <= 0) {
+        numHilos = (int)std::thread::hardware_concurrency();
+        if (numHilos <= 0) numHilos = 1;
+    }
+}
+
+long long DecodificadorParalelo::procesar(const char* datos, long long longitud, ListaDeCarga* carga,
+                                          RotorDeMapeo* rotor, long long* lineas) {
+    *lineas = 0;
+    if (longitud <= 0) return 0;
+
+    int hilos = numHilos;
+    if (longitud / BYTES_MINIMOS_POR_HILO < hilos) hilos = (int)(longitud / BYTES_MINIMOS_POR_HILO);
+    if (hilos <= 1 || rotor->getCascada() != nullptr) return procesarEnOrden(datos, longitud, carga, rotor, lineas);
+
+    BloqueParalelo* bloques = new BloqueParalelo[hilos];
+    std::thread* trabajadores = new std::thread[hilos];
+
+    // Fase 1: cada bloque termina justo después del primer '\n' que sigue a su parte
+    const char* finDatos = datos + longitud;
+    const char* inicio = datos;
+    for (int h = 0; h < hilos; h++) {
+        const char* fin = finDatos;
+        if (h < hilos - 1) {
+            const char* corte = datos + longitud / hilos * (h + 1);
+            if (corte < inicio) corte = inicio;
+            const char* nl = (const char*)memchr(corte, '\n', (size_t)(finDatos - corte));
+            fin = nl != nullptr ? nl + 1 : finDatos;
+        }
+        bloques[h].inicio = inicio;
+        bloques[h].fin = fin;
+        inicio = fin;
+    }
+
+    // Fase 2: clasificación y reducción local de cada bloque
+    for (int h = 1; h < hilos; h++) {
+        trabajadores[h] = std::thread(recorrerBloque, &bloques[h], rotor, (char*)nullptr);
+    }
+    recorrerBloque(&bloques[0], rotor, nullptr);
+    for (int h = 1; h < hilos; h++) {
+        trabajadores[h].join();
+    }
+
+    // Fase 3: suma prefija exclusiva de rotaciones y cargas, hasta el bloque con "END"
+    int tamanioRotor = rotor->getTamanio();
+    int posicion = rotor->getPosicion();
+    long long totalCargas = 0;
+    long long totalInvalidas = 0;
+    int activos = hilos;
+    for (int h = 0; h < hilos; h++) {
+        bloques[h].posicionInicial = posicion;
+        bloques[h].salidaInicial = totalCargas;
+        posicion += bloques[h].rotacionNeta;
+        if (tamanioRotor > 0 && posicion >= tamanioRotor) posicion -= tamanioRotor;
+        totalCargas += bloques[h].cargas;
+        totalInvalidas += bloques[h].invalidas;
+        *lineas += bloques[h].lineas;
+        if (bloques[h].terminaEnFin) {
+            activos = h + 1;
+            break;
+        }
+    }
+
+    // Fase 4: decodificación independiente de cada bloque
+    char* salida = new char[totalCargas > 0 ? totalCargas : 1];
+    for (int h = 1; h < activos; h++) {
+        trabajadores[h] = std::thread(recorrerBloque, &bloques[h], rotor, salida);
+    }
+    recorrerBloque(&bloques[0], rotor, salida);
+    for (int h = 1; h < activos; h++) {
+        trabajadores[h].join();
+    }
+
+    // Fase 5: ensamblar en orden y dejar el rotor en su posición final
+    carga->insertarLote(salida, totalCargas);
+    rotor->setPosicion(posicion);
+
+    delete[] salida;
+    delete[] trabajadores;
+    delete[] bloques;
+
+    return totalInvalidas;
+}
+
+int DecodificadorParalelo::getNumHilos() const {
+    return numHilos;
+}
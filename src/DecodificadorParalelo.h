@@ -0,0 +1,74 @@
+/**
+ * @file DecodificadorParalelo.h
+ * @brief Decodificación multihilo de capturas grandes mediante suma prefija de rotaciones
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef DECODIFICADOR_PARALELO_H
+#define DECODIFICADOR_PARALELO_H
+
+class ListaDeCarga;
+class RotorDeMapeo;
+
+/**
+ * @class DecodificadorParalelo
+ * @brief Decodifica una captura de texto en memoria repartiéndola entre varios hilos
+ * @details El valor de cada TramaLoad sólo depende de la rotación acumulada de
+ *          las TramaMap anteriores (módulo el tamaño del rotor). El proceso es:
+ *          1. Los bytes se parten en un bloque por hilo; cada bloque empieza
+ *             después de un '\n', así que ninguna línea queda partida.
+ *          2. Cada hilo clasifica su bloque con clasificarLote() y calcula su
+ *             rotación neta, su número de cargas y de líneas, y si contiene "END".
+ *          3. Una suma prefija exclusiva sobre los bloques da la posición inicial
+ *             del rotor y la posición de salida de cada bloque; los bloques que
+ *             siguen a un "END" se descartan.
+ *          4. Cada hilo vuelve a clasificar su bloque y decodifica sus rachas
+ *             de cargas con el kernel por lotes en su tramo de la salida.
+ *          5. Los caracteres se agregan a la ListaDeCarga en el orden original y
+ *             el rotor queda en la misma posición que con una SesionDecodificacion.
+ *          Clasificar dos veces evita guardar una trama por línea: la memoria
+ *          extra es la de la carga decodificada. Si el rotor tiene una
+ *          CascadaDeRotores encadenada, cuyo estado depende del número de
+ *          cargas anteriores, la captura se decodifica en orden en un solo
+ *          hilo. Sin cascada, las tramas R,k,N son inválidas. Con un solo
+ *          hilo, o si la captura es pequeña, también se recorre una sola vez
+ *          en orden.
+ */
+class DecodificadorParalelo {
+private:
+    int numHilos; ///< Número de hilos a utilizar
+
+public:
+    static const long long BYTES_MINIMOS_POR_HILO = 1 << 20; ///< Por debajo no vale la pena lanzar otro hilo
+
+    /**
+     * @brief Constructor
+     * @param hilos Número de hilos (0 = usar todos los núcleos disponibles)
+     */
+    DecodificadorParalelo(int hilos = 0);
+
+    /**
+     * @brief Decodifica una captura de texto sin numerar que ya está en memoria
+     * @param datos Bytes de la captura, p. ej. los de LectorCaptura::asomarBytes() con mmap
+     * @param longitud Número de bytes
+     * @param carga Lista de carga donde almacenar los resultados
+     * @param rotor Rotor para el mapeo (se deja en su posición final)
+     * @param lineas Recibe las líneas consumidas, incluidas las vacías y la de "END"
+     * @return Número de líneas inválidas
+     * @details Aplica las mismas reglas que SesionDecodificacion con una
+     *          fuente de texto: se quitan los '\r' finales, se saltan las
+     *          líneas vacías, "END" termina la captura y la última línea puede
+     *          no tener '\n'.
+     */
+    long long procesar(const char* datos, long long longitud, ListaDeCarga* carga, RotorDeMapeo* rotor,
+                       long long* lineas);
+
+    /**
+     * @brief Obtiene el número de hilos configurado
+     * @return Número de hilos
+     */
+    int getNumHilos() const;
+};
+
+#endif // DECODIFICADOR_PARALELO_H
@@ -0,0 +1,60 @@
+/**
+ * @file FuenteDeLineas.cpp
+ * @brief Implementación de los adaptadores de FuenteDeLineas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "FuenteDeLineas.h"
+#include "SerialReader.h"
+#include "LectorCaptura.h"
+
+FuenteSerial::FuenteSerial(SerialReader* puerto) : serial(puerto) {}
+
+int FuenteSerial::leerLineaDisponible(const char** linea, int* longitud) {
+    if (!serial->estaConectado()) return FIN_DE_FUENTE;
+    if (serial->hayLineaDisponible()) {
+        return serial->leerLinea(linea, longitud) ? LINEA_OBTENIDA : FIN_DE_FUENTE;
+    }
+    return serial->seCerroElExtremo() ? FIN_DE_FUENTE : SIN_DATOS;
+}
+
+int FuenteSerial::asomarBytes(const char** datos, size_t* longitud) {
+    if (!serial->estaConectado()) return FIN_DE_FUENTE;
+    if (serial->asomarBytes(datos, longitud)) return LINEA_OBTENIDA;
+    return serial->seCerroElExtremo() ? FIN_DE_FUENTE : SIN_DATOS;
+}
+
+void FuenteSerial::consumirBytes(size_t cantidad) {
+    serial->consumirBytes(cantidad);
+}
+
+int FuenteSerial::getDescriptor() const {
+#ifdef _WIN32
+    return -1;
+#else
+    return serial->getDescriptor();
+#endif
+}
+
+FuenteCaptura::FuenteCaptura(LectorCaptura* captura) : lector(captura) {}
+
+int FuenteCaptura::leerLineaDisponible(const char** linea, int* longitud) {
+    return lector->siguienteLinea(linea, longitud) ? LINEA_OBTENIDA : FIN_DE_FUENTE;
+}
+
+int FuenteCaptura::asomarBytes(const char** datos, size_t* longitud) {
+    return lector->asomarBytes(datos, longitud) ? LINEA_OBTENIDA : FIN_DE_FUENTE;
+}
+
+void FuenteCaptura::consumirBytes(size_t cantidad) {
+    lector->consumirBytes(cantidad);
+}
+
+long long FuenteCaptura::getBytesConsumidos() const {
+    return lector->getPosicion();
+}
+
+bool FuenteCaptura::posicionarEn(long long desplazamiento) {
+    return lector->saltarA(desplazamiento);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file FuenteDeLineas.h
+ * @brief Interfaz común para los orígenes de tramas (puerto serial, capturas)
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef FUENTE_DE_LINEAS_H
+#define FUENTE_DE_LINEAS_H
+
+#include <cstddef>
+
+class SerialReader;
+class LectorCaptura;
+
+/**
+ * @class FuenteDeLineas
+ * @brief Origen de líneas de texto que se puede consultar sin bloquear
+ * @details Permite que un mismo hilo atienda varias sesiones de decodificación
+ *          intercalando lecturas de distintos orígenes.
+ */
+class FuenteDeLineas {
+public:
+    static const int LINEA_OBTENIDA = 1;  ///< Se entregó una línea
+    static const int SIN_DATOS = 0;       ///< Por ahora no hay línea completa
+    static const int FIN_DE_FUENTE = -1;  ///< La fuente terminó o se desconectó
+
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~FuenteDeLineas() {}
+
+    /**
+     * @brief Obtiene la siguiente línea si ya está disponible, sin bloquear
+     * @param linea Recibe el inicio de la línea (válido hasta la siguiente llamada)
+     * @param longitud Recibe la longitud de la línea
+     * @return LINEA_OBTENIDA, SIN_DATOS o FIN_DE_FUENTE
+     */
+    virtual int leerLineaDisponible(const char** linea, int* longitud) = 0;
+
+    /**
+     * @brief Expone los bytes pendientes sin consumirlos ni dividirlos en líneas, sin bloquear
+     * @param datos Recibe el inicio de los bytes (válido hasta la siguiente llamada)
+     * @param longitud Recibe cuántos bytes hay
+     * @return LINEA_OBTENIDA si hay bytes, SIN_DATOS o FIN_DE_FUENTE
+     * @details Se usa para detectar el formato del flujo y para leer tramas binarias.
+     */
+    virtual int asomarBytes(const char** datos, size_t* longitud) = 0;
+
+    /**
+     * @brief Descarta bytes ya procesados
+     * @param cantidad Bytes a descartar (como máximo los devueltos por asomarBytes())
+     */
+    virtual void consumirBytes(size_t cantidad) = 0;
+
+    /**
+     * @brief Descriptor para esperar datos con poll(), si la fuente lo tiene
+     * @return File descriptor, o -1 si la fuente nunca se queda sin datos
+     */
+    virtual int getDescriptor() const { return -1; }
+
+    /**
+     * @brief Bytes consumidos desde el inicio de la fuente, si la fuente se puede posicionar
+     * @return Desplazamiento, o -1 si la fuente no admite posicionarEn() (p. ej. un puerto)
+     */
+    virtual long long getBytesConsumidos() const { return -1; }
+
+    /**
+     * @brief Coloca la lectura en un desplazamiento devuelto antes por getBytesConsumidos()
+     * @param desplazamiento Bytes desde el inicio de la fuente
+     * @return true si la fuente quedó en esa posición
+     */
+    virtual bool posicionarEn(long long desplazamiento) { (void)desplazamiento; return false; }
+};
+
+/**
+ * @class FuenteSerial
+ * @brief Adapta un SerialReader a FuenteDeLineas
+ */
+class FuenteSerial : public FuenteDeLineas {
+private:
+    SerialReader* serial; ///< Puerto de origen (no se libera)
+
+public:
+    /**
+     * @brief Constructor
+     * @param puerto Puerto serial ya abierto
+     */
+    FuenteSerial(SerialReader* puerto);
+
+    virtual int leerLineaDisponible(const char** linea, int* longitud) override;
+    virtual int asomarBytes(const char** datos, size_t* longitud) override;
+    virtual void consumirBytes(size_t cantidad) override;
+    virtual int getDescriptor() const override;
+};
+
+/**
+ * @class FuenteCaptura
+ * @brief Adapta un LectorCaptura a FuenteDeLineas
+ */
+class FuenteCaptura : public FuenteDeLineas {
+private:
+    LectorCaptura* lector; ///< Captura de origen (no se libera)
+
+public:
+    /**
+     * @brief Constructor
+     * @param captura Captura ya abierta
+     */
+    FuenteCaptura(LectorCaptura* captura);
+
+    virtual int leerLineaDisponible(const char** linea, int* longitud) override;
+    virtual int asomarBytes(const char** datos, size_t* longitud) override;
+    virtual void consumirBytes(size_t cantidad) override;
+    virtual long long getBytesConsumidos() const override;
+    virtual bool posicionarEn(long long desplazamiento) override;
+};
+
+#endif // FUENTE_DE_LINEAS_H
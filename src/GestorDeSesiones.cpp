@@ -0,0 +1,101 @@
+/**
+ * @file GestorDeSesiones.cpp
+ * @brief Implementación de la clase GestorDeSesiones
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "GestorDeSesiones.h"
+#include "SesionDecodificacion.h"
+#include "FuenteDeLineas.h"
+#include <thread>
+
+#ifndef _WIN32
+    #include <poll.h>
+#endif
+
+GestorDeSesiones::GestorDeSesiones(int hilos)
+    : numHilos(hilos), detenido(false) {
+    if (numHilos <= 0) {
+        numHilos = (int)std::thread::hardware_concurrency();
+        if (numHilos <= 0) numHilos = 1;
+    }
+}
+
+void GestorDeSesiones::agregarSesion(SesionDecodificacion* sesion) {
+    sesiones.agregar(sesion);
+}
+
+void GestorDeSesiones::atenderSesiones(int indice, int hilos) {
+    int cantidad = sesiones.getCantidad();
+    int propias = 0;
+    for (int i = indice; i < cantidad; i += hilos) propias++;
+
+#ifndef _WIN32
+    struct pollfd* espera = new struct pollfd[propias > 0 ? propias : 1];
+#endif
+
+    while (!detenido.load(std::memory_order_relaxed)) {
+        bool hayActivas = false;
+        bool huboAvance = false;
+
+        for (int i = indice; i < cantidad; i += hilos) {
+            SesionDecodificacion* sesion = sesiones.obtener(i);
+            if (sesion->estaTerminada()) continue;
+            if (sesion->procesarDisponibles(LINEAS_POR_TURNO) > 0) huboAvance = true;
+            if (!sesion->estaTerminada()) hayActivas = true;
+        }
+
+        if (!hayActivas) break;
+        if (huboAvance) continue;
+
+        // Ninguna sesión tenía datos: dormir hasta que alguna fuente los tenga
+#ifndef _WIN32
+        int n = 0;
+        for (int i = indice; i < cantidad; i += hilos) {
+            if (sesiones.obtener(i)->estaTerminada()) continue;
+            int fd = sesiones.obtener(i)->getFuente()->getDescriptor();
+            if (fd < 0) continue;
+            espera[n].fd = fd;
+            espera[n].events = POLLIN;
+            espera[n].revents = 0;
+            n++;
+        }
+        if (n > 0) {
+            poll(espera, n, ESPERA_INACTIVO_MS);
+            continue;
+        }
+#endif
+        std::this_thread::yield();
+    }
+
+#ifndef _WIN32
+    delete[] espera;
+#endif
+}
+
+void GestorDeSesiones::ejecutar() {
+    int cantidad = sesiones.getCantidad();
+    if (cantidad == 0) return;
+
+    int hilos = numHilos < cantidad ? numHilos : cantidad;
+    std::thread* trabajadores = new std::thread[hilos];
+
+    for (int h = 1; h < hilos; h++) {
+        trabajadores[h] = std::thread(&GestorDeSesiones::atenderSesiones, this, h, hilos);
+    }
+    atenderSesiones(0, hilos);
+    for (int h = 1; h < hilos; h++) {
+        trabajadores[h].join();
+    }
+
+    delete[] trabajadores;
+}
+
+void GestorDeSesiones::detener() {
+    detenido.store(true);
+}
+
+int GestorDeSesiones::getNumHilos() const {
+    return numHilos;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file GestorDeSesiones.h
+ * @brief Ejecuta muchas sesiones de decodificación sobre un grupo fijo de hilos
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef GESTOR_DE_SESIONES_H
+#define GESTOR_DE_SESIONES_H
+
+#include <atomic>
+#include "ListaDeSesiones.h"
+
+/**
+ * @class GestorDeSesiones
+ * @brief Reparte sesiones independientes entre un número fijo de hilos
+ * @details Cada sesión se asigna a un único hilo (sesión i -> hilo i % hilos)
+ *          antes de arrancar, así que el camino de decodificación no usa ningún
+ *          candado: cada hilo es el único que toca el rotor y la carga de sus
+ *          sesiones. Un hilo recorre sus sesiones por turnos y, cuando ninguna
+ *          tiene datos, espera con poll() sobre los descriptores de sus fuentes.
+ */
+class GestorDeSesiones {
+private:
+    ListaDeSesiones sesiones;   ///< Sesiones registradas
+    int numHilos;               ///< Hilos del grupo
+    std::atomic<bool> detenido; ///< Solicitud de parada anticipada
+
+    /**
+     * @brief Bucle de un hilo del grupo
+     * @param indice Índice del hilo; atiende las sesiones con i % hilos == indice
+     * @param hilos Número de hilos en ejecución
+     */
+    void atenderSesiones(int indice, int hilos);
+
+public:
+    static const int LINEAS_POR_TURNO = 1024; ///< Líneas que consume una sesión antes de ceder el turno
+    static const int ESPERA_INACTIVO_MS = 10; ///< Espera máxima en poll() cuando no hay datos
+
+    /**
+     * @brief Constructor
+     * @param hilos Número de hilos (0 = usar todos los núcleos disponibles)
+     */
+    GestorDeSesiones(int hilos = 0);
+
+    /**
+     * @brief Registra una sesión; debe llamarse antes de ejecutar()
+     * @param sesion Sesión a atender
+     */
+    void agregarSesion(SesionDecodificacion* sesion);
+
+    /**
+     * @brief Atiende todas las sesiones hasta que terminen o se llame a detener()
+     */
+    void ejecutar();
+
+    /**
+     * @brief Solicita que ejecutar() regrese lo antes posible (seguro desde otro hilo)
+     */
+    void detener();
+
+    /**
+     * @brief Obtiene el número de hilos configurado
+     * @return Número de hilos
+     */
+    int getNumHilos() const;
+};
+
+#endif // GESTOR_DE_SESIONES_H
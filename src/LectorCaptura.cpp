@@ -0,0 +1,186 @@
+/**
+ * @file LectorCaptura.cpp
+ * @brief Implementación de la clase LectorCaptura
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "LectorCaptura.h"
+#include <iostream>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+LectorCaptura::LectorCaptura(const char* ruta)
+    : datos(nullptr), tamanio(0), posicion(0), base(0), mapeado(false), archivo(nullptr),
+      propietario(false), buffer(nullptr), capacidad(0), finEntrada(false), abierto(false) {
+    bool esStdin = (strcmp(ruta, "-") == 0);
+
+#ifndef _WIN32
+    if (!esStdin) {
+        int fd = open(ruta, O_RDONLY);
+        if (fd == -1) {
+            std::cerr << "Error: No se pudo abrir la captura " << ruta << std::endl;
+            return;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+            if (info.st_size == 0) {
+                close(fd);
+                abierto = true;
+                finEntrada = true;
+                return;
+            }
+            void* mapeo = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapeo != MAP_FAILED) {
+                madvise(mapeo, (size_t)info.st_size, MADV_SEQUENTIAL);
+                close(fd);
+                datos = (const char*)mapeo;
+                tamanio = (size_t)info.st_size;
+                mapeado = true;
+                finEntrada = true;
+                abierto = true;
+                return;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    // Modo por bloques: stdin, tuberías o sistemas sin mmap
+    if (esStdin) {
+        archivo = stdin;
+    } else {
+        archivo = fopen(ruta, "rb");
+        propietario = true;
+    }
+    if (archivo == nullptr) {
+        std::cerr << "Error: No se pudo abrir la captura " << ruta << std::endl;
+        return;
+    }
+
+    capacidad = TAMANIO_BLOQUE;
+    buffer = new char[capacidad];
+    datos = buffer;
+    abierto = true;
+}
+
+LectorCaptura::~LectorCaptura() {
+#ifndef _WIN32
+    if (mapeado) {
+        munmap((void*)datos, tamanio);
+    }
+#endif
+    if (archivo != nullptr && propietario) {
+        fclose(archivo);
+    }
+    delete[] buffer;
+}
+
+bool LectorCaptura::rellenar() {
+    if (finEntrada || archivo == nullptr) return false;
+
+    // Conservar la línea incompleta al inicio del buffer
+    size_t pendientes = tamanio - posicion;
+    if (pendientes > 0 && posicion > 0) {
+        memmove(buffer, buffer + posicion, pendientes);
+    }
+    base += (long long)posicion;
+    tamanio = pendientes;
+    posicion = 0;
+
+    // Una línea más larga que el buffer obliga a crecerlo
+    if (tamanio == capacidad) {
+        char* nuevo = new char[capacidad * 2];
+        memcpy(nuevo, buffer, tamanio);
+        delete[] buffer;
+        buffer = nuevo;
+        capacidad *= 2;
+    }
+
+    size_t leidos = fread(buffer + tamanio, 1, capacidad - tamanio, archivo);
+    if (leidos == 0) {
+        finEntrada = true;
+        datos = buffer;
+        return false;
+    }
+    tamanio += leidos;
+    datos = buffer;
+    return true;
+}
+
+bool LectorCaptura::siguienteLinea(const char** linea, int* longitud) {
+    if (!abierto) return false;
+
+    while (true) {
+        const char* inicio = datos + posicion;
+        size_t restantes = tamanio - posicion;
+        const char* nl = restantes > 0 ? (const char*)memchr(inicio, '\n', restantes) : nullptr;
+
+        if (nl != nullptr || (finEntrada && restantes > 0)) {
+            const char* fin = (nl != nullptr) ? nl : datos + tamanio;
+            posicion = (size_t)(fin - datos) + (nl != nullptr ? 1 : 0);
+            if (fin > inicio && fin[-1] == '\r') fin--;
+            *linea = inicio;
+            *longitud = (int)(fin - inicio);
+            return true;
+        }
+
+        if (!rellenar() && finEntrada && tamanio - posicion == 0) {
+            return false;
+        }
+    }
+}
+
+bool LectorCaptura::asomarBytes(const char** bytes, size_t* longitud) {
+    if (!abierto) return false;
+    if (posicion == tamanio && !rellenar()) return false;
+    *bytes = datos + posicion;
+    *longitud = tamanio - posicion;
+    return true;
+}
+
+void LectorCaptura::consumirBytes(size_t cantidad) {
+    posicion += cantidad;
+}
+
+long long LectorCaptura::getPosicion() const {
+    return base + (long long)posicion;
+}
+
+bool LectorCaptura::saltarA(long long desplazamiento) {
+    if (!abierto || desplazamiento < base) return false;
+
+    // Archivo regular sin mmap: saltar directamente si no pasa del final
+    if (!mapeado && desplazamiento > base + (long long)tamanio && fseek(archivo, 0, SEEK_END) == 0) {
+        long long fin = (long long)ftell(archivo);
+        if (desplazamiento > fin || fseek(archivo, (long)desplazamiento, SEEK_SET) != 0) return false;
+        base = desplazamiento;
+        tamanio = 0;
+        posicion = 0;
+        finEntrada = false;
+        return true;
+    }
+
+    // Tuberías y entrada estándar: leer y descartar hasta llegar
+    while (desplazamiento > base + (long long)tamanio) {
+        posicion = tamanio;
+        if (!rellenar()) return false;
+    }
+    posicion = (size_t)(desplazamiento - base);
+    return true;
+}
+
+bool LectorCaptura::estaAbierto() const {
+    return abierto;
+}
+
+bool LectorCaptura::estaMapeado() const {
+    return mapeado;
+}
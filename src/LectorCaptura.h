@@ -0,0 +1,109 @@
+/**
+ * @file LectorCaptura.h
+ * @brief Lectura de capturas PRT-7 (una trama por línea) desde archivo o stdin
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef LECTOR_CAPTURA_H
+#define LECTOR_CAPTURA_H
+
+#include <cstddef>
+#include <cstdio>
+
+/**
+ * @class LectorCaptura
+ * @brief Entrega las líneas de una captura sin copiarlas una por una
+ * @details Los archivos regulares se proyectan en memoria con mmap (en Linux) y
+ *          las líneas se devuelven como punteros dentro del mapeo. La entrada
+ *          estándar, las tuberías y Windows se leen en bloques grandes sobre un
+ *          buffer interno. En ambos casos se descartan los '\r' finales.
+ */
+class LectorCaptura {
+private:
+    const char* datos;  ///< Inicio de los datos disponibles (mapeo o buffer)
+    size_t tamanio;     ///< Bytes válidos en datos
+    size_t posicion;    ///< Siguiente byte a examinar en datos
+    long long base;     ///< Desplazamiento en la captura del primer byte de datos
+    bool mapeado;       ///< true si datos apunta a un mapeo de memoria
+    FILE* archivo;      ///< Flujo de lectura en modo por bloques
+    bool propietario;   ///< true si archivo debe cerrarse al destruir
+    char* buffer;       ///< Buffer interno del modo por bloques
+    size_t capacidad;   ///< Capacidad de buffer
+    bool finEntrada;    ///< Se alcanzó el fin del flujo
+    bool abierto;       ///< Estado de apertura
+
+    /**
+     * @brief Desplaza la línea incompleta al inicio del buffer y lee más datos
+     * @return false si no se pudo leer nada más
+     */
+    bool rellenar();
+
+public:
+    static const size_t TAMANIO_BLOQUE = 1 << 20; ///< Tamaño de lectura del modo por bloques
+
+    /**
+     * @brief Constructor
+     * @param ruta Ruta del archivo de captura, o "-" para la entrada estándar
+     */
+    LectorCaptura(const char* ruta);
+
+    /**
+     * @brief Destructor: libera el mapeo o el buffer y cierra el archivo
+     */
+    ~LectorCaptura();
+
+    /**
+     * @brief Obtiene la siguiente línea de la captura
+     * @param linea Recibe el inicio de la línea (no termina en '\0')
+     * @param longitud Recibe la longitud de la línea sin '\n' ni '\r'
+     * @return true si se obtuvo una línea, false al final de la captura
+     * @details El puntero es válido hasta la siguiente llamada.
+     */
+    bool siguienteLinea(const char** linea, int* longitud);
+
+    /**
+     * @brief Expone los bytes aún no leídos sin consumirlos ni dividirlos en líneas
+     * @param bytes Recibe el inicio de los bytes pendientes
+     * @param longitud Recibe cuántos bytes hay
+     * @return true si hay al menos un byte, false al final de la captura
+     * @details Con mmap se devuelve de una vez todo el resto del archivo.
+     */
+    bool asomarBytes(const char** bytes, size_t* longitud);
+
+    /**
+     * @brief Avanza la lectura sobre bytes ya procesados
+     * @param cantidad Bytes a descartar (como máximo los devueltos por asomarBytes())
+     */
+    void consumirBytes(size_t cantidad);
+
+    /**
+     * @brief Obtiene cuántos bytes de la captura se han consumido
+     * @return Desplazamiento del siguiente byte sin leer desde el inicio de la captura
+     */
+    long long getPosicion() const;
+
+    /**
+     * @brief Coloca la lectura en un desplazamiento de la captura
+     * @param desplazamiento Bytes desde el inicio de la captura
+     * @return false si la captura es más corta o no se puede avanzar hasta ahí
+     * @details Con mmap es inmediato; en archivos regulares se usa fseek. En
+     *          la entrada estándar y las tuberías sólo se puede avanzar, y se
+     *          hace leyendo y descartando los bytes intermedios.
+     */
+    bool saltarA(long long desplazamiento);
+
+    /**
+     * @brief Verifica si la captura se abrió correctamente
+     * @return true si se puede leer
+     */
+    bool estaAbierto() const;
+
+    /**
+     * @brief Indica si la captura está proyectada en memoria
+     * @return true si se usa mmap
+     */
+    bool estaMapeado() const;
+};
+
+#endif // LECTOR_CAPTURA_H
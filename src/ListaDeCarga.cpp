@@ -6,19 +6,33 @@
  */
 
 #include "ListaDeCarga.h"
+#include "SumideroCarga.h"
+#include "PuntoDeControl.h"
+#include "Registro.h"
+#include <cstring>
 #include <iostream>
 
 /**
- * @brief Constructor del nodo
- * @param c Carácter a almacenar en el nodo
+ * @brief Constructor del bloque vacío
  */
-NodoCarga::NodoCarga(char c) : dato(c), siguiente(nullptr), anterior(nullptr) {}
+BloqueCarga::BloqueCarga() : usados(0), siguiente(nullptr), anterior(nullptr) {}
 
 /**
  * @brief Constructor que inicializa una lista vacía
  */
-ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0) {
-    std::cout << "ListaDeCarga inicializada (vacía)" << std::endl;
+ListaDeCarga::ListaDeCarga()
+    : cabeza(nullptr), cola(nullptr), tamanio(0), bloques(0), sumidero(nullptr),
+      bloquesResidentes(0), retirados(0), libres(nullptr), ventana(0), inicioCabeza(0),
+      prefijo(nullptr) {
+    PRT7_RESUMEN("ListaDeCarga inicializada (vacía)\n");
+}
+
+/**
+ * @brief Constructor en modo ventana
+ * @param capacidadVentana Caracteres más recientes que se conservan
+ */
+ListaDeCarga::ListaDeCarga(int capacidadVentana) : ListaDeCarga() {
+    setVentana(capacidadVentana);
 }
 
 /**
@@ -26,18 +40,36 @@ ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0) {
  */
 ListaDeCarga::~ListaDeCarga() {
     while (cabeza != nullptr) {
-        NodoCarga* temp = cabeza;
+        BloqueCarga* temp = cabeza;
         cabeza = cabeza->siguiente;
         delete temp;
     }
+    while (libres != nullptr) {
+        BloqueCarga* temp = libres;
+        libres = libres->siguiente;
+        delete temp;
+    }
 }
 
 /**
- * @brief Inserta un carácter al final de la lista
- * @param dato Carácter a insertar
+ * @brief Agrega un bloque vacío al final de la lista
  */
-void ListaDeCarga::insertarAlFinal(char dato) {
-    NodoCarga* nuevo = new NodoCarga(dato);
+void ListaDeCarga::agregarBloque() {
+    if (sumidero != nullptr && bloques >= bloquesResidentes + BLOQUES_POR_ENVIO) {
+        enviarAntiguos(BLOQUES_POR_ENVIO);
+    }
+    
+    BloqueCarga* nuevo;
+    if (libres != nullptr) {
+        nuevo = libres;
+        libres = libres->siguiente;
+        nuevo->usados = 0;
+        nuevo->siguiente = nullptr;
+        nuevo->anterior = nullptr;
+    } else {
+        nuevo = new BloqueCarga();
+    }
+    bloques++;
     
     if (cabeza == nullptr) {
         // Lista vacía
@@ -48,46 +80,273 @@ void ListaDeCarga::insertarAlFinal(char dato) {
         nuevo->anterior = cola;
         cola = nuevo;
     }
+}
+
+/**
+ * @brief Envía al sumidero los bloques más antiguos y los guarda para reutilizarlos
+ * @param cantidad Bloques a enviar desde la cabeza
+ */
+void ListaDeCarga::enviarAntiguos(int cantidad) {
+    const char* fragmentos[BLOQUES_POR_ENVIO];
+    int longitudes[BLOQUES_POR_ENVIO];
+    if (cantidad > BLOQUES_POR_ENVIO) cantidad = BLOQUES_POR_ENVIO;
+    
+    int n = 0;
+    for (BloqueCarga* b = cabeza; b != nullptr && n < cantidad; b = b->siguiente) {
+        fragmentos[n] = b->datos;
+        longitudes[n] = b->usados;
+        n++;
+    }
+    if (n == 0) return;
+    if (!sumidero->escribir(fragmentos, longitudes, n)) {
+        // Sin destino la carga se sigue acumulando en memoria en lugar de perderse
+        std::cerr << "Error: No se pudo escribir la carga; se conserva en memoria" << std::endl;
+        sumidero = nullptr;
+        return;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        BloqueCarga* enviado = cabeza;
+        cabeza = cabeza->siguiente;
+        if (cabeza != nullptr) cabeza->anterior = nullptr; else cola = nullptr;
+        tamanio -= enviado->usados;
+        retirados += enviado->usados;
+        bloques--;
+        enviado->siguiente = libres;
+        libres = enviado;
+    }
+}
+
+/**
+ * @brief Activa el modo de flujo
+ * @param destino Sumidero que recibe la carga antigua
+ * @param colaResidente Caracteres recientes que se conservan en la lista
+ */
+void ListaDeCarga::setSumidero(SumideroCarga* destino, int colaResidente) {
+    sumidero = destino;
+    int residentes = (colaResidente + BloqueCarga::CAPACIDAD - 1) / BloqueCarga::CAPACIDAD;
+    bloquesResidentes = residentes > 0 ? residentes : 1;
+}
+
+/**
+ * @brief Activa el modo ventana
+ * @param capacidadVentana Caracteres que se conservan
+ */
+void ListaDeCarga::setVentana(int capacidadVentana) {
+    if (capacidadVentana < 1) capacidadVentana = 1;
+    ventana = capacidadVentana;
+    
+    // Con la cola llena y al menos un carácter visible en la cabeza, la ventana
+    // ocupa como máximo ceil(N / CAPACIDAD) bloques: uno más basta para el anillo
+    int necesarios = (ventana + BloqueCarga::CAPACIDAD - 1) / BloqueCarga::CAPACIDAD + 1;
+    int disponibles = bloques;
+    for (BloqueCarga* b = libres; b != nullptr; b = b->siguiente) disponibles++;
+    for (; disponibles < necesarios; disponibles++) {
+        BloqueCarga* nuevo = new BloqueCarga();
+        nuevo->siguiente = libres;
+        libres = nuevo;
+    }
+    if (tamanio > ventana) recortarVentana();
+}
+
+/**
+ * @brief Continúa la lista después de una carga guardada en un punto de control
+ * @param origen Punto de control con la carga anterior
+ * @param cantidad Caracteres guardados en origen
+ */
+void ListaDeCarga::reanudarDesde(PuntoDeControl* origen, long long cantidad) {
+    prefijo = origen;
+    retirados += cantidad;
+}
+
+/**
+ * @brief Descarta los caracteres más antiguos que exceden la ventana
+ */
+void ListaDeCarga::recortarVentana() {
+    long long sobrantes = tamanio - ventana;
+    tamanio = ventana;
+    retirados += sobrantes;
+    // Al activar la ventana sobre una lista grande pueden sobrar más de INT_MAX caracteres
+    long long inicio = inicioCabeza + sobrantes;
+    
+    while (inicio >= cabeza->usados && cabeza != cola) {
+        BloqueCarga* viejo = cabeza;
+        inicio -= viejo->usados;
+        cabeza = cabeza->siguiente;
+        cabeza->anterior = nullptr;
+        bloques--;
+        viejo->siguiente = libres;
+        libres = viejo;
+    }
+    inicioCabeza = (int)inicio;
+}
+
+/**
+ * @brief Envía al sumidero toda la carga residente y lo vacía
+ * @return false si no hay sumidero o falló la escritura
+ */
+bool ListaDeCarga::volcar() {
+    if (sumidero == nullptr) return false;
+    while (cabeza != nullptr) {
+        enviarAntiguos(BLOQUES_POR_ENVIO);
+        if (sumidero == nullptr) return false;
+    }
+    return sumidero->vaciar();
+}
+
+/**
+ * @brief Inserta un carácter al final de la lista
+ * @param dato Carácter a insertar
+ */
+void ListaDeCarga::insertarAlFinal(char dato) {
+    if (cola == nullptr || cola->usados == BloqueCarga::CAPACIDAD) {
+        agregarBloque();
+    }
+    cola->datos[cola->usados++] = dato;
     tamanio++;
+    if (ventana > 0 && tamanio > ventana) recortarVentana();
+}
+
+/**
+ * @brief Inserta un bloque de caracteres al final de la lista, en orden
+ * @param datos Caracteres a insertar
+ * @param cantidad Número de caracteres
+ */
+void ListaDeCarga::insertarLote(const char* datos, long long cantidad) {
+    if (ventana > 0 && cantidad > ventana) {
+        // Lo que no cabe en la ventana ni siquiera se copia
+        long long omitidos = cantidad - ventana;
+        retirados += omitidos;
+        datos += omitidos;
+        cantidad = ventana;
+    }
+    while (cantidad > 0) {
+        if (cola == nullptr || cola->usados == BloqueCarga::CAPACIDAD) {
+            agregarBloque();
+        }
+        int libres = BloqueCarga::CAPACIDAD - cola->usados;
+        int n = cantidad < libres ? (int)cantidad : libres;
+        memcpy(cola->datos + cola->usados, datos, n);
+        cola->usados += n;
+        tamanio += n;
+        datos += n;
+        cantidad -= n;
+        if (ventana > 0 && tamanio > ventana) recortarVentana();
+    }
 }
 
 /**
  * @brief Imprime el mensaje completo
  */
 void ListaDeCarga::imprimirMensaje() {
-    std::cout << "\n=== MENSAJE OCULTO ENSAMBLADO ===" << std::endl;
-    if (cabeza == nullptr) {
-        std::cout << "(mensaje vacío)" << std::endl;
+    if (sumidero != nullptr) {
+        // El sumidero puede ser stdout: primero lo que ya está en el registro
+        Registro::vaciar();
+        volcar();
         return;
     }
+    std::ostream& salida = Registro::salida();
+    salida << "\n=== MENSAJE OCULTO ENSAMBLADO ===\n";
+    if (ventana > 0 && retirados > 0) {
+        salida << "(últimos " << tamanio << " de " << getTotal() << " caracteres)\n";
+    }
+    if (getTotal() == 0) {
+        salida << "(mensaje vacío)\n";
+        Registro::vaciar();
+        return;
+    }
+    if (prefijo != nullptr && !prefijo->imprimirCarga(salida, retirados)) {
+        std::cerr << "Error: No se pudo leer la carga del punto de control" << std::endl;
+    }
     
-    NodoCarga* actual = cabeza;
+    BloqueCarga* actual = cabeza;
+    int offset = inicioCabeza;
     while (actual != nullptr) {
-        std::cout << actual->dato;
+        salida.write(actual->datos + offset, actual->usados - offset);
+        offset = 0;
         actual = actual->siguiente;
     }
-    std::cout << std::endl;
-    std::cout << "=== FIN DEL MENSAJE ===" << std::endl;
+    salida << "\n=== FIN DEL MENSAJE ===\n";
+    Registro::vaciar();
+}
+
+/**
+ * @brief Copia el contenido de la lista a un buffer
+ * @param destino Buffer de destino
+ * @param capacidad Bytes disponibles en destino
+ * @return Número de caracteres copiados
+ */
+long long ListaDeCarga::copiarContenido(char* destino, long long capacidad) const {
+    return copiarDesde(0, destino, capacidad);
+}
+
+/**
+ * @brief Copia a un buffer los caracteres a partir de una posición
+ * @param desde Índice del primer carácter a copiar
+ * @param destino Buffer de destino
+ * @param capacidad Bytes disponibles en destino
+ * @return Número de caracteres copiados
+ */
+long long ListaDeCarga::copiarDesde(long long desde, char* destino, long long capacidad) const {
+    if (desde < 0) desde = 0;
+    if (desde >= tamanio) return 0;
+    
+    // Retroceder desde la cola hasta el bloque que contiene 'desde', contando
+    // en posiciones de bloque (la cabeza puede tener caracteres fuera de la ventana)
+    desde += inicioCabeza;
+    BloqueCarga* actual = cola;
+    long long inicioBloque = tamanio + inicioCabeza - cola->usados;
+    while (inicioBloque > desde) {
+        actual = actual->anterior;
+        inicioBloque -= actual->usados;
+    }
+    
+    long long copiados = 0;
+    int offset = (int)(desde - inicioBloque);
+    while (actual != nullptr && copiados < capacidad) {
+        int disponibles = actual->usados - offset;
+        int n = disponibles < capacidad - copiados ? disponibles : (int)(capacidad - copiados);
+        memcpy(destino + copiados, actual->datos + offset, (size_t)n);
+        copiados += n;
+        offset = 0;
+        actual = actual->siguiente;
+    }
+    return copiados;
 }
 
 /**
  * @brief Imprime el estado actual de la lista (para debugging)
  */
 void ListaDeCarga::imprimirEstado() {
-    std::cout << "Lista de carga (tamaño=" << tamanio << "): [";
-    NodoCarga* actual = cabeza;
+    std::ostream& salida = Registro::salida();
+    salida << "Lista de carga (tamaño=" << tamanio << "): [";
+    bool primero = true;
+    BloqueCarga* actual = cabeza;
+    int offset = inicioCabeza;
     while (actual != nullptr) {
-        std::cout << actual->dato;
-        if (actual->siguiente != nullptr) std::cout << "][";
+        for (int i = offset; i < actual->usados; i++) {
+            if (!primero) salida << "][";
+            salida << actual->datos[i];
+            primero = false;
+        }
+        offset = 0;
         actual = actual->siguiente;
     }
-    std::cout << "]" << std::endl;
+    salida << "]\n";
 }
 
 /**
  * @brief Obtiene el tamaño de la lista
  * @return Número de elementos en la lista
  */
-int ListaDeCarga::getTamanio() const {
+long long ListaDeCarga::getTamanio() const {
     return tamanio;
+}
+
+/**
+ * @brief Obtiene el total de caracteres recibidos, incluidos los que ya no están en la lista
+ * @return Caracteres insertados desde el inicio
+ */
+long long ListaDeCarga::getTotal() const {
+    return retirados + tamanio;
 }
\ No newline at end of file
@@ -8,34 +8,83 @@
 #ifndef LISTA_DE_CARGA_H
 #define LISTA_DE_CARGA_H
 
+class SumideroCarga;
+class PuntoDeControl;
+
 /**
- * @brief Nodo para la lista doblemente enlazada de carga
+ * @brief Bloque de la lista doblemente enlazada de carga (lista desenrollada)
+ * @details Cada bloque guarda hasta CAPACIDAD caracteres contiguos, de modo que
+ *          no se reserva un nodo por carácter y el recorrido aprovecha la caché.
  */
-struct NodoCarga {
-    char dato;
-    NodoCarga* siguiente;
-    NodoCarga* anterior;
+struct BloqueCarga {
+    static const int CAPACIDAD = 4096; ///< Caracteres por bloque
+    
+    char datos[CAPACIDAD];
+    int usados;
+    BloqueCarga* siguiente;
+    BloqueCarga* anterior;
     
-    NodoCarga(char c);
+    BloqueCarga();
 };
 
 /**
  * @class ListaDeCarga
  * @brief Lista doblemente enlazada para almacenar los datos decodificados
- * @details Almacena los caracteres decodificados en el orden correcto para formar el mensaje final
+ * @details Almacena los caracteres decodificados en el orden correcto para formar el mensaje final.
+ *          Está implementada como lista desenrollada: una lista doblemente enlazada
+ *          de bloques de caracteres. En modo de flujo (setSumidero()) sólo conserva
+ *          los últimos bloques: los más antiguos se envían al sumidero en lotes y
+ *          se reutilizan, así que la memoria no crece con la longitud del flujo.
+ *          En modo ventana (setVentana()) conserva exactamente los últimos N
+ *          caracteres: los bloques forman un anillo reservado de antemano y el
+ *          más antiguo se sobrescribe, sin reservar memoria al insertar.
  */
 class ListaDeCarga {
 private:
-    NodoCarga* cabeza;  ///< Puntero al primer nodo
-    NodoCarga* cola;    ///< Puntero al último nodo
-    int tamanio;        ///< Número de elementos en la lista
+    BloqueCarga* cabeza;  ///< Puntero al primer bloque
+    BloqueCarga* cola;    ///< Puntero al último bloque
+    long long tamanio;    ///< Número de caracteres en la lista
+    int bloques;          ///< Número de bloques en la lista
+    SumideroCarga* sumidero; ///< Destino de los bloques antiguos en modo de flujo (no se libera)
+    int bloquesResidentes;   ///< Bloques que se conservan en modo de flujo
+    long long retirados;     ///< Caracteres que ya no están en la lista (enviados o fuera de la ventana)
+    BloqueCarga* libres;     ///< Bloques retirados, listos para reutilizarse
+    int ventana;             ///< Caracteres que conserva el modo ventana (0 = sin límite)
+    int inicioCabeza;        ///< Caracteres del bloque cabeza que ya quedaron fuera de la ventana
+    PuntoDeControl* prefijo; ///< Guarda los caracteres anteriores a la lista al reanudar (no se libera), o nullptr
+    
+    /**
+     * @brief Agrega un bloque vacío al final de la lista
+     * @details En modo de flujo envía antes los bloques que excedan la cola residente.
+     */
+    void agregarBloque();
+    
+    /**
+     * @brief Envía al sumidero los bloques más antiguos y los guarda para reutilizarlos
+     * @param cantidad Bloques a enviar desde la cabeza
+     */
+    void enviarAntiguos(int cantidad);
+    
+    /**
+     * @brief Descarta los caracteres más antiguos que exceden la ventana
+     * @details Los bloques que quedan completamente fuera vuelven a la lista de libres.
+     */
+    void recortarVentana();
     
 public:
+    static const int BLOQUES_POR_ENVIO = 16; ///< Bloques por escritura al sumidero (64 KB)
+    
     /**
      * @brief Constructor que inicializa una lista vacía
      */
     ListaDeCarga();
     
+    /**
+     * @brief Constructor en modo ventana
+     * @param capacidadVentana Caracteres más recientes que se conservan
+     */
+    explicit ListaDeCarga(int capacidadVentana);
+    
     /**
      * @brief Destructor que libera toda la memoria
      */
@@ -47,21 +96,99 @@ public:
      */
     void insertarAlFinal(char dato);
     
+    /**
+     * @brief Inserta un bloque de caracteres al final de la lista, en orden
+     * @param datos Caracteres a insertar
+     * @param cantidad Número de caracteres
+     */
+    void insertarLote(const char* datos, long long cantidad);
+    
+    /**
+     * @brief Activa el modo de flujo
+     * @param destino Sumidero que recibe la carga antigua (no se libera)
+     * @param colaResidente Caracteres recientes que se conservan en la lista
+     * @details Los caracteres que ya estén en la lista se envían cuando toque,
+     *          como el resto. copiarContenido(), copiarDesde() e imprimirEstado()
+     *          sólo ven la parte residente.
+     */
+    void setSumidero(SumideroCarga* destino, int colaResidente);
+    
+    /**
+     * @brief Activa el modo ventana: sólo se conservan los últimos caracteres
+     * @param capacidadVentana Caracteres que se conservan (mayor que 0)
+     * @details Reserva aquí todos los bloques del anillo, así que las
+     *          inserciones posteriores no reservan memoria. getTamanio(),
+     *          imprimirMensaje(), imprimirEstado(), copiarContenido() y
+     *          copiarDesde() se refieren a la ventana; getTotal() cuenta todo lo
+     *          insertado. No se combina con setSumidero().
+     */
+    void setVentana(int capacidadVentana);
+    
+    /**
+     * @brief Continúa la lista después de una carga guardada en un punto de control
+     * @param origen Punto de control con la carga anterior (no se libera)
+     * @param cantidad Caracteres guardados en origen
+     * @details Se llama con la lista vacía. Los caracteres guardados no se
+     *          copian a memoria: getTotal() los cuenta e imprimirMensaje() los
+     *          lee del archivo antes de los de la lista, así que reanudar no
+     *          depende del tamaño de la carga. getTamanio(), copiarContenido()
+     *          y copiarDesde() sólo ven lo insertado después. No se combina con
+     *          setSumidero() ni con setVentana().
+     */
+    void reanudarDesde(PuntoDeControl* origen, long long cantidad);
+    
+    /**
+     * @brief Envía al sumidero toda la carga residente y lo vacía
+     * @return false si no hay sumidero o falló la escritura
+     */
+    bool volcar();
+    
     /**
      * @brief Imprime el mensaje completo
+     * @details En modo de flujo envía al sumidero lo que quede, sin imprimir.
+     *          En modo ventana imprime la ventana e indica cuántos caracteres
+     *          se recibieron en total. Tras reanudarDesde() imprime primero la
+     *          carga guardada en el punto de control.
      */
     void imprimirMensaje();
     
     /**
      * @brief Imprime el estado actual de la lista (para debugging)
+     * @details Recorre toda la lista (O(n)); no debe llamarse por cada trama.
      */
     void imprimirEstado();
     
+    /**
+     * @brief Copia el contenido de la lista a un buffer
+     * @param destino Buffer de destino (no se termina en '\0')
+     * @param capacidad Bytes disponibles en destino
+     * @return Número de caracteres copiados
+     */
+    long long copiarContenido(char* destino, long long capacidad) const;
+    
+    /**
+     * @brief Copia a un buffer los caracteres a partir de una posición
+     * @param desde Índice del primer carácter a copiar
+     * @param destino Buffer de destino (no se termina en '\0')
+     * @param capacidad Bytes disponibles en destino
+     * @return Número de caracteres copiados
+     * @details Busca el bloque inicial desde la cola, así que copiar lo
+     *          agregado recientemente no recorre la lista completa.
+     */
+    long long copiarDesde(long long desde, char* destino, long long capacidad) const;
+    
     /**
      * @brief Obtiene el tamaño de la lista
-     * @return Número de elementos en la lista
+     * @return Número de elementos en la lista (en modo de flujo, sólo los residentes;
+     *         en modo ventana, como máximo la capacidad de la ventana)
+     */
+    long long getTamanio() const;
+    
+    /**
+     * @brief Obtiene el total de caracteres recibidos, incluidos los que ya no están en la lista
+     * @return Caracteres insertados desde el inicio
      */
-    int getTamanio() const;
+    long long getTotal() const;
 };
 
 #endif // LISTA_DE_CARGA_H
\ No newline at end of file
@@ -0,0 +1,37 @@
+/**
+ * @file ListaDeSesiones.cpp
+ * @brief Implementación de la clase ListaDeSesiones
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "ListaDeSesiones.h"
+
+ListaDeSesiones::ListaDeSesiones()
+    : sesiones(nullptr), cantidad(0), capacidad(0) {}
+
+ListaDeSesiones::~ListaDeSesiones() {
+    delete[] sesiones;
+}
+
+void ListaDeSesiones::agregar(SesionDecodificacion* sesion) {
+    if (cantidad == capacidad) {
+        int nuevaCapacidad = capacidad == 0 ? 8 : capacidad * 2;
+        SesionDecodificacion** nuevo = new SesionDecodificacion*[nuevaCapacidad];
+        for (int i = 0; i < cantidad; i++) {
+            nuevo[i] = sesiones[i];
+        }
+        delete[] sesiones;
+        sesiones = nuevo;
+        capacidad = nuevaCapacidad;
+    }
+    sesiones[cantidad++] = sesion;
+}
+
+SesionDecodificacion* ListaDeSesiones::obtener(int indice) const {
+    return sesiones[indice];
+}
+
+int ListaDeSesiones::getCantidad() const {
+    return cantidad;
+}
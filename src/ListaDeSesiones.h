@@ -0,0 +1,58 @@
+/**
+ * @file ListaDeSesiones.h
+ * @brief Arreglo creciente de las sesiones que atiende un planificador
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef LISTA_DE_SESIONES_H
+#define LISTA_DE_SESIONES_H
+
+class SesionDecodificacion;
+
+/**
+ * @class ListaDeSesiones
+ * @brief Sesiones registradas en GestorDeSesiones o en BucleEventos
+ * @details Las sesiones se agregan antes de ejecutar y después sólo se leen por
+ *          índice, así que basta un arreglo que duplica su capacidad al llenarse.
+ *          La lista no es dueña de las sesiones: al destruirse sólo libera el
+ *          arreglo.
+ */
+class ListaDeSesiones {
+private:
+    SesionDecodificacion** sesiones; ///< Sesiones registradas (no se liberan)
+    int cantidad;                    ///< Número de sesiones registradas
+    int capacidad;                   ///< Capacidad del arreglo de sesiones
+
+public:
+    /**
+     * @brief Constructor: lista vacía, sin reservar memoria
+     */
+    ListaDeSesiones();
+
+    /**
+     * @brief Destructor: libera el arreglo interno (no las sesiones)
+     */
+    ~ListaDeSesiones();
+
+    /**
+     * @brief Agrega una sesión al final
+     * @param sesion Sesión a registrar
+     */
+    void agregar(SesionDecodificacion* sesion);
+
+    /**
+     * @brief Obtiene una sesión por su índice de registro
+     * @param indice Índice en [0, getCantidad())
+     * @return Sesión registrada en esa posición
+     */
+    SesionDecodificacion* obtener(int indice) const;
+
+    /**
+     * @brief Obtiene el número de sesiones registradas
+     * @return Número de sesiones
+     */
+    int getCantidad() const;
+};
+
+#endif // LISTA_DE_SESIONES_H
@@ -0,0 +1,334 @@
+/**
+ * @file Metricas.cpp
+ * @brief Implementación de los histogramas y contadores de Metricas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "Metricas.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+static const int BITS_SUBCUBETA = 4;                                   ///< 16 sub-cubetas por potencia de dos
+static const int SUBCUBETAS = 1 << BITS_SUBCUBETA;
+static const int NUM_CUBETAS = (64 - BITS_SUBCUBETA + 1) * SUBCUBETAS; ///< Cubre todo el rango de 64 bits
+static const int NUM_TIPOS_TRAMA = 4;                                  ///< TRAMA_INVALIDA, TRAMA_LOAD, TRAMA_MAP, TRAMA_ROTOR
+
+/**
+ * @brief Suma sobre un contador que sólo escribe su propio hilo
+ * @details Basta con load + store relajados: no hay otro escritor y los
+ *          lectores sólo necesitan un valor reciente, no uno exacto.
+ */
+static inline void sumar(std::atomic<long long>& contador, long long cantidad) {
+    contador.store(contador.load(std::memory_order_relaxed) + cantidad, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Histograma logarítmico-lineal de latencias en nanosegundos
+ */
+struct HistogramaLatencia {
+    std::atomic<long long> cuentas[NUM_CUBETAS]; ///< Muestras por cubeta
+    std::atomic<long long> suma;                 ///< Suma de las muestras
+    std::atomic<long long> maximo;               ///< Mayor muestra
+
+    HistogramaLatencia() {
+        for (int i = 0; i < NUM_CUBETAS; i++) cuentas[i].store(0);
+        suma.store(0);
+        maximo.store(0);
+    }
+};
+
+/**
+ * @brief Contadores de un hilo
+ */
+struct BloqueMetricas {
+    HistogramaLatencia etapas[Metricas::NUM_ETAPAS];     ///< Un histograma por etapa
+    std::atomic<long long> tramas[NUM_TIPOS_TRAMA];      ///< Tramas por tipo
+    std::atomic<long long> errores[NUM_ERRORES_TRAMA];   ///< Inválidas por motivo
+    BloqueMetricas* siguiente;                           ///< Siguiente bloque registrado
+
+    BloqueMetricas() : siguiente(nullptr) {
+        for (int i = 0; i < NUM_TIPOS_TRAMA; i++) tramas[i].store(0);
+        for (int i = 0; i < NUM_ERRORES_TRAMA; i++) errores[i].store(0);
+    }
+};
+
+static std::mutex candadoBloques;                ///< Protege la lista de bloques y el estado del resumen
+static BloqueMetricas* primerBloque = nullptr;   ///< Bloques de todos los hilos
+static thread_local BloqueMetricas* bloqueHilo = nullptr;
+PRT7_POR_HILO unsigned int Metricas::contadorMuestreo[Metricas::NUM_ETAPAS];
+
+static const long long inicioProgramaNs = Metricas::ahoraNs();
+static long long ultimoResumenNs = 0;   ///< Instante del resumen anterior
+static long long ultimoResumenTramas = 0; ///< Tramas contadas en el resumen anterior
+
+static std::thread reportero;
+static std::mutex candadoReportero;
+static std::condition_variable despertarReportero;
+static bool detenerReportero = false;
+static volatile std::sig_atomic_t senalRecibida = 0;
+
+/**
+ * @brief Obtiene (o registra) el bloque del hilo actual
+ */
+static BloqueMetricas* bloqueActual() {
+    if (bloqueHilo == nullptr) {
+        BloqueMetricas* bloque = new BloqueMetricas();
+        std::lock_guard<std::mutex> guardia(candadoBloques);
+        bloque->siguiente = primerBloque;
+        primerBloque = bloque;
+        bloqueHilo = bloque;
+    }
+    return bloqueHilo;
+}
+
+/**
+ * @brief Cubeta que corresponde a un valor
+ */
+static int indiceCubeta(unsigned long long valor) {
+    if (valor < (unsigned long long)SUBCUBETAS) return (int)valor;
+#if defined(__GNUC__)
+    int exponente = 63 - __builtin_clzll(valor);
+#else
+    int exponente = 0;
+    while ((valor >> exponente) > 1) exponente++;
+#endif
+    return (exponente - BITS_SUBCUBETA + 1) * SUBCUBETAS
+           + (int)((valor >> (exponente - BITS_SUBCUBETA)) & (SUBCUBETAS - 1));
+}
+
+/**
+ * @brief Menor valor que cae en una cubeta
+ */
+static unsigned long long limiteCubeta(int indice) {
+    if (indice < SUBCUBETAS) return (unsigned long long)indice;
+    int exponente = indice / SUBCUBETAS + BITS_SUBCUBETA - 1;
+    unsigned long long subcubeta = (unsigned long long)(indice % SUBCUBETAS);
+    return (SUBCUBETAS + subcubeta) << (exponente - BITS_SUBCUBETA);
+}
+
+/**
+ * @brief Valor del percentil p (0-1) de un histograma combinado
+ */
+static long long percentil(const long long* cuentas, long long total, double p) {
+    long long rango = (long long)(p * (double)total + 0.5);
+    if (rango < 1) rango = 1;
+    long long acumulado = 0;
+    for (int i = 0; i < NUM_CUBETAS; i++) {
+        acumulado += cuentas[i];
+        if (acumulado >= rango) {
+            // Mayor valor equivalente de la cubeta
+            return i + 1 < NUM_CUBETAS ? (long long)limiteCubeta(i + 1) - 1 : (long long)limiteCubeta(i);
+        }
+    }
+    return 0;
+}
+
+long long Metricas::ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Metricas::registrarLatencia(Etapa etapa, long long nanosegundos) {
+    if (nanosegundos < 0) nanosegundos = 0;
+    HistogramaLatencia& h = bloqueActual()->etapas[etapa];
+    sumar(h.cuentas[indiceCubeta((unsigned long long)nanosegundos)], 1);
+    sumar(h.suma, nanosegundos);
+    if (nanosegundos > h.maximo.load(std::memory_order_relaxed)) {
+        h.maximo.store(nanosegundos, std::memory_order_relaxed);
+    }
+}
+
+void Metricas::contarTramas(TipoTrama tipo, long long cantidad) {
+    sumar(bloqueActual()->tramas[tipo], cantidad);
+}
+
+void Metricas::contarError(ErrorTrama error) {
+    sumar(bloqueActual()->errores[error], 1);
+}
+
+const char* Metricas::getNombreError(ErrorTrama error) {
+    static const char* nombres[NUM_ERRORES_TRAMA] = {
+        "ninguno", "linea_corta", "sin_coma", "load_longitud", "tipo_desconocido", "binario_invalido",
+        "rotor_formato", "rotor_inexistente", "numero_invalido", "numero_desbordado",
+        "secuencia_formato", "linea_larga"
+    };
+    return (error >= 0 && error < NUM_ERRORES_TRAMA) ? nombres[error] : "?";
+}
+
+void Metricas::imprimir(std::ostream& salida) {
+    static const char* nombresEtapa[NUM_ETAPAS] = {
+        "lectura", "parseo", "construccion", "rotor", "carga"
+    };
+
+    std::lock_guard<std::mutex> guardia(candadoBloques);
+
+    long long tramas[NUM_TIPOS_TRAMA] = { 0, 0, 0, 0 };
+    long long errores[NUM_ERRORES_TRAMA] = { 0 };
+    for (BloqueMetricas* b = primerBloque; b != nullptr; b = b->siguiente) {
+        for (int i = 0; i < NUM_TIPOS_TRAMA; i++) tramas[i] += b->tramas[i].load(std::memory_order_relaxed);
+        for (int i = 0; i < NUM_ERRORES_TRAMA; i++) errores[i] += b->errores[i].load(std::memory_order_relaxed);
+    }
+
+    long long ahora = ahoraNs();
+    long long desde = ultimoResumenNs != 0 ? ultimoResumenNs : inicioProgramaNs;
+    long long total = tramas[TRAMA_LOAD] + tramas[TRAMA_MAP] + tramas[TRAMA_ROTOR];
+    double segundos = (ahora - desde) / 1e9;
+    double porSegundo = segundos > 0 ? (total - ultimoResumenTramas) / segundos : 0.0;
+    ultimoResumenNs = ahora;
+    ultimoResumenTramas = total;
+
+    long long invalidas = 0;
+    for (int i = 1; i < NUM_ERRORES_TRAMA; i++) invalidas += errores[i];
+
+    salida << "\n=== Métricas PRT-7 (" << (ahora - inicioProgramaNs) / 1000000 << " ms) ===\n";
+    salida << "Tramas: " << total << " (LOAD " << tramas[TRAMA_LOAD] << ", MAP " << tramas[TRAMA_MAP];
+    if (tramas[TRAMA_ROTOR] > 0) salida << ", ROTOR " << tramas[TRAMA_ROTOR];
+    salida << "), " << (long long)porSegundo << " tramas/s desde el resumen anterior\n";
+    salida << "Inválidas: " << invalidas;
+    if (invalidas > 0) {
+        salida << " (";
+        bool primero = true;
+        for (int i = 1; i < NUM_ERRORES_TRAMA; i++) {
+            if (errores[i] == 0) continue;
+            salida << (primero ? "" : ", ") << getNombreError((ErrorTrama)i) << " " << errores[i];
+            primero = false;
+        }
+        salida << ")";
+    }
+    salida << "\n";
+
+    salida << "Latencia por etapa en ns (1 de cada " << PERIODO_MUESTREO << " mediciones):\n";
+    long long* cuentas = new long long[NUM_CUBETAS];
+    for (int e = 0; e < NUM_ETAPAS; e++) {
+        long long muestras = 0;
+        long long suma = 0;
+        long long maximo = 0;
+        for (int i = 0; i < NUM_CUBETAS; i++) cuentas[i] = 0;
+        for (BloqueMetricas* b = primerBloque; b != nullptr; b = b->siguiente) {
+            const HistogramaLatencia& h = b->etapas[e];
+            for (int i = 0; i < NUM_CUBETAS; i++) {
+                long long c = h.cuentas[i].load(std::memory_order_relaxed);
+                cuentas[i] += c;
+                muestras += c;
+            }
+            suma += h.suma.load(std::memory_order_relaxed);
+            long long m = h.maximo.load(std::memory_order_relaxed);
+            if (m > maximo) maximo = m;
+        }
+        if (muestras == 0) continue;
+
+        salida << "  " << nombresEtapa[e] << ": muestras=" << muestras
+               << " media=" << suma / muestras
+               << " p50=" << percentil(cuentas, muestras, 0.50)
+               << " p90=" << percentil(cuentas, muestras, 0.90)
+               << " p99=" << percentil(cuentas, muestras, 0.99)
+               << " p99.9=" << percentil(cuentas, muestras, 0.999)
+               << " max=" << maximo << "\n";
+    }
+    delete[] cuentas;
+}
+
+/**
+ * @class BufferResumen
+ * @brief streambuf sobre un arreglo fijo que escribe a stderr al vaciarse
+ * @details Un resumen completo cabe en el arreglo, así que llega a stderr en
+ *          un solo fwrite y no se intercala con la salida de otros hilos.
+ */
+class BufferResumen : public std::streambuf {
+private:
+    static const int CAPACIDAD = 1 << 14; ///< Tamaño del arreglo (16 KB)
+    char datos[CAPACIDAD];
+
+protected:
+    virtual int_type overflow(int_type c) override {
+        vaciar();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+public:
+    BufferResumen() {
+        setp(datos, datos + CAPACIDAD);
+    }
+
+    /**
+     * @brief Escribe a stderr el contenido acumulado
+     */
+    void vaciar() {
+        std::ptrdiff_t n = pptr() - pbase();
+        if (n > 0) {
+            fwrite(pbase(), 1, (size_t)n, stderr);
+        }
+        setp(datos, datos + CAPACIDAD);
+    }
+};
+
+void Metricas::imprimirEnError() {
+    BufferResumen buffer;
+    std::ostream texto(&buffer);
+    imprimir(texto);
+    buffer.vaciar();
+    fflush(stderr);
+}
+
+#ifndef _WIN32
+/**
+ * @brief Manejador de SIGUSR1: sólo marca la solicitud
+ */
+static void manejarSenal(int) {
+    senalRecibida = 1;
+}
+#endif
+
+/**
+ * @brief Hilo de resúmenes: revisa la señal cada 100 ms
+ */
+static void atenderReportes(int periodoMs) {
+    long long proximo = Metricas::ahoraNs() + (long long)periodoMs * 1000000LL;
+    std::unique_lock<std::mutex> candado(candadoReportero);
+    while (!detenerReportero) {
+        despertarReportero.wait_for(candado, std::chrono::milliseconds(100));
+        if (detenerReportero) break;
+
+        bool toca = false;
+        if (senalRecibida) {
+            senalRecibida = 0;
+            toca = true;
+        }
+        if (periodoMs > 0 && Metricas::ahoraNs() >= proximo) {
+            proximo += (long long)periodoMs * 1000000LL;
+            toca = true;
+        }
+        if (toca) Metricas::imprimirEnError();
+    }
+}
+
+void Metricas::iniciarReportes(int periodoMs) {
+    if (reportero.joinable()) return;
+#ifndef _WIN32
+    signal(SIGUSR1, manejarSenal);
+#endif
+    detenerReportero = false;
+    reportero = std::thread(atenderReportes, periodoMs);
+}
+
+void Metricas::detenerReportes() {
+    if (!reportero.joinable()) return;
+    {
+        std::lock_guard<std::mutex> guardia(candadoReportero);
+        detenerReportero = true;
+    }
+    despertarReportero.notify_one();
+    reportero.join();
+}
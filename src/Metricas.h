@@ -0,0 +1,169 @@
+/**
+ * @file Metricas.h
+ * @brief Histogramas de latencia por etapa y contadores de tramas y errores
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <ostream>
+#include "TramaCompacta.h"
+
+/**
+ * @brief Activa la instrumentación del camino crítico
+ * @details Se puede fijar desde CMake con -DPRT7_METRICAS=ON|OFF. Con 0 las
+ *          macros PRT7_METRICA_* no generan código.
+ */
+#ifndef PRT7_METRICAS
+    #define PRT7_METRICAS 1
+#endif
+
+/**
+ * @brief Almacenamiento por hilo sin inicialización dinámica
+ * @details Con thread_local, GCC y Clang llaman a una función de
+ *          inicialización en cada acceso desde otra unidad de compilación;
+ *          __thread se resuelve con un desplazamiento fijo.
+ */
+#if defined(__GNUC__)
+    #define PRT7_POR_HILO __thread
+#else
+    #define PRT7_POR_HILO thread_local
+#endif
+
+/**
+ * @class Metricas
+ * @brief Punto único de instrumentación del decodificador
+ * @details Cada hilo escribe en su propio bloque de contadores (se registra en
+ *          su primer uso y no se libera, para conservar los totales), así que
+ *          registrar no necesita candados ni instrucciones atómicas con
+ *          bloqueo. Las latencias se muestrean: sólo una de cada
+ *          PERIODO_MUESTREO llamadas lee el reloj. Los histogramas son
+ *          logarítmico-lineales al estilo HDR: 16 sub-cubetas por potencia de
+ *          dos, con error relativo menor al 7%.
+ */
+class Metricas {
+public:
+    static const int NUM_ETAPAS = 5; ///< Número de etapas instrumentadas
+
+    /**
+     * @brief Etapas instrumentadas
+     */
+    enum Etapa {
+        ETAPA_LECTURA = 0,      ///< Obtener una línea de la fuente
+        ETAPA_PARSEO = 1,       ///< Validar y clasificar la línea
+        ETAPA_CONSTRUCCION = 2, ///< Crear u obtener del pool el objeto trama
+        ETAPA_ROTOR = 3,        ///< Aplicar una trama MAP
+        ETAPA_CARGA = 4         ///< Decodificar y agregar una carga a la lista
+    };
+
+    static const int PERIODO_MUESTREO = 1024; ///< Una de cada N mediciones lee el reloj (potencia de dos)
+
+private:
+    static PRT7_POR_HILO unsigned int contadorMuestreo[NUM_ETAPAS]; ///< Llamadas por etapa en este hilo
+
+public:
+    /**
+     * @brief Indica si corresponde medir esta llamada (muestreo por hilo y por etapa)
+     * @param etapa Etapa que se va a medir
+     * @return true una de cada PERIODO_MUESTREO llamadas
+     * @details Se define en el header para que en el camino crítico sólo cueste
+     *          un incremento. El contador es independiente por etapa para que
+     *          las etapas que se alternan en cada trama se muestreen por igual.
+     */
+    static bool tocaMuestra(Etapa etapa) {
+        return (++contadorMuestreo[etapa] & (PERIODO_MUESTREO - 1)) == 0;
+    }
+
+    /**
+     * @brief Instante actual en nanosegundos (reloj monotónico)
+     * @return Nanosegundos
+     */
+    static long long ahoraNs();
+
+    /**
+     * @brief Registra una latencia en el histograma de una etapa
+     * @param etapa Etapa medida
+     * @param nanosegundos Duración observada
+     */
+    static void registrarLatencia(Etapa etapa, long long nanosegundos);
+
+    /**
+     * @brief Suma tramas procesadas
+     * @param tipo TRAMA_LOAD, TRAMA_MAP o TRAMA_ROTOR
+     * @param cantidad Número de tramas
+     */
+    static void contarTramas(TipoTrama tipo, long long cantidad);
+
+    /**
+     * @brief Suma una trama inválida
+     * @param error Motivo del rechazo
+     */
+    static void contarError(ErrorTrama error);
+
+    /**
+     * @brief Escribe el resumen de todos los hilos
+     * @param salida Flujo de destino
+     * @details Incluye tramas/s desde el resumen anterior. Los contadores se
+     *          leen mientras los hilos siguen escribiendo, así que un resumen
+     *          intermedio es aproximado.
+     */
+    static void imprimir(std::ostream& salida);
+
+    /**
+     * @brief Escribe el resumen en std::cerr de una sola vez
+     */
+    static void imprimirEnError();
+
+    /**
+     * @brief Inicia un hilo que escribe el resumen al recibir SIGUSR1 y, opcionalmente, cada cierto tiempo
+     * @param periodoMs Milisegundos entre resúmenes (0 = sólo con SIGUSR1)
+     */
+    static void iniciarReportes(int periodoMs);
+
+    /**
+     * @brief Detiene el hilo de resúmenes
+     */
+    static void detenerReportes();
+
+    /**
+     * @brief Nombre de un motivo de error
+     * @param error Motivo
+     * @return Nombre corto
+     */
+    static const char* getNombreError(ErrorTrama error);
+};
+
+#if PRT7_METRICAS
+    /**
+     * @brief Abre una medición muestreada; `var` vale 0 si esta llamada no se mide
+     */
+    #define PRT7_METRICA_INICIO(etapa, var) \
+        long long var = Metricas::tocaMuestra(etapa) ? Metricas::ahoraNs() : 0
+    /**
+     * @brief Cierra la medición abierta con PRT7_METRICA_INICIO
+     */
+    #define PRT7_METRICA_FIN(etapa, var) \
+        do { if (var != 0) Metricas::registrarLatencia(etapa, Metricas::ahoraNs() - var); } while (0)
+    /**
+     * @brief Decide una sola vez si se mide un elemento que pasa por varias etapas
+     * @details En bucles por línea evita un acceso al contador por hilo en cada etapa.
+     */
+    #define PRT7_METRICA_MUESTREO(etapa, medir) const bool medir = Metricas::tocaMuestra(etapa)
+    /**
+     * @brief Abre una medición según una decisión tomada con PRT7_METRICA_MUESTREO
+     */
+    #define PRT7_METRICA_INICIO_SI(medir, var) long long var = (medir) ? Metricas::ahoraNs() : 0
+    #define PRT7_METRICA_TRAMAS(tipo, cantidad) Metricas::contarTramas(tipo, cantidad)
+    #define PRT7_METRICA_ERROR(error) Metricas::contarError(error)
+#else
+    #define PRT7_METRICA_INICIO(etapa, var) do {} while (0)
+    #define PRT7_METRICA_FIN(etapa, var) do {} while (0)
+    #define PRT7_METRICA_MUESTREO(etapa, medir) do {} while (0)
+    #define PRT7_METRICA_INICIO_SI(medir, var) do {} while (0)
+    #define PRT7_METRICA_TRAMAS(tipo, cantidad) do {} while (0)
+    #define PRT7_METRICA_ERROR(error) do {} while (0)
+#endif
+
+#endif // METRICAS_H
@@ -0,0 +1,80 @@
+/**
+ * @file ParserTramas.cpp
+ * @brief Implementación del parser de tramas de texto
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "ParserTramas.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaRotor.h"
+#include "PoolDeTramas.h"
+#include "Registro.h"
+#include "Metricas.h"
+#include "TramaCompacta.h"
+#include <cstring>
+
+/**
+ * @brief Parsea una cadena de trama y crea el objeto correspondiente
+ * @param linea Cadena a parsear (ej. "L,H" o "M,2")
+ * @param pool Pool de tramas reutilizables; si es nullptr la trama se crea con new
+ * @return Puntero a la trama creada, o nullptr si hay error
+ * @details Con pool la trama pertenece al pool y no debe liberarse con delete.
+ *          Las reglas son las de clasificarTrama(); esta función sólo agrega
+ *          los mensajes de error y la construcción del objeto.
+ */
+TramaBase* parsearTrama(const char* linea, PoolDeTramas* pool) {
+    PRT7_METRICA_INICIO(Metricas::ETAPA_PARSEO, inicioParseo);
+    int longitud = (linea != nullptr) ? (int)strlen(linea) : 0;
+    ErrorTrama error;
+    TramaCompacta compacta = clasificarTrama(linea, longitud, &error);
+
+    switch (error) {
+        case ERROR_NINGUNO:
+            break;
+        case ERROR_LINEA_CORTA:
+            PRT7_RESUMEN("Error: Línea inválida o muy corta: " << (linea ? linea : "null") << "\n");
+            break;
+        case ERROR_SIN_COMA:
+            PRT7_RESUMEN("Error: Formato inválido (falta coma): " << linea << "\n");
+            break;
+        case ERROR_LOAD_LONGITUD:
+            PRT7_RESUMEN("Error: TramaLoad debe tener exactamente un carácter: " << linea << "\n");
+            break;
+        case ERROR_ROTOR_FORMATO:
+            PRT7_RESUMEN("Error: TramaRotor debe tener la forma R,k,N: " << linea << "\n");
+            break;
+        case ERROR_NUMERO_INVALIDO:
+            PRT7_RESUMEN("Error: Número inválido en la trama: " << linea << "\n");
+            break;
+        case ERROR_NUMERO_DESBORDADO:
+            PRT7_RESUMEN("Error: Número fuera de rango en la trama: " << linea << "\n");
+            break;
+        default:
+            PRT7_RESUMEN("Error: Tipo de trama desconocido: " << linea[0] << "\n");
+            break;
+    }
+    if (error != ERROR_NINGUNO) {
+        PRT7_METRICA_ERROR(error);
+        return nullptr;
+    }
+    PRT7_METRICA_FIN(Metricas::ETAPA_PARSEO, inicioParseo);
+
+    TramaBase* trama = nullptr;
+    PRT7_METRICA_INICIO(Metricas::ETAPA_CONSTRUCCION, inicioConstruccion);
+    if (compacta.tipo == TRAMA_LOAD) {
+        char caracter = (char)compacta.valor;
+        PRT7_TRAZA("Parseando: [" << linea << "] -> TramaLoad('" << caracter << "')\n");
+        trama = (pool != nullptr) ? pool->obtenerLoad(caracter) : new TramaLoad(caracter);
+    } else if (compacta.tipo == TRAMA_MAP) {
+        PRT7_TRAZA("Parseando: [" << linea << "] -> TramaMap(" << compacta.valor << ")\n");
+        trama = (pool != nullptr) ? pool->obtenerMap(compacta.valor) : new TramaMap(compacta.valor);
+    } else {
+        PRT7_TRAZA("Parseando: [" << linea << "] -> TramaRotor(" << compacta.indice << ", " << compacta.valor << ")\n");
+        trama = (pool != nullptr) ? pool->obtenerRotor(compacta.indice, compacta.valor)
+                                  : new TramaRotor(compacta.indice, compacta.valor);
+    }
+    PRT7_METRICA_FIN(Metricas::ETAPA_CONSTRUCCION, inicioConstruccion);
+    return trama;
+}
@@ -0,0 +1,24 @@
+/**
+ * @file ParserTramas.h
+ * @brief Parser de las tramas de texto PRT-7 ("L,X" / "M,N")
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef PARSER_TRAMAS_H
+#define PARSER_TRAMAS_H
+
+#include "TramaBase.h"
+
+class PoolDeTramas;
+
+/**
+ * @brief Parsea una cadena de trama y crea el objeto correspondiente
+ * @param linea Cadena a parsear (ej. "L,H" o "M,2")
+ * @param pool Pool de tramas reutilizables; si es nullptr la trama se crea con new
+ * @return Puntero a la trama creada, o nullptr si hay error
+ * @details Con pool la trama pertenece al pool y no debe liberarse con delete.
+ */
+TramaBase* parsearTrama(const char* linea, PoolDeTramas* pool = nullptr);
+
+#endif // PARSER_TRAMAS_H
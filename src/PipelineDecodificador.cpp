@@ -0,0 +1,206 @@
+/**
+ * @file PipelineDecodificador.cpp
+ * @brief Implementación de la clase PipelineDecodificador
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "PipelineDecodificador.h"
+#include "FuenteDeLineas.h"
+#include "PoolDeTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Registro.h"
+#include "Metricas.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifndef _WIN32
+    #include <poll.h>
+#endif
+
+/// Reintentos con yield antes de dormir cuando una cola está vacía o llena
+static const int REINTENTOS_ACTIVOS = 64;
+
+/**
+ * @brief Cede el procesador; tras varios intentos duerme brevemente
+ * @param intentos Contador de intentos consecutivos (se incrementa)
+ */
+static void esperarBreve(int* intentos) {
+    if (++(*intentos) < REINTENTOS_ACTIVOS) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+/**
+ * @brief Acumula una muestra de latencia y ocupación en los contadores
+ */
+static void registrarMuestra(EstadisticasEtapa* e, long long latenciaNs, long long ocupacion) {
+    e->procesados++;
+    e->latenciaTotalNs += latenciaNs;
+    if (latenciaNs > e->latenciaMaximaNs) e->latenciaMaximaNs = latenciaNs;
+    e->ocupacionTotal += ocupacion;
+    if (ocupacion > e->ocupacionMaxima) e->ocupacionMaxima = ocupacion;
+}
+
+/**
+ * @brief Encola esperando mientras la cola esté llena
+ */
+template <typename T>
+static void encolarConEspera(ColaSPSC<T>* cola, const T& elemento, EstadisticasEtapa* e) {
+    if (cola->intentarEncolar(elemento)) return;
+    e->esperasColaLlena++;
+    int intentos = 0;
+    while (!cola->intentarEncolar(elemento)) {
+        esperarBreve(&intentos);
+    }
+}
+
+EstadisticasEtapa::EstadisticasEtapa()
+    : procesados(0), latenciaTotalNs(0), latenciaMaximaNs(0), ocupacionTotal(0),
+      ocupacionMaxima(0), esperasColaLlena(0), descartados(0) {}
+
+PipelineDecodificador::PipelineDecodificador(FuenteDeLineas* fuente, ListaDeCarga* carga,
+                                             RotorDeMapeo* rotor, int capacidadColas)
+    : fuente(fuente), carga(carga), rotor(rotor),
+      lineas((size_t)capacidadColas), tramas((size_t)capacidadColas) {}
+
+void PipelineDecodificador::etapaLector() {
+    EstadisticasEtapa* e = &estadisticas[ETAPA_LECTOR];
+    LineaCruda cruda;
+    cruda.esFin = false;
+
+    while (true) {
+        long long inicio = Metricas::ahoraNs();
+        const char* linea;
+        int longitud;
+        int estado = fuente->leerLineaDisponible(&linea, &longitud);
+
+        if (estado == FuenteDeLineas::SIN_DATOS) {
+#ifndef _WIN32
+            int fd = fuente->getDescriptor();
+            if (fd >= 0) {
+                struct pollfd pfd;
+                pfd.fd = fd;
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+                poll(&pfd, 1, 10);
+                continue;
+            }
+#endif
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (estado == FuenteDeLineas::FIN_DE_FUENTE ||
+            (longitud == 3 && memcmp(linea, "END", 3) == 0)) {
+            break;
+        }
+
+        if (longitud <= LineaCruda::LONGITUD_MAXIMA) {
+            memcpy(cruda.texto, linea, (size_t)longitud);
+            cruda.longitud = (signed char)longitud;
+        } else {
+            cruda.longitud = -1;
+        }
+        cruda.marcaNs = Metricas::ahoraNs();
+        encolarConEspera(&lineas, cruda, e);
+        registrarMuestra(e, Metricas::ahoraNs() - inicio, (long long)lineas.ocupacion());
+    }
+
+    cruda.esFin = true;
+    cruda.longitud = 0;
+    cruda.marcaNs = Metricas::ahoraNs();
+    encolarConEspera(&lineas, cruda, e);
+}
+
+void PipelineDecodificador::etapaParser() {
+    EstadisticasEtapa* e = &estadisticas[ETAPA_PARSER];
+    LineaCruda cruda;
+    TramaEnTransito salida;
+    salida.esFin = false;
+
+    while (true) {
+        long long ocupacion = (long long)lineas.ocupacion();
+        int intentos = 0;
+        while (!lineas.intentarDesencolar(&cruda)) {
+            esperarBreve(&intentos);
+        }
+        if (cruda.esFin) break;
+
+        ErrorTrama error = ERROR_NINGUNO;
+        if (cruda.longitud < 0) {
+            salida.trama.tipo = TRAMA_INVALIDA;
+            error = ERROR_LINEA_LARGA;
+        } else {
+            PRT7_METRICA_INICIO(Metricas::ETAPA_PARSEO, inicioParseo);
+            salida.trama = clasificarTrama(cruda.texto, cruda.longitud, &error);
+            PRT7_METRICA_FIN(Metricas::ETAPA_PARSEO, inicioParseo);
+        }
+
+        if (salida.trama.tipo == TRAMA_INVALIDA) {
+            e->descartados++;
+            PRT7_METRICA_ERROR(error);
+        } else {
+            salida.marcaNs = Metricas::ahoraNs();
+            encolarConEspera(&tramas, salida, e);
+        }
+        registrarMuestra(e, Metricas::ahoraNs() - cruda.marcaNs, ocupacion);
+    }
+
+    salida.esFin = true;
+    salida.marcaNs = Metricas::ahoraNs();
+    encolarConEspera(&tramas, salida, e);
+}
+
+void PipelineDecodificador::etapaDecodificador() {
+    EstadisticasEtapa* e = &estadisticas[ETAPA_DECODIFICADOR];
+    PoolDeTramas pool;
+    TramaEnTransito entrada;
+
+    while (true) {
+        long long ocupacion = (long long)tramas.ocupacion();
+        int intentos = 0;
+        while (!tramas.intentarDesencolar(&entrada)) {
+            esperarBreve(&intentos);
+        }
+        if (entrada.esFin) break;
+
+        TramaBase* trama = pool.obtener(entrada.trama);
+        trama->procesar(carga, rotor);
+        registrarMuestra(e, Metricas::ahoraNs() - entrada.marcaNs, ocupacion);
+    }
+}
+
+void PipelineDecodificador::ejecutar() {
+    std::thread lector(&PipelineDecodificador::etapaLector, this);
+    std::thread parser(&PipelineDecodificador::etapaParser, this);
+    etapaDecodificador();
+    parser.join();
+    lector.join();
+}
+
+const EstadisticasEtapa& PipelineDecodificador::getEstadisticas(Etapa etapa) const {
+    return estadisticas[etapa];
+}
+
+void PipelineDecodificador::imprimirEstadisticas() const {
+    static const char* nombres[NUM_ETAPAS] = { "lector", "parser", "decodificador" };
+    std::ostream& salida = Registro::salida();
+    salida << "=== Estadísticas de la tubería ===\n";
+    for (int i = 0; i < NUM_ETAPAS; i++) {
+        const EstadisticasEtapa& e = estadisticas[i];
+        long long n = e.procesados > 0 ? e.procesados : 1;
+        salida << nombres[i] << ": " << e.procesados << " elementos"
+               << ", latencia media " << (e.latenciaTotalNs / n) << " ns"
+               << ", máxima " << e.latenciaMaximaNs << " ns"
+               << ", ocupación media " << (e.ocupacionTotal / n)
+               << ", máxima " << e.ocupacionMaxima
+               << ", colas llenas " << e.esperasColaLlena;
+        if (i == ETAPA_PARSER) salida << ", descartadas " << e.descartados;
+        salida << "\n";
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file PipelineDecodificador.h
+ * @brief Modo en tubería: lector -> parser -> decodificador en hilos separados
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef PIPELINE_DECODIFICADOR_H
+#define PIPELINE_DECODIFICADOR_H
+
+#include "ColaSPSC.h"
+#include "TramaCompacta.h"
+
+class FuenteDeLineas;
+class ListaDeCarga;
+class RotorDeMapeo;
+
+/**
+ * @brief Línea copiada por la etapa lectora para la etapa de parseo
+ */
+struct LineaCruda {
+    static const int LONGITUD_MAXIMA = 47; ///< Una trama válida nunca es más larga
+
+    char texto[LONGITUD_MAXIMA]; ///< Bytes de la línea (sin '\0')
+    signed char longitud;        ///< Longitud, o -1 si la línea no cabía (inválida)
+    bool esFin;                  ///< Marca de fin de flujo
+    long long marcaNs;           ///< Instante en que se leyó la línea
+};
+
+/**
+ * @brief Trama clasificada por la etapa de parseo para la etapa decodificadora
+ */
+struct TramaEnTransito {
+    TramaCompacta trama; ///< Trama clasificada
+    bool esFin;          ///< Marca de fin de flujo
+    long long marcaNs;   ///< Instante en que se clasificó la trama
+};
+
+/**
+ * @brief Contadores de una etapa de la tubería
+ * @details Cada etapa escribe sólo sus propios contadores; se leen después de
+ *          que ejecutar() termina.
+ */
+struct EstadisticasEtapa {
+    long long procesados;       ///< Elementos procesados
+    long long latenciaTotalNs;  ///< Suma de latencias (espera en cola + proceso)
+    long long latenciaMaximaNs; ///< Mayor latencia observada
+    long long ocupacionTotal;   ///< Suma de la ocupación de la cola de entrada (la de salida para el lector)
+    long long ocupacionMaxima;  ///< Mayor ocupación observada de esa cola
+    long long esperasColaLlena; ///< Veces que la cola de salida estaba llena
+    long long descartados;      ///< Líneas inválidas descartadas (etapa de parseo)
+
+    EstadisticasEtapa();
+};
+
+/**
+ * @class PipelineDecodificador
+ * @brief Decodifica una fuente con tres etapas conectadas por colas SPSC sin candados
+ * @details La etapa lectora sólo drena la fuente y copia líneas, de modo que un
+ *          parseo o una escritura lenta no detiene la lectura del UART mientras
+ *          haya espacio en las colas. La etapa de parseo clasifica las líneas sin
+ *          imprimir y la etapa decodificadora aplica cada trama con
+ *          TramaBase::procesar() a través de un PoolDeTramas.
+ */
+class PipelineDecodificador {
+public:
+    /**
+     * @brief Identificador de cada etapa
+     */
+    enum Etapa { ETAPA_LECTOR = 0, ETAPA_PARSER = 1, ETAPA_DECODIFICADOR = 2, NUM_ETAPAS = 3 };
+
+private:
+    FuenteDeLineas* fuente;              ///< Origen de las líneas
+    ListaDeCarga* carga;                 ///< Destino de los caracteres decodificados
+    RotorDeMapeo* rotor;                 ///< Rotor de la sesión
+    ColaSPSC<LineaCruda> lineas;         ///< Lector -> parser
+    ColaSPSC<TramaEnTransito> tramas;    ///< Parser -> decodificador
+    EstadisticasEtapa estadisticas[NUM_ETAPAS]; ///< Contadores por etapa
+
+    void etapaLector();
+    void etapaParser();
+    void etapaDecodificador();
+
+public:
+    /**
+     * @brief Constructor
+     * @param fuente Origen de las líneas
+     * @param carga Lista donde se insertan los caracteres
+     * @param rotor Rotor para el mapeo
+     * @param capacidadColas Elementos por cola (se redondea a potencia de dos)
+     */
+    PipelineDecodificador(FuenteDeLineas* fuente, ListaDeCarga* carga, RotorDeMapeo* rotor,
+                          int capacidadColas = 4096);
+
+    /**
+     * @brief Ejecuta las tres etapas hasta el fin de la fuente o una línea "END"
+     */
+    void ejecutar();
+
+    /**
+     * @brief Obtiene los contadores de una etapa
+     * @param etapa Etapa a consultar
+     * @return Contadores de la etapa
+     */
+    const EstadisticasEtapa& getEstadisticas(Etapa etapa) const;
+
+    /**
+     * @brief Imprime los contadores de las tres etapas en el registro
+     */
+    void imprimirEstadisticas() const;
+};
+
+#endif // PIPELINE_DECODIFICADOR_H
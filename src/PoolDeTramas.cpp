@@ -0,0 +1,62 @@
+/**
+ * @file PoolDeTramas.cpp
+ * @brief Implementación de la clase PoolDeTramas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "PoolDeTramas.h"
+
+/**
+ * @brief Constructor: crea las instancias reutilizables
+ */
+PoolDeTramas::PoolDeTramas() : load(' '), map(0), rotor(0, 0) {}
+
+/**
+ * @brief Obtiene la trama LOAD del pool con un nuevo carácter
+ * @param c Carácter de la trama
+ * @return Puntero a la trama (propiedad del pool)
+ */
+TramaBase* PoolDeTramas::obtenerLoad(char c) {
+    load.setCaracter(c);
+    return &load;
+}
+
+/**
+ * @brief Obtiene la trama MAP del pool con una nueva rotación
+ * @param n Número de posiciones a rotar
+ * @return Puntero a la trama (propiedad del pool)
+ */
+TramaBase* PoolDeTramas::obtenerMap(int n) {
+    map.setRotacion(n);
+    return &map;
+}
+
+/**
+ * @brief Obtiene la trama R,k,N del pool con un nuevo rotor y rotación
+ * @param k Rotor de la cascada
+ * @param n Número de posiciones a rotar
+ * @return Puntero a la trama (propiedad del pool)
+ */
+TramaBase* PoolDeTramas::obtenerRotor(int k, int n) {
+    rotor.setRotacion(k, n);
+    return &rotor;
+}
+
+/**
+ * @brief Obtiene la trama del pool que corresponde a una trama compacta
+ * @param trama Trama clasificada
+ * @return Puntero a la trama (propiedad del pool), o nullptr si es inválida
+ */
+TramaBase* PoolDeTramas::obtener(const TramaCompacta& trama) {
+    switch (trama.tipo) {
+        case TRAMA_LOAD:
+            return obtenerLoad((char)trama.valor);
+        case TRAMA_MAP:
+            return obtenerMap(trama.valor);
+        case TRAMA_ROTOR:
+            return obtenerRotor(trama.indice, trama.valor);
+        default:
+            return nullptr;
+    }
+}
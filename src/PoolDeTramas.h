@@ -0,0 +1,67 @@
+/**
+ * @file PoolDeTramas.h
+ * @brief Tramas preconstruidas que se reutilizan para no reservar memoria por línea
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef POOL_DE_TRAMAS_H
+#define POOL_DE_TRAMAS_H
+
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaRotor.h"
+#include "TramaCompacta.h"
+
+/**
+ * @class PoolDeTramas
+ * @brief Conserva una instancia de cada tipo de trama y la recicla en cada línea
+ * @details En lugar de `new TramaLoad(...)` / `delete` por cada línea, el parser
+ *          actualiza el objeto correspondiente del pool y devuelve un TramaBase*
+ *          a él, de modo que procesar() sigue siendo polimórfico. El puntero
+ *          devuelto es propiedad del pool (no se debe hacer delete) y es válido
+ *          hasta la siguiente solicitud del mismo tipo.
+ */
+class PoolDeTramas {
+private:
+    TramaLoad load; ///< Instancia reutilizable de trama LOAD
+    TramaMap map;   ///< Instancia reutilizable de trama MAP
+    TramaRotor rotor; ///< Instancia reutilizable de trama R,k,N
+
+public:
+    /**
+     * @brief Constructor: crea las instancias reutilizables
+     */
+    PoolDeTramas();
+
+    /**
+     * @brief Obtiene la trama LOAD del pool con un nuevo carácter
+     * @param c Carácter de la trama
+     * @return Puntero a la trama (propiedad del pool)
+     */
+    TramaBase* obtenerLoad(char c);
+
+    /**
+     * @brief Obtiene la trama MAP del pool con una nueva rotación
+     * @param n Número de posiciones a rotar
+     * @return Puntero a la trama (propiedad del pool)
+     */
+    TramaBase* obtenerMap(int n);
+    
+    /**
+     * @brief Obtiene la trama R,k,N del pool con un nuevo rotor y rotación
+     * @param k Rotor de la cascada
+     * @param n Número de posiciones a rotar
+     * @return Puntero a la trama (propiedad del pool)
+     */
+    TramaBase* obtenerRotor(int k, int n);
+
+    /**
+     * @brief Obtiene la trama del pool que corresponde a una trama compacta
+     * @param trama Trama clasificada
+     * @return Puntero a la trama (propiedad del pool), o nullptr si es inválida
+     */
+    TramaBase* obtener(const TramaCompacta& trama);
+};
+
+#endif // POOL_DE_TRAMAS_H
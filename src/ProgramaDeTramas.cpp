@@ -0,0 +1,489 @@
+/**
+ * @file ProgramaDeTramas.cpp
+ * @brief Implementación de la clase ProgramaDeTramas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "ProgramaDeTramas.h"
+#include "ClasificacionLote.h"
+#include "DecodificacionLote.h"
+#include "LectorCaptura.h"
+#include "RotorDeMapeo.h"
+#include "ListaDeCarga.h"
+#include "CascadaDeRotores.h"
+#include "TramaBinaria.h"
+#include "CodificacionEnteros.h"
+#include "Metricas.h"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+static const unsigned int VERSION_PROGRAMA = 1;
+
+/// Bytes de la cabecera: campos fijos, errores por motivo y suma de verificación
+static const int TAMANIO_CABECERA = 88 + 8 * NUM_ERRORES_TRAMA + 8;
+
+/// Máximo de bytes de una instrucción codificada: etiqueta y dos varints de 32 bits
+static const int MAX_BYTES_INSTRUCCION = 1 + 2 * 5;
+
+/// Caracteres decodificados que ejecutar() acumula antes de insertarlos en la lista
+static const int BLOQUE_EJECUCION = 4096;
+
+/// Rachas más cortas que esto se decodifican con el kernel escalar, sin despacho
+static const int RACHA_CORTA = 16;
+
+/// Tramas clasificadas por llamada a clasificarLote() al compilar una captura
+static const int TRAMAS_POR_LOTE = 1024;
+
+/// Valor inicial de la suma de verificación (base de FNV-1a de 64 bits)
+static const unsigned long long SUMA_INICIAL = 14695981039346656037ULL;
+
+/**
+ * @brief Continúa una suma de verificación FNV-1a de 64 bits, de a 8 bytes por paso
+ * @param suma Suma acumulada (SUMA_INICIAL para empezar)
+ * @details Tomar palabras en lugar de bytes la hace unas 8 veces más rápida,
+ *          que importa porque se recorre todo el programa al cargarlo. Las
+ *          palabras se leen en el orden del procesador: en uno big-endian el
+ *          archivo no valida y simplemente se vuelve a compilar.
+ */
+static unsigned long long sumaVerificacion(unsigned long long suma, const unsigned char* datos, long long cantidad) {
+    long long i = 0;
+    for (; i + 8 <= cantidad; i += 8) {
+        unsigned long long palabra;
+        memcpy(&palabra, datos + i, 8);
+        suma = (suma ^ palabra) * 1099511628211ULL;
+    }
+    for (; i < cantidad; i++) {
+        suma = (suma ^ datos[i]) * 1099511628211ULL;
+    }
+    return suma;
+}
+
+ProgramaDeTramas::ProgramaDeTramas(int tamanio)
+    : instrucciones(nullptr), numInstrucciones(0), capInstrucciones(0),
+      cargas(nullptr), numCargas(0), capCargas(0), tamanioRotor(tamanio),
+      lineas(0), invalidas(0), terminado(false) {
+    for (int i = 0; i < NUM_ERRORES_TRAMA; i++) errores[i] = 0;
+}
+
+ProgramaDeTramas::~ProgramaDeTramas() {
+    delete[] instrucciones;
+    delete[] cargas;
+}
+
+void ProgramaDeTramas::vaciar() {
+    delete[] instrucciones;
+    delete[] cargas;
+    instrucciones = nullptr;
+    cargas = nullptr;
+    numInstrucciones = capInstrucciones = 0;
+    numCargas = capCargas = 0;
+    lineas = invalidas = 0;
+    for (int i = 0; i < NUM_ERRORES_TRAMA; i++) errores[i] = 0;
+    terminado = false;
+}
+
+Instruccion* ProgramaDeTramas::agregarInstruccion() {
+    if (numInstrucciones == capInstrucciones) {
+        long long capacidad = capInstrucciones > 0 ? capInstrucciones * 2 : 256;
+        Instruccion* nuevas = new Instruccion[capacidad];
+        if (numInstrucciones > 0) memcpy(nuevas, instrucciones, (size_t)numInstrucciones * sizeof(Instruccion));
+        delete[] instrucciones;
+        instrucciones = nuevas;
+        capInstrucciones = capacidad;
+    }
+    return &instrucciones[numInstrucciones++];
+}
+
+void ProgramaDeTramas::reservarCargas(long long adicionales) {
+    if (numCargas + adicionales <= capCargas) return;
+    long long capacidad = capCargas > 0 ? capCargas : 4096;
+    while (capacidad < numCargas + adicionales) capacidad *= 2;
+    char* nuevas = new char[capacidad];
+    if (numCargas > 0) memcpy(nuevas, cargas, (size_t)numCargas);
+    delete[] cargas;
+    cargas = nuevas;
+    capCargas = capacidad;
+}
+
+void ProgramaDeTramas::reservar(long long bytesCaptura) {
+    reservarCargas(bytesCaptura / 4 + 1 - numCargas);
+    long long estimadas = bytesCaptura / 16 + 1;
+    if (estimadas > capInstrucciones) {
+        Instruccion* nuevas = new Instruccion[estimadas];
+        if (numInstrucciones > 0) memcpy(nuevas, instrucciones, (size_t)numInstrucciones * sizeof(Instruccion));
+        delete[] instrucciones;
+        instrucciones = nuevas;
+        capInstrucciones = estimadas;
+    }
+}
+
+void ProgramaDeTramas::compilar(const TramaCompacta* tramas, int cantidad) {
+    lineas += cantidad;
+
+    // La última instrucción sigue abierta: una racha o una rotación pueden continuar
+    Instruccion* ultima = numInstrucciones > 0 ? &instrucciones[numInstrucciones - 1] : nullptr;
+    for (int i = 0; i < cantidad; i++) {
+        const TramaCompacta& trama = tramas[i];
+        if (trama.tipo == TRAMA_LOAD) {
+            if (ultima == nullptr || ultima->tipo != INSTRUCCION_CARGAR ||
+                ultima->cantidad == MAX_CARGAS_POR_INSTRUCCION) {
+                ultima = agregarInstruccion();
+                ultima->tipo = INSTRUCCION_CARGAR;
+                ultima->indice = 0;
+                ultima->cantidad = 0;
+                ultima->inicio = numCargas;
+            }
+            // La racha se copia completa antes de volver a mirar la instrucción
+            int limite = i + (MAX_CARGAS_POR_INSTRUCCION - ultima->cantidad);
+            if (limite > cantidad || limite < i) limite = cantidad;
+            int j = i;
+            while (j < limite && tramas[j].tipo == TRAMA_LOAD) j++;
+            reservarCargas(j - i);
+            for (int k = i; k < j; k++) cargas[numCargas++] = (char)tramas[k].valor;
+            ultima->cantidad += j - i;
+            i = j - 1;
+        } else if (trama.tipo == TRAMA_MAP) {
+            if (tamanioRotor <= 0) continue;
+            int neta = trama.valor % tamanioRotor;
+            if (neta < 0) neta += tamanioRotor;
+            if (ultima != nullptr && ultima->tipo == INSTRUCCION_ROTAR) {
+                neta += ultima->cantidad;
+                if (neta >= tamanioRotor) neta -= tamanioRotor;
+                if (neta == 0) {
+                    // Los MAP se cancelaron: la instrucción sobra
+                    numInstrucciones--;
+                    ultima = numInstrucciones > 0 ? &instrucciones[numInstrucciones - 1] : nullptr;
+                } else {
+                    ultima->cantidad = neta;
+                }
+            } else if (neta != 0) {
+                ultima = agregarInstruccion();
+                ultima->tipo = INSTRUCCION_ROTAR;
+                ultima->indice = 0;
+                ultima->cantidad = neta;
+                ultima->inicio = 0;
+            }
+        } else if (trama.tipo == TRAMA_ROTOR) {
+            ultima = agregarInstruccion();
+            ultima->tipo = INSTRUCCION_GIRAR;
+            ultima->indice = trama.indice;
+            ultima->cantidad = trama.valor;
+            ultima->inicio = 0;
+        } else {
+            invalidas++;
+            if (trama.valor > 0 && trama.valor < NUM_ERRORES_TRAMA) errores[trama.valor]++;
+        }
+    }
+}
+
+bool ProgramaDeTramas::compilarCaptura(LectorCaptura* captura) {
+    TramaCompacta* tramas = new TramaCompacta[TRAMAS_POR_LOTE];
+    bool primero = true;
+    bool texto = true;
+
+    while (!terminado) {
+        const char* datos;
+        size_t disponibles;
+        if (!captura->asomarBytes(&datos, &disponibles)) break;
+        if (primero) {
+            primero = false;
+            // Las tramas numeradas necesitan el buffer de reorden de la sesión
+            if (esInicioBinario(datos[0]) || datos[0] == 'S' || datos[0] == 's') {
+                texto = false;
+                break;
+            }
+        }
+
+        ResultadoLote lote = clasificarLote(datos, disponibles, tramas, TRAMAS_POR_LOTE);
+        if (lote.lineas > 0) {
+            captura->consumirBytes(lote.consumidos);
+        } else {
+            // Sólo queda una línea incompleta: la captura la completa o la entrega al final
+            const char* linea;
+            int longitud;
+            if (!captura->siguienteLinea(&linea, &longitud)) break;
+            lote.lineas = 1;
+            lote.tramas = 0;
+            lote.fin = (longitud == 3 && memcmp(linea, "END", 3) == 0);
+            if (longitud > 0 && !lote.fin) tramas[lote.tramas++] = clasificarTrama(linea, longitud);
+        }
+        compilar(tramas, lote.tramas);
+        // Las líneas vacías y la de "END" cuentan como líneas aunque no generen tramas
+        lineas += lote.lineas - lote.tramas;
+        if (lote.fin) terminado = true;
+    }
+
+    delete[] tramas;
+    return texto;
+}
+
+long long ProgramaDeTramas::ejecutar(RotorDeMapeo* rotor, ListaDeCarga* carga) const {
+    CascadaDeRotores* cascada = rotor->getCascada();
+    long long girosInvalidos = 0;
+    long long cargadas = 0;
+    long long rotaciones = 0;
+    long long giros = 0;
+
+    // Las rachas se decodifican con la posición vigente de cada una pero se
+    // acumulan en un solo bloque: una rotación no obliga a insertar en la lista.
+    // El alfabeto no cambia durante la ejecución: se consulta una sola vez
+    bool estandar = rotor->esAlfabetoEstandar();
+    char bloque[BLOQUE_EJECUCION];
+    int enBloque = 0;
+    for (long long i = 0; i < numInstrucciones; i++) {
+        const Instruccion& instruccion = instrucciones[i];
+        if (instruccion.tipo == INSTRUCCION_CARGAR) {
+            const char* origen = cargas + instruccion.inicio;
+            int pendientes = instruccion.cantidad;
+            while (pendientes > 0) {
+                int n = BLOQUE_EJECUCION - enBloque < pendientes ? BLOQUE_EJECUCION - enBloque : pendientes;
+                if (!estandar) {
+                    rotor->getMapeoLote(origen, bloque + enBloque, n);
+                } else if (n < RACHA_CORTA) {
+                    decodificarLoteEscalar(origen, bloque + enBloque, n, rotor->getPosicion());
+                } else {
+                    decodificarLote(origen, bloque + enBloque, n, rotor->getPosicion());
+                }
+                origen += n;
+                pendientes -= n;
+                enBloque += n;
+                if (enBloque == BLOQUE_EJECUCION) {
+                    if (cascada != nullptr) cascada->cifrarLote(bloque, enBloque);
+                    carga->insertarLote(bloque, enBloque);
+                    enBloque = 0;
+                }
+            }
+            cargadas += instruccion.cantidad;
+        } else if (instruccion.tipo == INSTRUCCION_ROTAR) {
+            rotor->setPosicion(rotor->getPosicion() + instruccion.cantidad);
+            rotaciones++;
+        } else {
+            // La cascada avanza con cada carga: lo acumulado pasa por ella antes del giro
+            if (enBloque > 0) {
+                if (cascada != nullptr) cascada->cifrarLote(bloque, enBloque);
+                carga->insertarLote(bloque, enBloque);
+                enBloque = 0;
+            }
+            if (cascada != nullptr && cascada->rotar(instruccion.indice, instruccion.cantidad)) {
+                giros++;
+            } else {
+                girosInvalidos++;
+                PRT7_METRICA_ERROR(ERROR_ROTOR_INEXISTENTE);
+            }
+        }
+    }
+    if (enBloque > 0) {
+        if (cascada != nullptr) cascada->cifrarLote(bloque, enBloque);
+        carga->insertarLote(bloque, enBloque);
+    }
+
+    // Las métricas cuentan instrucciones: los MAP fundidos ya no existen por separado
+    PRT7_METRICA_TRAMAS(TRAMA_LOAD, cargadas);
+    PRT7_METRICA_TRAMAS(TRAMA_MAP, rotaciones);
+    PRT7_METRICA_TRAMAS(TRAMA_ROTOR, giros);
+    for (int e = 1; e < NUM_ERRORES_TRAMA; e++) {
+        for (long long n = 0; n < errores[e]; n++) PRT7_METRICA_ERROR((ErrorTrama)e);
+    }
+    return girosInvalidos;
+}
+
+bool ProgramaDeTramas::guardar(const char* ruta, const FirmaCaptura& firma) const {
+    // Instrucciones: etiqueta y varints; el inicio de cada racha se deduce al cargar
+    unsigned char* codigo = new unsigned char[(size_t)numInstrucciones * MAX_BYTES_INSTRUCCION + 1];
+    long long bytesCodigo = 0;
+    for (long long i = 0; i < numInstrucciones; i++) {
+        const Instruccion& instruccion = instrucciones[i];
+        codigo[bytesCodigo++] = (unsigned char)instruccion.tipo;
+        if (instruccion.tipo == INSTRUCCION_GIRAR) {
+            bytesCodigo += escribirVarint((unsigned int)instruccion.indice, codigo + bytesCodigo);
+            bytesCodigo += escribirVarint(codificarZigzag(instruccion.cantidad), codigo + bytesCodigo);
+        } else {
+            bytesCodigo += escribirVarint((unsigned int)instruccion.cantidad, codigo + bytesCodigo);
+        }
+    }
+    unsigned long long sumaDatos = sumaVerificacion(SUMA_INICIAL, codigo, bytesCodigo);
+    sumaDatos = sumaVerificacion(sumaDatos, (const unsigned char*)cargas, numCargas);
+
+    unsigned char cabecera[TAMANIO_CABECERA];
+    cabecera[0] = 'P';
+    cabecera[1] = '7';
+    cabecera[2] = 'I';
+    cabecera[3] = 'R';
+    escribirEntero(cabecera + 4, VERSION_PROGRAMA, 4);
+    escribirEntero(cabecera + 8, (unsigned int)tamanioRotor, 4);
+    escribirEntero(cabecera + 12, terminado ? 1 : 0, 4);
+    escribirEntero(cabecera + 16, (unsigned long long)firma.bytes, 8);
+    escribirEntero(cabecera + 24, (unsigned long long)firma.modificacion, 8);
+    escribirEntero(cabecera + 32, (unsigned long long)lineas, 8);
+    escribirEntero(cabecera + 40, (unsigned long long)invalidas, 8);
+    escribirEntero(cabecera + 48, (unsigned long long)numInstrucciones, 8);
+    escribirEntero(cabecera + 56, (unsigned long long)bytesCodigo, 8);
+    escribirEntero(cabecera + 64, (unsigned long long)numCargas, 8);
+    escribirEntero(cabecera + 72, sumaDatos, 8);
+    escribirEntero(cabecera + 80, NUM_ERRORES_TRAMA, 8);
+    for (int e = 0; e < NUM_ERRORES_TRAMA; e++) {
+        escribirEntero(cabecera + 88 + 8 * e, (unsigned long long)errores[e], 8);
+    }
+    escribirEntero(cabecera + TAMANIO_CABECERA - 8,
+                   sumaVerificacion(SUMA_INICIAL, cabecera, TAMANIO_CABECERA - 8), 8);
+
+    // Se escribe en un temporal y se renombra: un programa a medias nunca queda con el nombre final
+    size_t longitudRuta = strlen(ruta);
+    char* temporal = new char[longitudRuta + sizeof(".tmp")];
+    memcpy(temporal, ruta, longitudRuta);
+    memcpy(temporal + longitudRuta, ".tmp", sizeof(".tmp"));
+    FILE* archivo = fopen(temporal, "wb");
+    bool correcto = archivo != nullptr &&
+                    fwrite(cabecera, 1, TAMANIO_CABECERA, archivo) == (size_t)TAMANIO_CABECERA &&
+                    fwrite(codigo, 1, (size_t)bytesCodigo, archivo) == (size_t)bytesCodigo &&
+                    fwrite(cargas, 1, (size_t)numCargas, archivo) == (size_t)numCargas;
+    delete[] codigo;
+    if (archivo == nullptr) {
+        delete[] temporal;
+        return false;
+    }
+
+    correcto = (fclose(archivo) == 0) && correcto;
+    if (correcto) {
+#ifdef _WIN32
+        // rename() de Windows no reemplaza un archivo existente
+        remove(ruta);
+#endif
+        correcto = rename(temporal, ruta) == 0;
+    }
+    if (!correcto) remove(temporal);
+    delete[] temporal;
+    return correcto;
+}
+
+bool ProgramaDeTramas::cargar(const char* ruta, const FirmaCaptura& firma) {
+    vaciar();
+    FILE* archivo = fopen(ruta, "rb");
+    if (archivo == nullptr) return false;
+
+    unsigned char cabecera[TAMANIO_CABECERA];
+    bool valido = fread(cabecera, 1, TAMANIO_CABECERA, archivo) == (size_t)TAMANIO_CABECERA &&
+                  cabecera[0] == 'P' && cabecera[1] == '7' && cabecera[2] == 'I' && cabecera[3] == 'R' &&
+                  leerEntero(cabecera + 4, 4) == VERSION_PROGRAMA &&
+                  leerEntero(cabecera + TAMANIO_CABECERA - 8, 8) ==
+                      sumaVerificacion(SUMA_INICIAL, cabecera, TAMANIO_CABECERA - 8) &&
+                  (int)leerEntero(cabecera + 8, 4) == tamanioRotor &&
+                  (long long)leerEntero(cabecera + 16, 8) == firma.bytes &&
+                  (long long)leerEntero(cabecera + 24, 8) == firma.modificacion &&
+                  leerEntero(cabecera + 80, 8) == (unsigned long long)NUM_ERRORES_TRAMA;
+
+    long long instruccionesArchivo = valido ? (long long)leerEntero(cabecera + 48, 8) : 0;
+    long long bytesCodigo = valido ? (long long)leerEntero(cabecera + 56, 8) : 0;
+    long long cargasArchivo = valido ? (long long)leerEntero(cabecera + 64, 8) : 0;
+    // Ninguna captura produce más instrucciones ni cargas que bytes
+    if (instruccionesArchivo < 0 || instruccionesArchivo > firma.bytes ||
+        bytesCodigo < instruccionesArchivo || bytesCodigo > instruccionesArchivo * MAX_BYTES_INSTRUCCION ||
+        cargasArchivo < 0 || cargasArchivo > firma.bytes) {
+        valido = false;
+    }
+
+    unsigned char* codigo = nullptr;
+    if (valido) {
+        codigo = new unsigned char[(size_t)bytesCodigo + 1];
+        cargas = new char[(size_t)cargasArchivo + 1];
+        capCargas = cargasArchivo;
+        numCargas = cargasArchivo;
+        valido = fread(codigo, 1, (size_t)bytesCodigo, archivo) == (size_t)bytesCodigo &&
+                 fread(cargas, 1, (size_t)cargasArchivo, archivo) == (size_t)cargasArchivo &&
+                 fgetc(archivo) == EOF;
+    }
+    fclose(archivo);
+    if (valido) {
+        unsigned long long sumaDatos = sumaVerificacion(SUMA_INICIAL, codigo, bytesCodigo);
+        sumaDatos = sumaVerificacion(sumaDatos, (const unsigned char*)cargas, cargasArchivo);
+        valido = sumaDatos == leerEntero(cabecera + 72, 8);
+    }
+
+    if (valido && instruccionesArchivo > 0) {
+        instrucciones = new Instruccion[instruccionesArchivo];
+        capInstrucciones = instruccionesArchivo;
+        numInstrucciones = instruccionesArchivo;
+    }
+    const unsigned char* actual = codigo;
+    const unsigned char* fin = codigo + bytesCodigo;
+    long long inicio = 0;
+    for (long long i = 0; valido && i < instruccionesArchivo; i++) {
+        Instruccion& instruccion = instrucciones[i];
+        unsigned int tipo = actual < fin ? *actual++ : 0xFF;
+        unsigned int a = 0;
+        unsigned int b = 0;
+        instruccion.tipo = (TipoInstruccion)tipo;
+        instruccion.indice = 0;
+        instruccion.inicio = 0;
+        if (tipo == INSTRUCCION_GIRAR) {
+            valido = leerVarint(&actual, fin, &a) && leerVarint(&actual, fin, &b);
+            instruccion.indice = (int)a;
+            instruccion.cantidad = decodificarZigzag(b);
+        } else if (tipo == INSTRUCCION_CARGAR || tipo == INSTRUCCION_ROTAR) {
+            valido = leerVarint(&actual, fin, &a) && a <= (unsigned int)MAX_CARGAS_POR_INSTRUCCION;
+            instruccion.cantidad = (int)a;
+            if (tipo == INSTRUCCION_CARGAR) {
+                instruccion.inicio = inicio;
+                inicio += a;
+            }
+        } else {
+            valido = false;
+        }
+    }
+    // Las rachas deben cubrir exactamente el arreglo de cargas
+    valido = valido && actual == fin && inicio == cargasArchivo;
+    delete[] codigo;
+
+    if (!valido) {
+        vaciar();
+        return false;
+    }
+    terminado = leerEntero(cabecera + 12, 4) != 0;
+    lineas = (long long)leerEntero(cabecera + 32, 8);
+    invalidas = (long long)leerEntero(cabecera + 40, 8);
+    for (int e = 0; e < NUM_ERRORES_TRAMA; e++) {
+        errores[e] = (long long)leerEntero(cabecera + 88 + 8 * e, 8);
+    }
+    return true;
+}
+
+bool ProgramaDeTramas::leerFirma(const char* ruta, FirmaCaptura* firma) {
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(ruta, &info) != 0 || (info.st_mode & _S_IFREG) == 0) return false;
+    firma->bytes = (long long)info.st_size;
+    firma->modificacion = (long long)info.st_mtime * 1000000000LL;
+#else
+    struct stat info;
+    if (stat(ruta, &info) != 0 || !S_ISREG(info.st_mode)) return false;
+    firma->bytes = (long long)info.st_size;
+    firma->modificacion = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+long long ProgramaDeTramas::getNumInstrucciones() const {
+    return numInstrucciones;
+}
+
+const Instruccion& ProgramaDeTramas::getInstruccion(long long i) const {
+    return instrucciones[i];
+}
+
+long long ProgramaDeTramas::getNumCargas() const {
+    return numCargas;
+}
+
+long long ProgramaDeTramas::getLineas() const {
+    return lineas;
+}
+
+long long ProgramaDeTramas::getInvalidas() const {
+    return invalidas;
+}
+
+bool ProgramaDeTramas::estaTerminado() const {
+    return terminado;
+}
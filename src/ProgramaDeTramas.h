@@ -0,0 +1,208 @@
+/**
+ * @file ProgramaDeTramas.h
+ * @brief Representación intermedia compacta de una captura: rotaciones netas y rachas de cargas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef PROGRAMA_DE_TRAMAS_H
+#define PROGRAMA_DE_TRAMAS_H
+
+#include "TramaCompacta.h"
+
+class LectorCaptura;
+class RotorDeMapeo;
+class ListaDeCarga;
+
+/**
+ * @brief Operación de una instrucción del programa
+ */
+enum TipoInstruccion {
+    INSTRUCCION_ROTAR = 0, ///< Mover el rotor principal: cantidad = rotación neta en [1, tamaño)
+    INSTRUCCION_CARGAR,    ///< Decodificar cantidad cargas a partir del byte inicio
+    INSTRUCCION_GIRAR      ///< Trama R,k,N: indice = k, cantidad = N
+};
+
+/**
+ * @brief Una instrucción del programa
+ */
+struct Instruccion {
+    TipoInstruccion tipo; ///< Operación
+    int indice;           ///< Rotor de la cascada (sólo GIRAR)
+    int cantidad;         ///< Rotación (ROTAR y GIRAR) o número de cargas (CARGAR)
+    long long inicio;     ///< Primer byte de la racha en el arreglo de cargas (sólo CARGAR)
+};
+
+/**
+ * @brief Identifica la versión de una captura de la que se compiló un programa
+ */
+struct FirmaCaptura {
+    long long bytes;        ///< Tamaño de la captura
+    long long modificacion; ///< Fecha de modificación, en ns desde la época
+};
+
+/**
+ * @class ProgramaDeTramas
+ * @brief Flujo de tramas compilado a una lista corta de instrucciones
+ * @details Una captura típica son rachas largas de cargas separadas por uno o
+ *          más MAP. Al compilar, los MAP consecutivos se funden en una sola
+ *          rotación neta módulo el tamaño del rotor (y desaparecen si suman
+ *          cero), y cada racha de cargas se guarda como (inicio, cantidad)
+ *          sobre un arreglo contiguo con los caracteres sin decodificar. Las
+ *          tramas R,k,N se conservan una por una, porque su efecto depende de
+ *          la cascada que se use al ejecutar. Las líneas inválidas sólo se
+ *          cuentan.
+ *
+ *          ejecutar() decodifica cada racha de una vez con el kernel por
+ *          lotes del rotor, sin parsear ni despachar por trama, y junta
+ *          varias rachas por inserción en la lista. Da la misma carga que
+ *          la sesión de decodificación sobre la captura original.
+ *
+ *          El programa se puede guardar en disco junto con la firma (tamaño y
+ *          fecha) de la captura, para volver a decodificar una captura
+ *          archivada sin parsearla: cargar() rechaza el archivo si la firma o
+ *          el tamaño del rotor no coinciden.
+ */
+class ProgramaDeTramas {
+private:
+    Instruccion* instrucciones;   ///< Instrucciones en orden
+    long long numInstrucciones;   ///< Instrucciones usadas
+    long long capInstrucciones;   ///< Capacidad de instrucciones
+    char* cargas;                 ///< Caracteres de todas las cargas, en orden
+    long long numCargas;          ///< Caracteres usados
+    long long capCargas;          ///< Capacidad de cargas
+    int tamanioRotor;             ///< Módulo de las rotaciones netas
+    long long lineas;             ///< Líneas compiladas, incluidas las vacías y la de "END"
+    long long invalidas;          ///< Líneas inválidas
+    long long errores[NUM_ERRORES_TRAMA]; ///< Líneas inválidas por motivo
+    bool terminado;               ///< Se compiló una línea "END"
+
+    /**
+     * @brief Agrega una instrucción al final, ampliando el arreglo si hace falta
+     * @return Instrucción agregada (sin inicializar)
+     */
+    Instruccion* agregarInstruccion();
+
+    /**
+     * @brief Asegura espacio para más caracteres de carga
+     * @param adicionales Caracteres que se van a agregar
+     */
+    void reservarCargas(long long adicionales);
+
+    /**
+     * @brief Libera todo y deja el programa vacío
+     */
+    void vaciar();
+
+public:
+    static const int MAX_CARGAS_POR_INSTRUCCION = 1 << 30; ///< Tope de una racha; las más largas se dividen
+
+    /**
+     * @brief Constructor: programa vacío
+     * @param tamanio Tamaño del rotor con el que se ejecutará (módulo de las rotaciones)
+     */
+    ProgramaDeTramas(int tamanio);
+
+    /**
+     * @brief Destructor: libera los arreglos
+     */
+    ~ProgramaDeTramas();
+
+    /**
+     * @brief Reserva espacio para compilar una captura de un tamaño conocido
+     * @param bytesCaptura Tamaño de la captura en bytes
+     * @details Evita las copias por crecimiento de los arreglos: cada carga
+     *          ocupa al menos 4 bytes de la captura ("L,X\n"), así que el
+     *          arreglo de cargas nunca crece; para las instrucciones se
+     *          estima una cada 16 bytes.
+     */
+    void reservar(long long bytesCaptura);
+
+    /**
+     * @brief Agrega tramas clasificadas al final del programa
+     * @param tramas Tramas en orden de llegada (las inválidas traen el motivo en valor)
+     * @param cantidad Número de tramas
+     * @details Se puede llamar varias veces: una racha o una rotación que
+     *          quedó abierta se continúa con las tramas siguientes.
+     */
+    void compilar(const TramaCompacta* tramas, int cantidad);
+
+    /**
+     * @brief Compila una captura de texto completa, hasta "END" o el final
+     * @param captura Captura abierta, posicionada al inicio
+     * @return false si la captura está en formato binario o es de tramas numeradas
+     */
+    bool compilarCaptura(LectorCaptura* captura);
+
+    /**
+     * @brief Aplica el programa a un rotor y una lista de carga
+     * @param rotor Rotor (con su cascada, si tiene) en el estado inicial
+     * @param carga Lista donde se insertan los caracteres decodificados
+     * @return Tramas R,k,N inválidas para la cascada del rotor
+     */
+    long long ejecutar(RotorDeMapeo* rotor, ListaDeCarga* carga) const;
+
+    /**
+     * @brief Guarda el programa en un archivo
+     * @param ruta Archivo a crear (se reemplaza)
+     * @param firma Firma de la captura compilada
+     * @return false si no se pudo escribir
+     */
+    bool guardar(const char* ruta, const FirmaCaptura& firma) const;
+
+    /**
+     * @brief Carga un programa guardado con guardar()
+     * @param ruta Archivo a leer
+     * @param firma Firma que debe tener la captura
+     * @return false si el archivo no existe, está dañado o no corresponde a
+     *         la captura o al tamaño del rotor (el programa queda vacío)
+     */
+    bool cargar(const char* ruta, const FirmaCaptura& firma);
+
+    /**
+     * @brief Obtiene la firma actual de una captura en disco
+     * @param ruta Archivo de la captura
+     * @param firma Recibe la firma
+     * @return false si el archivo no existe o no es un archivo regular
+     */
+    static bool leerFirma(const char* ruta, FirmaCaptura* firma);
+
+    /**
+     * @brief Obtiene el número de instrucciones
+     * @return Instrucciones del programa
+     */
+    long long getNumInstrucciones() const;
+
+    /**
+     * @brief Obtiene la instrucción número i
+     * @param i Índice en [0, getNumInstrucciones())
+     * @return Instrucción
+     */
+    const Instruccion& getInstruccion(long long i) const;
+
+    /**
+     * @brief Obtiene el número de caracteres de carga
+     * @return Cargas compiladas
+     */
+    long long getNumCargas() const;
+
+    /**
+     * @brief Obtiene las líneas compiladas
+     * @return Líneas, incluidas las vacías, las inválidas y la de "END"
+     */
+    long long getLineas() const;
+
+    /**
+     * @brief Obtiene las líneas inválidas
+     * @return Líneas que no eran tramas válidas
+     */
+    long long getInvalidas() const;
+
+    /**
+     * @brief Verifica si la compilación llegó a una línea "END"
+     * @return true si ya no se deben compilar más tramas
+     */
+    bool estaTerminado() const;
+};
+
+#endif // PROGRAMA_DE_TRAMAS_H
@@ -0,0 +1,201 @@
+/**
+ * @file PuntoDeControl.cpp
+ * @brief Implementación de la clase PuntoDeControl
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "PuntoDeControl.h"
+#include "ListaDeCarga.h"
+#include "CodificacionEnteros.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+static const unsigned int VERSION_REGISTRO = 3;
+
+/**
+ * @brief Suma de verificación FNV-1a de 32 bits
+ */
+static unsigned int sumaVerificacion(const unsigned char* datos, int cantidad) {
+    unsigned int suma = 2166136261u;
+    for (int i = 0; i < cantidad; i++) {
+        suma = (suma ^ datos[i]) * 16777619u;
+    }
+    return suma;
+}
+
+/**
+ * @brief Recorta un archivo abierto a una longitud
+ */
+static bool truncarArchivo(FILE* archivo, long long longitud) {
+    // El fseek descarta lo leído por adelantado y deja el flujo listo para escribir
+    if (fseek(archivo, 0, SEEK_END) != 0) return false;
+#ifdef _WIN32
+    bool recortado = _chsize_s(_fileno(archivo), longitud) == 0;
+#else
+    bool recortado = ftruncate(fileno(archivo), (off_t)longitud) == 0;
+#endif
+    return fseek(archivo, 0, SEEK_END) == 0 && recortado;
+}
+
+/**
+ * @brief Longitud actual de un archivo abierto
+ */
+static long long longitudArchivo(FILE* archivo) {
+    if (fseek(archivo, 0, SEEK_END) != 0) return -1;
+    return (long long)ftell(archivo);
+}
+
+/**
+ * @brief Concatena la base y la extensión de un archivo del punto de control
+ * @return Ruta en memoria dinámica; el llamador la libera con delete[]
+ */
+static char* componerRuta(const char* base, const char* extension) {
+    size_t longitudBase = strlen(base);
+    size_t longitudExtension = strlen(extension);
+    char* ruta = new char[longitudBase + longitudExtension + 1];
+    memcpy(ruta, base, longitudBase);
+    memcpy(ruta + longitudBase, extension, longitudExtension + 1);
+    return ruta;
+}
+
+PuntoDeControl::PuntoDeControl(const char* base, const FirmaCaptura& firmaCaptura)
+    : registro(nullptr), archivoCarga(nullptr), cargaEscrita(0), guardados(0),
+      buffer(nullptr), hayEstado(false), firma(firmaCaptura) {
+    char* rutaRegistro = componerRuta(base, ".ckpt");
+    char* rutaCarga = componerRuta(base, ".carga");
+
+    // "a+b": se puede leer cualquier posición y toda escritura se anexa
+    registro = fopen(rutaRegistro, "a+b");
+    archivoCarga = fopen(rutaCarga, "a+b");
+    delete[] rutaRegistro;
+    delete[] rutaCarga;
+    if (registro == nullptr || archivoCarga == nullptr) {
+        std::cerr << "Error: No se pudo abrir el punto de control " << base << std::endl;
+        return;
+    }
+    buffer = new char[TAMANIO_BUFFER];
+
+    long long registros = longitudArchivo(registro) / TAMANIO_REGISTRO;
+    long long longitudCarga = longitudArchivo(archivoCarga);
+
+    // Normalmente el último registro es válido y el ciclo da una sola vuelta
+    long long vigente = registros - 1;
+    while (vigente >= 0) {
+        if (leerRegistro(vigente, &ultimo) && ultimo.bytesCarga <= longitudCarga) break;
+        vigente--;
+    }
+    hayEstado = (vigente >= 0);
+    cargaEscrita = hayEstado ? ultimo.bytesCarga : 0;
+
+    if (!truncarArchivo(registro, (vigente + 1) * TAMANIO_REGISTRO) ||
+        !truncarArchivo(archivoCarga, cargaEscrita)) {
+        std::cerr << "Error: No se pudo recortar el punto de control " << base << std::endl;
+    }
+}
+
+PuntoDeControl::~PuntoDeControl() {
+    if (registro != nullptr) fclose(registro);
+    if (archivoCarga != nullptr) fclose(archivoCarga);
+    delete[] buffer;
+}
+
+bool PuntoDeControl::leerRegistro(long long indice, EstadoSesion* estado) {
+    unsigned char datos[TAMANIO_REGISTRO];
+    if (fseek(registro, (long)(indice * TAMANIO_REGISTRO), SEEK_SET) != 0) return false;
+    if (fread(datos, 1, TAMANIO_REGISTRO, registro) != (size_t)TAMANIO_REGISTRO) return false;
+
+    if (datos[0] != 'P' || datos[1] != 'R' || datos[2] != 'T' || datos[3] != '7') return false;
+    if (leerEntero(datos + 4, 4) != VERSION_REGISTRO) return false;
+    if (leerEntero(datos + 76, 4) != sumaVerificacion(datos, 76)) return false;
+
+    estado->secuencia = (long long)leerEntero(datos + 8, 8);
+    estado->invalidas = (long long)leerEntero(datos + 16, 8);
+    estado->bytesEntrada = (long long)leerEntero(datos + 24, 8);
+    estado->bytesCarga = (long long)leerEntero(datos + 32, 8);
+    estado->posicionRotor = (int)leerEntero(datos + 40, 4);
+    estado->tamanioRotor = (int)leerEntero(datos + 44, 4);
+    estado->formato = (int)leerEntero(datos + 48, 4);
+    estado->siguienteSecuencia = (unsigned int)leerEntero(datos + 52, 4);
+    estado->secuenciaIniciada = leerEntero(datos + 56, 4) != 0;
+    estado->firma.bytes = (long long)leerEntero(datos + 60, 8);
+    estado->firma.modificacion = (long long)leerEntero(datos + 68, 8);
+    return true;
+}
+
+bool PuntoDeControl::estaAbierto() const {
+    return buffer != nullptr;
+}
+
+bool PuntoDeControl::leerUltimo(EstadoSesion* estado) const {
+    if (!hayEstado) return false;
+    *estado = ultimo;
+    return true;
+}
+
+bool PuntoDeControl::esDeLaCaptura() const {
+    return !hayEstado || (ultimo.firma.bytes == firma.bytes && ultimo.firma.modificacion == firma.modificacion);
+}
+
+bool PuntoDeControl::imprimirCarga(std::ostream& salida, long long bytes) {
+    if (!estaAbierto() || fseek(archivoCarga, 0, SEEK_SET) != 0) return false;
+    long long restantes = bytes;
+    while (restantes > 0) {
+        size_t pedir = restantes < TAMANIO_BUFFER ? (size_t)restantes : (size_t)TAMANIO_BUFFER;
+        size_t leidos = fread(buffer, 1, pedir, archivoCarga);
+        if (leidos == 0) return false;
+        salida.write(buffer, (std::streamsize)leidos);
+        restantes -= (long long)leidos;
+    }
+    // Las escrituras siguientes requieren reposicionar el flujo después de leer
+    return fseek(archivoCarga, 0, SEEK_END) == 0;
+}
+
+bool PuntoDeControl::guardar(const EstadoSesion& estado, const ListaDeCarga* carga) {
+    if (!estaAbierto()) return false;
+
+    // Primero la carga nueva: un registro nunca apunta a carga que falte. Al
+    // reanudar, la lista sólo tiene lo insertado después de la carga guardada
+    long long total = carga->getTotal();
+    long long enArchivo = total - carga->getTamanio();
+    while (cargaEscrita < total) {
+        long long n = carga->copiarDesde(cargaEscrita - enArchivo, buffer, TAMANIO_BUFFER);
+        if (n <= 0 || fwrite(buffer, 1, (size_t)n, archivoCarga) != (size_t)n) return false;
+        cargaEscrita += n;
+    }
+    if (fflush(archivoCarga) != 0) return false;
+
+    unsigned char datos[TAMANIO_REGISTRO];
+    datos[0] = 'P';
+    datos[1] = 'R';
+    datos[2] = 'T';
+    datos[3] = '7';
+    escribirEntero(datos + 4, VERSION_REGISTRO, 4);
+    escribirEntero(datos + 8, (unsigned long long)estado.secuencia, 8);
+    escribirEntero(datos + 16, (unsigned long long)estado.invalidas, 8);
+    escribirEntero(datos + 24, (unsigned long long)estado.bytesEntrada, 8);
+    escribirEntero(datos + 32, (unsigned long long)cargaEscrita, 8);
+    escribirEntero(datos + 40, (unsigned int)estado.posicionRotor, 4);
+    escribirEntero(datos + 44, (unsigned int)estado.tamanioRotor, 4);
+    escribirEntero(datos + 48, (unsigned int)estado.formato, 4);
+    escribirEntero(datos + 52, estado.siguienteSecuencia, 4);
+    escribirEntero(datos + 56, estado.secuenciaIniciada ? 1 : 0, 4);
+    escribirEntero(datos + 60, (unsigned long long)firma.bytes, 8);
+    escribirEntero(datos + 68, (unsigned long long)firma.modificacion, 8);
+    escribirEntero(datos + 76, sumaVerificacion(datos, 76), 4);
+
+    if (fwrite(datos, 1, TAMANIO_REGISTRO, registro) != (size_t)TAMANIO_REGISTRO) return false;
+    if (fflush(registro) != 0) return false;
+    guardados++;
+    return true;
+}
+
+long long PuntoDeControl::getGuardados() const {
+    return guardados;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file PuntoDeControl.h
+ * @brief Puntos de control del estado de una sesión para reanudar sin repetir la captura
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef PUNTO_DE_CONTROL_H
+#define PUNTO_DE_CONTROL_H
+
+#include <cstdio>
+#include <ostream>
+#include "ProgramaDeTramas.h"
+
+class ListaDeCarga;
+
+/**
+ * @brief Estado de una sesión en el instante de un punto de control
+ */
+struct EstadoSesion {
+    long long secuencia;    ///< Líneas (o tramas binarias) consumidas
+    long long invalidas;    ///< Tramas inválidas hasta ese momento
+    long long bytesEntrada; ///< Bytes consumidos de la fuente, o -1 si no se puede posicionar
+    long long bytesCarga;   ///< Caracteres de carga decodificados
+    int posicionRotor;      ///< Desplazamiento de la posición cero del rotor
+    int tamanioRotor;       ///< Tamaño del rotor (para validar al reanudar)
+    int formato;            ///< Formato detectado del flujo
+    bool secuenciaIniciada; ///< Las tramas numeradas ya tienen inicio fijo
+    unsigned int siguienteSecuencia; ///< Número de la siguiente trama numerada a entregar
+    FirmaCaptura firma;     ///< Captura de la que se leyó (bytes = -1 si no es un archivo regular)
+};
+
+/**
+ * @class PuntoDeControl
+ * @brief Registro de sólo-anexar del estado de una sesión
+ * @details Usa dos archivos a partir de una ruta base:
+ *          - BASE.ckpt: registros de tamaño fijo con el estado y una suma de
+ *            verificación; el vigente es el último válido, así que leerlo no
+ *            depende de cuántos puntos de control se hayan escrito.
+ *          - BASE.carga: los caracteres decodificados; cada punto de control
+ *            sólo anexa los nuevos desde el anterior.
+ *          La carga se escribe antes que el registro, de modo que un registro
+ *          válido siempre tiene su carga completa. Un registro cortado por una
+ *          caída se descarta y se usa el anterior. Los archivos se vacían con
+ *          fflush (sobreviven a la caída del proceso) pero no se sincronizan
+ *          con el disco en cada punto de control. Cada registro anota la
+ *          firma de la captura (tamaño y fecha de modificación), para no
+ *          reanudar con el punto de control de otra captura.
+ */
+class PuntoDeControl {
+private:
+    FILE* registro;           ///< Archivo BASE.ckpt
+    FILE* archivoCarga;       ///< Archivo BASE.carga
+    long long cargaEscrita;   ///< Caracteres de carga ya anexados
+    long long guardados;      ///< Puntos de control escritos en esta ejecución
+    char* buffer;             ///< Buffer de copia de la carga
+    bool hayEstado;           ///< Se encontró un punto de control válido al abrir
+    EstadoSesion ultimo;      ///< Último punto de control válido
+    FirmaCaptura firma;       ///< Firma de la captura que se anota en cada registro
+
+    /**
+     * @brief Lee y valida el registro número indice
+     * @param indice Posición del registro en BASE.ckpt
+     * @param estado Recibe el estado si el registro es válido
+     * @return true si el registro es válido
+     */
+    bool leerRegistro(long long indice, EstadoSesion* estado);
+
+public:
+    static const int TAMANIO_REGISTRO = 80;       ///< Bytes por registro en BASE.ckpt
+    static const int TAMANIO_BUFFER = 64 * 1024;  ///< Bytes de carga copiados por escritura
+
+    /**
+     * @brief Constructor: abre (o crea) los archivos y busca el último punto de control
+     * @param base Ruta base; se agregan las extensiones .ckpt y .carga
+     * @param firmaCaptura Firma de la captura de la sesión (bytes = -1 si la
+     *        fuente no es un archivo regular); se anota en cada registro
+     * @details Lee el último registro y, sólo si está dañado, los anteriores.
+     *          Descarta los registros inválidos del final y la carga escrita
+     *          después del registro elegido, para que los siguientes puntos de
+     *          control se anexen sobre un estado consistente.
+     */
+    PuntoDeControl(const char* base, const FirmaCaptura& firmaCaptura);
+
+    /**
+     * @brief Destructor: cierra los archivos
+     */
+    ~PuntoDeControl();
+
+    /**
+     * @brief Verifica si los archivos se abrieron correctamente
+     * @return true si se pueden leer y escribir
+     */
+    bool estaAbierto() const;
+
+    /**
+     * @brief Obtiene el último punto de control válido
+     * @param estado Recibe el estado
+     * @return true si había un punto de control válido
+     */
+    bool leerUltimo(EstadoSesion* estado) const;
+
+    /**
+     * @brief Indica si el último punto de control es de la captura actual
+     * @return false si se guardó con otra firma (la captura cambió o es otra)
+     */
+    bool esDeLaCaptura() const;
+
+    /**
+     * @brief Escribe en un flujo los primeros caracteres guardados
+     * @param salida Flujo de destino
+     * @param bytes Caracteres a escribir (a lo sumo los del último punto de control)
+     * @return true si se pudieron leer todos
+     * @details Lee BASE.carga por bloques de TAMANIO_BUFFER: la carga de una
+     *          sesión reanudada no se copia a memoria (ListaDeCarga::reanudarDesde()).
+     */
+    bool imprimirCarga(std::ostream& salida, long long bytes);
+
+    /**
+     * @brief Escribe un punto de control
+     * @param estado Estado de la sesión
+     * @param carga Carga de la sesión; sólo se anexan los caracteres nuevos
+     *        (getTotal() cuenta la carga de la que se reanudó)
+     * @return true si se escribió
+     */
+    bool guardar(const EstadoSesion& estado, const ListaDeCarga* carga);
+
+    /**
+     * @brief Obtiene cuántos puntos de control se escribieron en esta ejecución
+     * @return Puntos de control escritos
+     */
+    long long getGuardados() const;
+};
+
+#endif // PUNTO_DE_CONTROL_H
@@ -0,0 +1,112 @@
+/**
+ * @file Registro.cpp
+ * @brief Implementación del registro por niveles con salida en buffer
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "Registro.h"
+#include <cstdio>
+#include <cstring>
+#include <streambuf>
+
+/**
+ * @class BufferRegistro
+ * @brief streambuf que acumula la salida y la escribe a stdout en bloques
+ */
+class BufferRegistro : public std::streambuf {
+private:
+    static const int CAPACIDAD = 1 << 16; ///< Tamaño del buffer (64 KB)
+    char datos[CAPACIDAD];
+
+    /**
+     * @brief Escribe el contenido pendiente a stdout
+     */
+    void escribirPendiente() {
+        std::ptrdiff_t n = pptr() - pbase();
+        if (n > 0) {
+            fwrite(pbase(), 1, (size_t)n, stdout);
+        }
+        setp(datos, datos + CAPACIDAD);
+    }
+
+protected:
+    virtual int_type overflow(int_type c) override {
+        escribirPendiente();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    virtual std::streamsize xsputn(const char* s, std::streamsize n) override {
+        if (n >= CAPACIDAD) {
+            // Bloques grandes (p. ej. el mensaje final) se escriben directamente
+            escribirPendiente();
+            fwrite(s, 1, (size_t)n, stdout);
+            return n;
+        }
+        if (epptr() - pptr() < n) {
+            escribirPendiente();
+        }
+        memcpy(pptr(), s, (size_t)n);
+        pbump((int)n);
+        return n;
+    }
+
+    virtual int sync() override {
+        escribirPendiente();
+        fflush(stdout);
+        return 0;
+    }
+
+public:
+    BufferRegistro() {
+        setp(datos, datos + CAPACIDAD);
+    }
+
+    ~BufferRegistro() {
+        sync();
+    }
+};
+
+NivelRegistro Registro::nivelActual = REGISTRO_TRAZA;
+
+/**
+ * @brief Obtiene el buffer compartido (se crea en el primer uso)
+ */
+static BufferRegistro& bufferCompartido() {
+    static BufferRegistro buffer;
+    return buffer;
+}
+
+void Registro::setNivel(NivelRegistro nivel) {
+    nivelActual = nivel;
+}
+
+NivelRegistro Registro::getNivel() {
+    return nivelActual;
+}
+
+std::ostream& Registro::salida() {
+    static std::ostream flujo(&bufferCompartido());
+    return flujo;
+}
+
+void Registro::vaciar() {
+    salida().flush();
+}
+
+bool Registro::interpretarNivel(const char* texto, NivelRegistro* nivel) {
+    if (strcmp(texto, "silencioso") == 0) {
+        *nivel = REGISTRO_SILENCIOSO;
+    } else if (strcmp(texto, "resumen") == 0) {
+        *nivel = REGISTRO_RESUMEN;
+    } else if (strcmp(texto, "traza") == 0) {
+        *nivel = REGISTRO_TRAZA;
+    } else {
+        return false;
+    }
+    return true;
+}
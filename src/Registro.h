@@ -0,0 +1,98 @@
+/**
+ * @file Registro.h
+ * @brief Registro por niveles con salida en buffer para el decodificador PRT-7
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <ostream>
+
+/**
+ * @brief Niveles de detalle del registro
+ */
+enum NivelRegistro {
+    REGISTRO_SILENCIOSO = 0, ///< Sólo el mensaje final y los errores
+    REGISTRO_RESUMEN = 1,    ///< Inicialización, inicio/fin de secuencias y totales
+    REGISTRO_TRAZA = 2       ///< Además, una línea O(1) por trama procesada
+};
+
+/**
+ * @brief Nivel máximo compilado; los mensajes por encima se eliminan en compilación
+ * @details Se puede fijar desde CMake con -DPRT7_NIVEL_REGISTRO_MAXIMO=0|1|2.
+ */
+#ifndef PRT7_NIVEL_REGISTRO_MAXIMO
+    #define PRT7_NIVEL_REGISTRO_MAXIMO 2
+#endif
+
+/**
+ * @class Registro
+ * @brief Punto único de salida del programa
+ * @details Todo lo que antes se escribía con std::cout pasa por salida(), un
+ *          std::ostream sobre un buffer de 64 KB que sólo se vacía al llenarse,
+ *          al llamar vaciar() o al terminar el programa. Los errores siguen
+ *          yendo a std::cerr sin buffer. La salida no está sincronizada entre
+ *          hilos: los caminos multihilo no registran por trama.
+ */
+class Registro {
+private:
+    static NivelRegistro nivelActual; ///< Nivel elegido en tiempo de ejecución
+
+public:
+    /**
+     * @brief Cambia el nivel de registro en tiempo de ejecución
+     * @param nivel Nuevo nivel
+     */
+    static void setNivel(NivelRegistro nivel);
+
+    /**
+     * @brief Obtiene el nivel de registro vigente
+     * @return Nivel actual
+     */
+    static NivelRegistro getNivel();
+
+    /**
+     * @brief Indica si un mensaje de cierto nivel debe emitirse
+     * @param nivel Nivel del mensaje
+     * @return true si el nivel está compilado y habilitado
+     * @details Se define en el header para que la comprobación se resuelva en
+     *          línea en el camino crítico.
+     */
+    static bool habilitado(NivelRegistro nivel) {
+        return nivel <= PRT7_NIVEL_REGISTRO_MAXIMO && nivel <= nivelActual;
+    }
+
+    /**
+     * @brief Flujo de salida con buffer
+     * @return Referencia al flujo compartido
+     */
+    static std::ostream& salida();
+
+    /**
+     * @brief Escribe en la salida estándar todo lo pendiente en el buffer
+     */
+    static void vaciar();
+
+    /**
+     * @brief Convierte un texto a nivel de registro
+     * @param texto "silencioso", "resumen" o "traza"
+     * @param nivel Recibe el nivel reconocido
+     * @return true si el texto es válido
+     */
+    static bool interpretarNivel(const char* texto, NivelRegistro* nivel);
+};
+
+/**
+ * @brief Emite un mensaje si el nivel está habilitado
+ * @details El mensaje sólo se evalúa cuando el nivel está activo, y desaparece
+ *          por completo si supera PRT7_NIVEL_REGISTRO_MAXIMO.
+ */
+#define PRT7_REGISTRO(nivel, mensaje) \
+    do { if (Registro::habilitado(nivel)) { Registro::salida() << mensaje; } } while (0)
+
+#define PRT7_RESUMEN(mensaje) PRT7_REGISTRO(REGISTRO_RESUMEN, mensaje)
+#define PRT7_TRAZA(mensaje) PRT7_REGISTRO(REGISTRO_TRAZA, mensaje)
+
+#endif // REGISTRO_H
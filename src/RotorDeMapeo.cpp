@@ -6,7 +6,33 @@
  */
 
 #include "RotorDeMapeo.h"
+#include "RotorGenerico.h"
+#include "DecodificacionLote.h"
+#include "CascadaDeRotores.h"
+#include "Registro.h"
 #include <iostream>
+#include <cstring>
+
+/**
+ * @brief Describe un alfabeto con las tablas que RotorGenerico calcula al compilar
+ * @tparam Alfabeto Tipo con TAMANIO y simbolo(i)
+ */
+template <typename Alfabeto>
+static constexpr AlfabetoRotor describirAlfabeto(const char* nombre) {
+    return AlfabetoRotor{ nombre, RotorGenerico<Alfabeto>::TAMANIO,
+                          RotorGenerico<Alfabeto>::getTablas().indice,
+                          RotorGenerico<Alfabeto>::getTablas().simbolo };
+}
+
+/// Alfabetos que se pueden elegir; el primero (A-Z) es el de RotorGenerico<>
+static const AlfabetoRotor ALFABETOS[] = {
+    describirAlfabeto<AlfabetoMayusculas>("mayusculas"),
+    describirAlfabeto<AlfabetoMinusculas>("minusculas"),
+    describirAlfabeto<AlfabetoAlfanumerico>("alfanumerico"),
+    describirAlfabeto<AlfabetoBase64>("base64"),
+    describirAlfabeto<AlfabetoBytes>("bytes")
+};
+static const int NUM_ALFABETOS = sizeof(ALFABETOS) / sizeof(ALFABETOS[0]);
 
 /**
  * @brief Constructor del nodo
@@ -17,32 +43,86 @@ NodoRotor::NodoRotor(char c) : dato(c), siguiente(nullptr), anterior(nullptr) {}
 /**
  * @brief Constructor que inicializa el rotor con el alfabeto A-Z
  */
-RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
-    for (char c = 'A'; c <= 'Z'; c++) {
-        insertarCaracter(c);
+RotorDeMapeo::RotorDeMapeo()
+    : cabeza(nullptr), tamanio(0), posicionCero(0), alfabeto(&ALFABETOS[0]), cascada(nullptr) {
+    for (int i = 0; i < alfabeto->tamanio; i++) {
+        insertarCaracter((char)alfabeto->simbolos[i]);
     }
-    std::cout << "RotorDeMapeo inicializado con alfabeto A-Z. Posición inicial: A" << std::endl;
+    PRT7_RESUMEN("RotorDeMapeo inicializado con alfabeto A-Z. Posición inicial: A\n");
 }
 
 /**
  * @brief Destructor que libera toda la memoria
  */
 RotorDeMapeo::~RotorDeMapeo() {
-    if (cabeza == nullptr) return;
+    vaciar();
+}
+
+/**
+ * @brief Libera los nodos de la lista circular y deja el rotor vacío
+ */
+void RotorDeMapeo::vaciar() {
+    if (cabeza != nullptr) {
+        NodoRotor* actual = cabeza;
+        do {
+            NodoRotor* siguiente = actual->siguiente;
+            delete actual;
+            actual = siguiente;
+        } while (actual != cabeza);
+    }
+    cabeza = nullptr;
+    tamanio = 0;
+    posicionCero = 0;
+}
+
+/**
+ * @brief Busca un alfabeto por nombre
+ * @param nombre Nombre del alfabeto
+ * @return Descripción del alfabeto, o nullptr si no existe
+ */
+const AlfabetoRotor* RotorDeMapeo::buscarAlfabeto(const char* nombre) {
+    for (int i = 0; i < NUM_ALFABETOS; i++) {
+        if (strcmp(ALFABETOS[i].nombre, nombre) == 0) return &ALFABETOS[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Reemplaza el alfabeto del rotor
+ * @param nuevo Alfabeto a usar (nullptr = A-Z)
+ */
+void RotorDeMapeo::setAlfabeto(const AlfabetoRotor* nuevo) {
+    if (nuevo == nullptr) nuevo = &ALFABETOS[0];
+    if (nuevo == alfabeto) return;
     
-    NodoRotor* actual = cabeza;
-    do {
-        NodoRotor* siguiente = actual->siguiente;
-        delete actual;
-        actual = siguiente;
-    } while (actual != cabeza);
+    vaciar();
+    alfabeto = nuevo;
+    for (int i = 0; i < alfabeto->tamanio; i++) {
+        insertarCaracter((char)alfabeto->simbolos[i]);
+    }
+    PRT7_RESUMEN("Alfabeto del rotor: " << alfabeto->nombre << " (" << alfabeto->tamanio << " símbolos)\n");
+}
+
+/**
+ * @brief Obtiene el alfabeto base del rotor
+ * @return Descripción del alfabeto
+ */
+const AlfabetoRotor* RotorDeMapeo::getAlfabeto() const {
+    return alfabeto;
 }
 
 /**
  * @brief Inserta un carácter al final de la lista circular
  * @param c Carácter a insertar
+ * @details El carácter queda justo antes de la posición cero actual, tanto en la
+ *          lista circular como en la tabla contigua.
  */
 void RotorDeMapeo::insertarCaracter(char c) {
+    if (tamanio >= CAPACIDAD_MAXIMA) {
+        std::cerr << "Error: Rotor lleno, no se puede insertar '" << c << "'" << std::endl;
+        return;
+    }
+    
     NodoRotor* nuevo = new NodoRotor(c);
     
     if (cabeza == nullptr) {
@@ -50,11 +130,24 @@ void RotorDeMapeo::insertarCaracter(char c) {
         nuevo->siguiente = nuevo;
         nuevo->anterior = nuevo;
     } else {
-        NodoRotor* ultimo = cabeza->anterior;
-        nuevo->siguiente = cabeza;
+        NodoRotor* cero = cabeza;
+        for (int i = 0; i < posicionCero; i++) {
+            cero = cero->siguiente;
+        }
+        NodoRotor* ultimo = cero->anterior;
+        nuevo->siguiente = cero;
         nuevo->anterior = ultimo;
         ultimo->siguiente = nuevo;
-        cabeza->anterior = nuevo;
+        cero->anterior = nuevo;
+    }
+    
+    if (posicionCero == 0) {
+        tabla[tamanio] = c;
+    } else {
+        // Insertar antes de la posición cero y desplazar el resto de la tabla
+        memmove(&tabla[posicionCero + 1], &tabla[posicionCero], tamanio - posicionCero);
+        tabla[posicionCero] = c;
+        posicionCero++;
     }
     tamanio++;
 }
@@ -62,60 +155,164 @@ void RotorDeMapeo::insertarCaracter(char c) {
 /**
  * @brief Rota el rotor N posiciones
  * @param n Número de posiciones a rotar (positivo = horario, negativo = antihorario)
+ * @details Sólo actualiza el desplazamiento entero; no recorre nodos.
  */
 void RotorDeMapeo::rotar(int n) {
     if (cabeza == nullptr) return;
     
-    std::cout << "Rotando rotor " << n << " posiciones. ";
-    
+    int solicitado = n;
     n = n % tamanio;
     if (n < 0) n += tamanio;
     
-    for (int i = 0; i < n; i++) {
-        cabeza = cabeza->siguiente;
-    }
+    posicionCero += n;
+    if (posicionCero >= tamanio) posicionCero -= tamanio;
     
-    std::cout << "Nueva posición cero: '" << cabeza->dato << "'" << std::endl;
+    PRT7_TRAZA("Rotando rotor " << solicitado << " posiciones. Nueva posición cero: '"
+               << tabla[posicionCero] << "'\n");
 }
 
 /**
- * @brief Obtiene el mapeo de un carácter según la rotación actual
+ * @brief Obtiene el mapeo de una carga según la rotación actual
  * @param entrada Carácter de entrada
- * @return Carácter mapeado según la posición actual del rotor
+ * @return Carácter mapeado según la posición actual del rotor y la cascada
  */
 char RotorDeMapeo::getMapeo(char entrada) {
+    char mapeado = getMapeoEn(entrada, posicionCero);
+    return cascada != nullptr ? cascada->cifrar(mapeado) : mapeado;
+}
+
+/**
+ * @brief Obtiene el mapeo de un carácter como si la posición cero fuera otra
+ * @param entrada Carácter de entrada
+ * @param posicion Desplazamiento de la posición cero a usar, en [0, tamanio)
+ * @return Carácter mapeado
+ */
+char RotorDeMapeo::getMapeoEn(char entrada, int posicion) const {
     if (cabeza == nullptr) return entrada;
     
-    if (entrada < 'A' || entrada > 'Z') {
+    // Índice del carácter en el alfabeto base (tabla calculada al compilar)
+    int indice = alfabeto->indice[(unsigned char)entrada];
+    if (indice < 0) {
         return entrada;
     }
     
-    int posicionOriginal = entrada - 'A';
+    indice += posicion;
+    if (indice >= tamanio) indice %= tamanio;
     
-    NodoRotor* actual = cabeza;
-    for (int i = 0; i < posicionOriginal; i++) {
-        actual = actual->siguiente;
+    return tabla[indice];
+}
+
+/**
+ * @brief Obtiene el mapeo de un lote de caracteres con la rotación actual
+ * @param entrada Caracteres de entrada
+ * @param salida Destino de los caracteres mapeados
+ * @param cantidad Número de caracteres
+ */
+void RotorDeMapeo::getMapeoLote(const char* entrada, char* salida, int cantidad) const {
+    if (esAlfabetoEstandar()) {
+        decodificarLote(entrada, salida, cantidad, posicionCero);
+        return;
     }
-    
-    return actual->dato;
+    for (int i = 0; i < cantidad; i++) {
+        salida[i] = getMapeoEn(entrada[i], posicionCero);
+    }
+}
+
+/**
+ * @brief Indica si el rotor contiene exactamente el alfabeto A-Z en orden
+ * @return true si el mapeo equivale a un desplazamiento módulo 26
+ */
+bool RotorDeMapeo::esAlfabetoEstandar() const {
+    if (alfabeto != &ALFABETOS[0] || tamanio != 26) return false;
+    for (int i = 0; i < 26; i++) {
+        if (tabla[i] != 'A' + i) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Obtiene el desplazamiento actual de la posición cero
+ * @return Índice en [0, tamanio) del carácter en la posición cero
+ */
+int RotorDeMapeo::getPosicion() const {
+    return posicionCero;
+}
+
+/**
+ * @brief Coloca la posición cero directamente, sin imprimir
+ * @param posicion Nuevo desplazamiento (se normaliza al tamaño del rotor)
+ */
+void RotorDeMapeo::setPosicion(int posicion) {
+    if (tamanio == 0) return;
+    posicion = posicion % tamanio;
+    if (posicion < 0) posicion += tamanio;
+    posicionCero = posicion;
+}
+
+/**
+ * @brief Obtiene el número de caracteres del rotor
+ * @return Tamaño del alfabeto
+ */
+int RotorDeMapeo::getTamanio() const {
+    return tamanio;
+}
+
+/**
+ * @brief Obtiene el carácter que ocupa actualmente la posición cero
+ * @return Carácter en la posición cero, o '\0' si el rotor está vacío
+ */
+char RotorDeMapeo::getCaracterCero() const {
+    if (tamanio == 0) return '\0';
+    return tabla[posicionCero];
+}
+
+/**
+ * @brief Encadena una cascada de rotores a la salida de este rotor
+ * @param rotores Cascada a aplicar después de este rotor, o nullptr para quitarla
+ */
+void RotorDeMapeo::setCascada(CascadaDeRotores* rotores) {
+    cascada = rotores;
+}
+
+/**
+ * @brief Obtiene la cascada encadenada
+ * @return Cascada, o nullptr si no hay
+ */
+CascadaDeRotores* RotorDeMapeo::getCascada() {
+    return cascada;
+}
+
+/**
+ * @brief Obtiene la cascada encadenada, sólo para consultarla
+ * @return Cascada, o nullptr si no hay
+ */
+const CascadaDeRotores* RotorDeMapeo::getCascada() const {
+    return cascada;
 }
 
 /**
  * @brief Imprime el estado actual del rotor (para debugging)
  */
 void RotorDeMapeo::imprimir() {
+    std::ostream& salida = Registro::salida();
     if (cabeza == nullptr) {
-        std::cout << "Rotor vacío" << std::endl;
+        salida << "Rotor vacío\n";
         return;
     }
     
-    std::cout << "Rotor (posición cero='" << cabeza->dato << "'): ";
-    NodoRotor* actual = cabeza;
+    // Ubicar el nodo de la posición cero recorriendo la lista circular
+    NodoRotor* cero = cabeza;
+    for (int i = 0; i < posicionCero; i++) {
+        cero = cero->siguiente;
+    }
+    
+    salida << "Rotor (posición cero='" << cero->dato << "'): ";
+    NodoRotor* actual = cero;
     do {
-        std::cout << actual->dato;
-        if (actual == cabeza) std::cout << "*"; 
-        std::cout << " ";
+        salida << actual->dato;
+        if (actual == cero) salida << "*"; 
+        salida << " ";
         actual = actual->siguiente;
-    } while (actual != cabeza);
-    std::cout << std::endl;
+    } while (actual != cero);
+    salida << "\n";
 }
\ No newline at end of file
@@ -8,6 +8,20 @@
 #ifndef ROTOR_DE_MAPEO_H
 #define ROTOR_DE_MAPEO_H
 
+class CascadaDeRotores;
+
+/**
+ * @brief Alfabeto del rotor elegido al ejecutar
+ * @details Las tablas son las que RotorGenerico calcula al compilar para cada
+ *          alfabeto; el rotor sólo guarda un puntero a su descripción.
+ */
+struct AlfabetoRotor {
+    const char* nombre;            ///< Nombre en la línea de comandos
+    int tamanio;                   ///< Número de símbolos
+    const short* indice;           ///< Posición de cada byte en el alfabeto, o -1 si no pertenece
+    const unsigned char* simbolos; ///< Símbolos del alfabeto en orden
+};
+
 /**
  * @brief Nodo para la lista circular doblemente enlazada del rotor
  */
@@ -22,12 +36,30 @@ struct NodoRotor {
 /**
  * @class RotorDeMapeo
  * @brief Lista circular doblemente enlazada que actúa como disco de cifrado
- * @details Contiene el alfabeto A-Z y puede rotar para cambiar el mapeo de caracteres
+ * @details Contiene el alfabeto A-Z (u otro elegido con setAlfabeto()) y puede
+ *          rotar para cambiar el mapeo de caracteres.
+ *          Además de la lista circular se mantiene una tabla contigua del alfabeto y
+ *          la posición cero como desplazamiento entero, de modo que rotar() y
+ *          getMapeo() son O(1). La lista circular se conserva para imprimir().
+ *          Opcionalmente se le encadena una CascadaDeRotores: cada carga pasa
+ *          primero por este rotor y después por la cascada.
  */
 class RotorDeMapeo {
+public:
+    static const int CAPACIDAD_MAXIMA = 256; ///< Máximo de caracteres en el rotor
+
 private:
-    NodoRotor* cabeza;  ///< Puntero al nodo actual de posición cero
+    NodoRotor* cabeza;  ///< Primer nodo insertado (origen de la lista circular)
     int tamanio;        ///< Tamaño de la lista circular
+    int posicionCero;   ///< Desplazamiento de la posición cero respecto a cabeza
+    char tabla[CAPACIDAD_MAXIMA]; ///< Alfabeto en orden de inserción (acceso O(1))
+    const AlfabetoRotor* alfabeto; ///< Alfabeto base: da el índice de cada carácter de entrada
+    CascadaDeRotores* cascada;    ///< Rotores encadenados (no se liberan), o nullptr
+    
+    /**
+     * @brief Libera los nodos de la lista circular y deja el rotor vacío
+     */
+    void vaciar();
     
 public:
     /**
@@ -40,6 +72,28 @@ public:
      */
     ~RotorDeMapeo();
     
+    /**
+     * @brief Busca un alfabeto por nombre
+     * @param nombre mayusculas (A-Z), minusculas (a-z), alfanumerico (A-Z0-9),
+     *        base64 (A-Za-z0-9+/) o bytes (los 256 valores)
+     * @return Descripción del alfabeto, o nullptr si no existe
+     */
+    static const AlfabetoRotor* buscarAlfabeto(const char* nombre);
+    
+    /**
+     * @brief Reemplaza el alfabeto del rotor
+     * @param nuevo Alfabeto a usar (nullptr = A-Z)
+     * @details Reconstruye la lista circular con los símbolos de nuevo y deja la
+     *          posición cero en el primero. La cascada encadenada se conserva.
+     */
+    void setAlfabeto(const AlfabetoRotor* nuevo);
+    
+    /**
+     * @brief Obtiene el alfabeto base del rotor
+     * @return Descripción del alfabeto
+     */
+    const AlfabetoRotor* getAlfabeto() const;
+    
     /**
      * @brief Inserta un carácter al final de la lista circular
      * @param c Carácter a insertar
@@ -53,12 +107,84 @@ public:
     void rotar(int n);
     
     /**
-     * @brief Obtiene el mapeo de un carácter según la rotación actual
+     * @brief Obtiene el mapeo de una carga según la rotación actual
      * @param entrada Carácter de entrada
      * @return Carácter mapeado según la posición actual del rotor
+     * @details Con una cascada encadenada también la aplica y la hace avanzar.
      */
     char getMapeo(char entrada);
     
+    /**
+     * @brief Obtiene el mapeo de un carácter como si la posición cero fuera otra
+     * @param entrada Carácter de entrada
+     * @param posicion Desplazamiento de la posición cero a usar, en [0, tamanio)
+     * @return Carácter mapeado
+     * @details No modifica el rotor, por lo que puede llamarse desde varios hilos.
+     *          No aplica la cascada encadenada.
+     */
+    char getMapeoEn(char entrada, int posicion) const;
+    
+    /**
+     * @brief Obtiene el mapeo de un lote de caracteres con la rotación actual
+     * @param entrada Caracteres de entrada
+     * @param salida Destino de los caracteres mapeados (puede ser igual a entrada)
+     * @param cantidad Número de caracteres
+     * @details Con el alfabeto A-Z estándar usa los kernels vectorizados de
+     *          DecodificacionLote.h; en otro caso aplica getMapeoEn() a cada
+     *          carácter. No aplica la cascada encadenada (ver decodificarEInsertar()).
+     */
+    void getMapeoLote(const char* entrada, char* salida, int cantidad) const;
+    
+    /**
+     * @brief Indica si el rotor contiene exactamente el alfabeto A-Z en orden
+     * @return true si el mapeo equivale a un desplazamiento módulo 26
+     */
+    bool esAlfabetoEstandar() const;
+    
+    /**
+     * @brief Obtiene el desplazamiento actual de la posición cero
+     * @return Índice en [0, tamanio) del carácter en la posición cero
+     */
+    int getPosicion() const;
+    
+    /**
+     * @brief Coloca la posición cero directamente, sin imprimir
+     * @param posicion Nuevo desplazamiento (se normaliza al tamaño del rotor)
+     * @details Útil para aplicar de una vez la rotación acumulada de varias tramas.
+     */
+    void setPosicion(int posicion);
+    
+    /**
+     * @brief Obtiene el número de caracteres del rotor
+     * @return Tamaño del alfabeto
+     */
+    int getTamanio() const;
+    
+    /**
+     * @brief Obtiene el carácter que ocupa actualmente la posición cero
+     * @return Carácter en la posición cero, o '\0' si el rotor está vacío
+     */
+    char getCaracterCero() const;
+    
+    /**
+     * @brief Encadena una cascada de rotores a la salida de este rotor
+     * @param rotores Cascada a aplicar después de este rotor, o nullptr para quitarla
+     * @details La cascada no pasa a ser propiedad del rotor.
+     */
+    void setCascada(CascadaDeRotores* rotores);
+    
+    /**
+     * @brief Obtiene la cascada encadenada
+     * @return Cascada, o nullptr si no hay
+     */
+    CascadaDeRotores* getCascada();
+    
+    /**
+     * @brief Obtiene la cascada encadenada, sólo para consultarla
+     * @return Cascada, o nullptr si no hay
+     */
+    const CascadaDeRotores* getCascada() const;
+    
     /**
      * @brief Imprime el estado actual del rotor (para debugging)
      */
@@ -0,0 +1,236 @@
+/**
+ * @file RotorGenerico.h
+ * @brief Rotor de desplazamiento parametrizado por el alfabeto, con tablas calculadas al compilar
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef ROTOR_GENERICO_H
+#define ROTOR_GENERICO_H
+
+#include <type_traits>
+#include "DecodificacionLote.h"
+
+/**
+ * @brief Alfabeto A-Z (el del protocolo original)
+ */
+struct AlfabetoMayusculas {
+    static constexpr int TAMANIO = 26; ///< Número de símbolos
+    static constexpr unsigned char simbolo(int i) { return (unsigned char)('A' + i); }
+};
+
+/**
+ * @brief Alfabeto a-z
+ */
+struct AlfabetoMinusculas {
+    static constexpr int TAMANIO = 26; ///< Número de símbolos
+    static constexpr unsigned char simbolo(int i) { return (unsigned char)('a' + i); }
+};
+
+/**
+ * @brief Alfabeto A-Z seguido de 0-9
+ */
+struct AlfabetoAlfanumerico {
+    static constexpr int TAMANIO = 36; ///< Número de símbolos
+    static constexpr unsigned char simbolo(int i) {
+        return (unsigned char)(i < 26 ? 'A' + i : '0' + (i - 26));
+    }
+};
+
+/**
+ * @brief Alfabeto de Base64: A-Z, a-z, 0-9, '+' y '/'
+ */
+struct AlfabetoBase64 {
+    static constexpr int TAMANIO = 64; ///< Número de símbolos
+    static constexpr unsigned char simbolo(int i) {
+        return (unsigned char)(i < 26 ? 'A' + i :
+                               i < 52 ? 'a' + (i - 26) :
+                               i < 62 ? '0' + (i - 52) :
+                               i == 62 ? '+' : '/');
+    }
+};
+
+/**
+ * @brief Los 256 valores de un byte, en orden
+ */
+struct AlfabetoBytes {
+    static constexpr int TAMANIO = 256; ///< Número de símbolos
+    static constexpr unsigned char simbolo(int i) { return (unsigned char)i; }
+};
+
+/**
+ * @brief Tablas de búsqueda de un alfabeto
+ * @tparam N Número de símbolos
+ */
+template <int N>
+struct TablasAlfabeto {
+    short indice[256];             ///< Posición de cada byte en el alfabeto, o -1 si no pertenece
+    unsigned char simbolo[2 * N];  ///< Símbolos dos veces seguidas: simbolo[i + p] sin módulo
+};
+
+/**
+ * @brief Genera las tablas de un alfabeto en tiempo de compilación
+ * @tparam Alfabeto Tipo con TAMANIO y simbolo(i)
+ * @return Tablas del alfabeto
+ */
+template <typename Alfabeto>
+constexpr TablasAlfabeto<Alfabeto::TAMANIO> generarTablasAlfabeto() {
+    TablasAlfabeto<Alfabeto::TAMANIO> tablas{};
+    for (int c = 0; c < 256; c++) tablas.indice[c] = -1;
+    for (int i = 0; i < Alfabeto::TAMANIO; i++) {
+        unsigned char s = Alfabeto::simbolo(i);
+        tablas.indice[s] = (short)i;
+        tablas.simbolo[i] = s;
+        tablas.simbolo[i + Alfabeto::TAMANIO] = s;
+    }
+    return tablas;
+}
+
+/**
+ * @brief Verifica en tiempo de compilación que un alfabeto no repite símbolos
+ * @tparam Alfabeto Tipo con TAMANIO y simbolo(i)
+ * @return true si todos los símbolos son distintos
+ */
+template <typename Alfabeto>
+constexpr bool alfabetoSinRepetidos() {
+    bool visto[256] = {};
+    for (int i = 0; i < Alfabeto::TAMANIO; i++) {
+        if (visto[Alfabeto::simbolo(i)]) return false;
+        visto[Alfabeto::simbolo(i)] = true;
+    }
+    return true;
+}
+
+/**
+ * @class RotorGenerico
+ * @brief Rotor de desplazamiento sobre un alfabeto fijo en tiempo de compilación
+ * @tparam Alfabeto Tipo con TAMANIO (1..256) y simbolo(i); por defecto A-Z
+ * @details Equivale a RotorDeMapeo con su alfabeto inicial, pero el alfabeto es
+ *          un parámetro de la plantilla: las tablas símbolo→índice e
+ *          índice→símbolo se calculan con constexpr al compilar y el rotor sólo
+ *          guarda su desplazamiento. getMapeo() son dos consultas a tabla sin
+ *          módulo (la tabla de símbolos está duplicada); los bytes que no son del
+ *          alfabeto pasan sin cambios, y con el alfabeto de 256 símbolos no hay
+ *          ni esa comparación. Es una plantilla, por eso vive completa en el
+ *          header. RotorGenerico<> reproduce el mapeo A-Z de RotorDeMapeo y
+ *          decodifica los lotes con los kernels de DecodificacionLote.h.
+ *          RotorDeMapeo usa las tablas de cada instancia (getTablas()) para el
+ *          alfabeto que se elige al ejecutar (--alfabeto).
+ */
+template <typename Alfabeto = AlfabetoMayusculas>
+class RotorGenerico {
+public:
+    static constexpr int TAMANIO = Alfabeto::TAMANIO; ///< Símbolos del alfabeto
+
+    static_assert(TAMANIO > 0 && TAMANIO <= 256, "El alfabeto debe tener entre 1 y 256 símbolos");
+    static_assert(alfabetoSinRepetidos<Alfabeto>(), "El alfabeto repite símbolos");
+
+private:
+    static constexpr TablasAlfabeto<TAMANIO> TABLAS = generarTablasAlfabeto<Alfabeto>(); ///< Tablas del alfabeto
+
+    int posicionCero; ///< Desplazamiento de la posición cero, en [0, TAMANIO)
+
+public:
+    /**
+     * @brief Constructor: posición cero en el primer símbolo del alfabeto
+     */
+    RotorGenerico() : posicionCero(0) {}
+
+    /**
+     * @brief Obtiene las tablas del alfabeto calculadas al compilar
+     * @return Tablas símbolo→índice e índice→símbolo
+     */
+    static constexpr const TablasAlfabeto<TAMANIO>& getTablas() {
+        return TABLAS;
+    }
+
+    /**
+     * @brief Rota el rotor N posiciones
+     * @param n Número de posiciones a rotar (positivo = horario, negativo = antihorario)
+     */
+    void rotar(int n) {
+        n %= TAMANIO;
+        if (n < 0) n += TAMANIO;
+        posicionCero += n;
+        if (posicionCero >= TAMANIO) posicionCero -= TAMANIO;
+    }
+
+    /**
+     * @brief Obtiene el mapeo de un carácter según la rotación actual
+     * @param entrada Carácter de entrada
+     * @return Carácter mapeado, o entrada si no pertenece al alfabeto
+     */
+    char getMapeo(char entrada) const {
+        return getMapeoEn(entrada, posicionCero);
+    }
+
+    /**
+     * @brief Obtiene el mapeo de un carácter como si la posición cero fuera otra
+     * @param entrada Carácter de entrada
+     * @param posicion Desplazamiento a usar, en [0, TAMANIO)
+     * @return Carácter mapeado, o entrada si no pertenece al alfabeto
+     */
+    char getMapeoEn(char entrada, int posicion) const {
+        int indice = TABLAS.indice[(unsigned char)entrada];
+        if constexpr (TAMANIO == 256) {
+            return (char)TABLAS.simbolo[indice + posicion];
+        } else {
+            return indice < 0 ? entrada : (char)TABLAS.simbolo[indice + posicion];
+        }
+    }
+
+    /**
+     * @brief Obtiene el mapeo de un lote de caracteres con la rotación actual
+     * @param entrada Caracteres de entrada
+     * @param salida Destino de los caracteres mapeados (puede ser igual a entrada)
+     * @param cantidad Número de caracteres
+     */
+    void getMapeoLote(const char* entrada, char* salida, int cantidad) const {
+        if constexpr (std::is_same<Alfabeto, AlfabetoMayusculas>::value) {
+            decodificarLote(entrada, salida, cantidad, posicionCero);
+        } else {
+            for (int i = 0; i < cantidad; i++) {
+                salida[i] = getMapeoEn(entrada[i], posicionCero);
+            }
+        }
+    }
+
+    /**
+     * @brief Obtiene el desplazamiento actual de la posición cero
+     * @return Índice en [0, TAMANIO)
+     */
+    int getPosicion() const {
+        return posicionCero;
+    }
+
+    /**
+     * @brief Coloca la posición cero directamente
+     * @param posicion Nuevo desplazamiento (se normaliza al tamaño del alfabeto)
+     */
+    void setPosicion(int posicion) {
+        posicion %= TAMANIO;
+        if (posicion < 0) posicion += TAMANIO;
+        posicionCero = posicion;
+    }
+
+    /**
+     * @brief Obtiene el número de símbolos del rotor
+     * @return Tamaño del alfabeto
+     */
+    int getTamanio() const {
+        return TAMANIO;
+    }
+
+    /**
+     * @brief Obtiene el símbolo que ocupa actualmente la posición cero
+     * @return Símbolo en la posición cero
+     */
+    char getCaracterCero() const {
+        return (char)TABLAS.simbolo[posicionCero];
+    }
+};
+
+/// Rotor A-Z, equivalente al mapeo de RotorDeMapeo
+typedef RotorGenerico<> RotorAZ;
+
+#endif // ROTOR_GENERICO_H
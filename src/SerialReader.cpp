@@ -6,10 +6,73 @@
  */
 
 #include "SerialReader.h"
+#include "Registro.h"
+#include "BaudiosLinux.h"
 #include <iostream>
 #include <cstring>
+#include <cerrno>
 
-SerialReader::SerialReader(const char* puerto, int baudRate) : conectado(false) {
+#ifndef _WIN32
+/**
+ * @brief Traduce una velocidad en baudios a la constante de termios
+ * @param baudios Velocidad en baudios
+ * @param velocidad Recibe la constante Bxxxx correspondiente
+ * @return true si es una velocidad estándar soportada por termios
+ */
+static bool convertirBaudios(int baudios, speed_t* velocidad) {
+    switch (baudios) {
+        case 1200: *velocidad = B1200; return true;
+        case 2400: *velocidad = B2400; return true;
+        case 4800: *velocidad = B4800; return true;
+        case 9600: *velocidad = B9600; return true;
+        case 19200: *velocidad = B19200; return true;
+        case 38400: *velocidad = B38400; return true;
+        case 57600: *velocidad = B57600; return true;
+        case 115200: *velocidad = B115200; return true;
+        case 230400: *velocidad = B230400; return true;
+#ifdef B460800
+        case 460800: *velocidad = B460800; return true;
+#endif
+#ifdef B500000
+        case 500000: *velocidad = B500000; return true;
+#endif
+#ifdef B576000
+        case 576000: *velocidad = B576000; return true;
+#endif
+#ifdef B921600
+        case 921600: *velocidad = B921600; return true;
+#endif
+#ifdef B1000000
+        case 1000000: *velocidad = B1000000; return true;
+#endif
+#ifdef B1152000
+        case 1152000: *velocidad = B1152000; return true;
+#endif
+#ifdef B1500000
+        case 1500000: *velocidad = B1500000; return true;
+#endif
+#ifdef B2000000
+        case 2000000: *velocidad = B2000000; return true;
+#endif
+#ifdef B2500000
+        case 2500000: *velocidad = B2500000; return true;
+#endif
+#ifdef B3000000
+        case 3000000: *velocidad = B3000000; return true;
+#endif
+#ifdef B3500000
+        case 3500000: *velocidad = B3500000; return true;
+#endif
+#ifdef B4000000
+        case 4000000: *velocidad = B4000000; return true;
+#endif
+        default: return false;
+    }
+}
+#endif
+
+SerialReader::SerialReader(const char* puerto, int baudRate)
+    : conectado(false), bufferLectura(new char[TAMANIO_BUFFER]), inicio(0), fin(0), timeoutMs(-1), extremoCerrado(false) {
 #ifdef _WIN32
     // Configuración para Windows
     hSerial = CreateFileA(puerto,
@@ -59,7 +122,7 @@ SerialReader::SerialReader(const char* puerto, int baudRate) : conectado(false)
     }
     
     conectado = true;
-    std::cout << "Puerto serial " << puerto << " abierto exitosamente (Windows)" << std::endl;
+    PRT7_RESUMEN("Puerto serial " << puerto << " abierto exitosamente (Windows)\n");
 
 #else
     // Configuración para Linux
@@ -70,12 +133,26 @@ SerialReader::SerialReader(const char* puerto, int baudRate) : conectado(false)
         return;
     }
     
+    if (baudRate <= 0) {
+        std::cerr << "Error: Velocidad inválida (" << baudRate << " baudios)" << std::endl;
+        close(fd);
+        return;
+    }
+    
     struct termios options;
-    tcgetattr(fd, &options);
+    if (tcgetattr(fd, &options) != 0) {
+        std::cerr << "Error al obtener estado del puerto: " << strerror(errno) << std::endl;
+        close(fd);
+        return;
+    }
     
-    // Configurar velocidad
-    cfsetispeed(&options, B9600);
-    cfsetospeed(&options, B9600);
+    // Configurar velocidad: estándar con cfsetspeed, arbitraria con termios2 más abajo
+    speed_t velocidad;
+    bool velocidadEstandar = convertirBaudios(baudRate, &velocidad);
+    if (velocidadEstandar) {
+        cfsetispeed(&options, velocidad);
+        cfsetospeed(&options, velocidad);
+    }
     
     // Configurar formato: 8N1
     options.c_cflag &= ~PARENB;   // Sin paridad
@@ -86,6 +163,7 @@ SerialReader::SerialReader(const char* puerto, int baudRate) : conectado(false)
     // Control local
     options.c_cflag |= CREAD | CLOCAL;
     options.c_iflag &= ~(IXON | IXOFF | IXANY);
+    options.c_iflag &= ~(ICRNL | INLCR | IGNCR | ISTRIP); // No traducir '\r' a '\n'
     options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
     options.c_oflag &= ~OPOST;
     
@@ -93,10 +171,31 @@ SerialReader::SerialReader(const char* puerto, int baudRate) : conectado(false)
     options.c_cc[VMIN] = 0;
     options.c_cc[VTIME] = 1;
     
-    tcsetattr(fd, TCSANOW, &options);
+    if (tcsetattr(fd, TCSANOW, &options) != 0) {
+        std::cerr << "Error al configurar puerto: " << strerror(errno) << std::endl;
+        close(fd);
+        return;
+    }
+    
+    // tcsetattr() tiene éxito si aplica cualquier cambio: confirmar la velocidad
+    struct termios aplicadas;
+    if (velocidadEstandar &&
+        (tcgetattr(fd, &aplicadas) != 0 || cfgetospeed(&aplicadas) != velocidad)) {
+        std::cerr << "Error: El puerto no aceptó " << baudRate << " baudios" << std::endl;
+        close(fd);
+        return;
+    }
+    
+    if (!velocidadEstandar && !configurarBaudiosPersonalizados(fd, baudRate)) {
+        std::cerr << "Error: Velocidad no soportada por el controlador: "
+                  << baudRate << " baudios" << std::endl;
+        close(fd);
+        return;
+    }
     
     conectado = true;
-    std::cout << "Puerto serial " << puerto << " abierto exitosamente (Linux)" << std::endl;
+    PRT7_RESUMEN("Puerto serial " << puerto << " abierto exitosamente (Linux, "
+                 << baudRate << " baudios)\n");
 #endif
 }
 
@@ -107,42 +206,192 @@ SerialReader::~SerialReader() {
 #else
         close(fd);
 #endif
-        std::cout << "Puerto serial cerrado" << std::endl;
+        PRT7_RESUMEN("Puerto serial cerrado\n");
     }
+    delete[] bufferLectura;
+}
+
+int SerialReader::rellenarBuffer() {
+    // Compactar: los bytes pendientes pasan al inicio del buffer
+    if (inicio > 0) {
+        if (fin > inicio) {
+            memmove(bufferLectura, bufferLectura + inicio, fin - inicio);
+        }
+        fin -= inicio;
+        inicio = 0;
+    }
+    if (fin == TAMANIO_BUFFER) return 0;
+    
+#ifdef _WIN32
+    DWORD bytesRead;
+    if (!ReadFile(hSerial, bufferLectura + fin, TAMANIO_BUFFER - fin, &bytesRead, nullptr)) {
+        extremoCerrado = true;
+        return -1;
+    }
+    int leidos = (int)bytesRead;
+#else
+    int leidos = read(fd, bufferLectura + fin, TAMANIO_BUFFER - fin);
+    if (leidos < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+        extremoCerrado = true;
+        return -1;
+    }
+#endif
+    fin += leidos;
+    return leidos;
 }
 
 bool SerialReader::leerLinea(char* buffer, int maxLength) {
-    if (!conectado) return false;
+    const char* linea;
+    int longitud;
+    if (maxLength <= 0 || !leerLinea(&linea, &longitud)) return false;
     
+    // Copiar omitiendo '\r', como hacía la lectura byte a byte
     int pos = 0;
-    char c;
-    
-    while (pos < maxLength - 1) {
-#ifdef _WIN32
-        DWORD bytesRead;
-        if (!ReadFile(hSerial, &c, 1, &bytesRead, nullptr)) {
-            return false;
+    int i = 0;
+    for (; i < longitud && pos < maxLength - 1; i++) {
+        if (linea[i] != '\r') {
+            buffer[pos++] = linea[i];
         }
-        if (bytesRead == 0) continue;
-#else
-        int result = read(fd, &c, 1);
-        if (result <= 0) continue;
+    }
+    buffer[pos] = '\0';
+    
+    // Si la línea no cupo, el resto queda pendiente para la siguiente llamada
+    if (i < longitud) {
+        inicio = (int)(linea + i - bufferLectura);
+    }
+    return true;
+}
+
+bool SerialReader::leerLinea(const char** linea, int* longitud) {
+    if (!conectado) return false;
+    
+#ifndef _WIN32
+    bool hayDatos = false;
 #endif
+    while (true) {
+        const char* nl = nullptr;
+        if (fin > inicio) {
+            nl = (const char*)memchr(bufferLectura + inicio, '\n', fin - inicio);
+        }
         
-        if (c == '\n') {
-            buffer[pos] = '\0';
+        if (nl != nullptr || (inicio == 0 && fin == TAMANIO_BUFFER)) {
+            // Línea completa, o buffer lleno sin '\n': se entrega tal cual
+            const char* comienzo = bufferLectura + inicio;
+            const char* final = (nl != nullptr) ? nl : bufferLectura + fin;
+            inicio = (int)(final - bufferLectura) + (nl != nullptr ? 1 : 0);
+            if (final > comienzo && final[-1] == '\r') final--;
+            *linea = comienzo;
+            *longitud = (int)(final - comienzo);
             return true;
         }
         
-        if (c != '\r') {
-            buffer[pos++] = c;
+        int leidos = rellenarBuffer();
+        if (leidos < 0) {
+            return false;
+        }
+#ifndef _WIN32
+        if (leidos == 0) {
+            // Si poll() ya indicó datos y read() no trajo nada, el otro extremo se cerró
+            if (hayDatos) {
+                extremoCerrado = true;
+                return false;
+            }
+            if (!esperarDatos(timeoutMs)) {
+                return false;
+            }
+            hayDatos = true;
+        } else {
+            hayDatos = false;
         }
+#endif
     }
+}
+
+bool SerialReader::esperarDatos(int milisegundos) {
+    if (!conectado) return false;
+#ifdef _WIN32
+    // En Windows ReadFile ya espera según COMMTIMEOUTS
+    (void)milisegundos;
+    return true;
+#else
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
     
-    buffer[pos] = '\0';
+    int resultado;
+    do {
+        resultado = poll(&pfd, 1, milisegundos);
+    } while (resultado < 0 && errno == EINTR);
+    
+    if (resultado <= 0) return false;
+    if ((pfd.revents & POLLIN) == 0) {
+        // Con POLLHUP/POLLERR sin datos el otro extremo se cerró: no reintentar
+        extremoCerrado = true;
+        return false;
+    }
     return true;
+#endif
+}
+
+bool SerialReader::hayLineaDisponible() {
+    if (!conectado) return false;
+    if (fin > inicio && memchr(bufferLectura + inicio, '\n', fin - inicio) != nullptr) {
+        return true;
+    }
+    if (inicio == 0 && fin == TAMANIO_BUFFER) return true;
+    
+    int pendientesAntes = fin - inicio;
+#ifndef _WIN32
+    if (!esperarDatos(0)) return false;
+#endif
+    int leidos = rellenarBuffer();
+#ifndef _WIN32
+    // poll() indicó datos pero read() no trajo nada: el otro extremo se cerró
+    if (leidos == 0) extremoCerrado = true;
+#endif
+    if (leidos <= 0) return false;
+    // Sólo hace falta buscar en los bytes recién llegados
+    return memchr(bufferLectura + pendientesAntes, '\n', fin - pendientesAntes) != nullptr
+           || fin == TAMANIO_BUFFER;
+}
+
+bool SerialReader::asomarBytes(const char** datos, size_t* longitud) {
+    if (!conectado) return false;
+    if (fin == inicio) {
+#ifndef _WIN32
+        if (!esperarDatos(0)) return false;
+#endif
+        int leidos = rellenarBuffer();
+#ifndef _WIN32
+        if (leidos == 0) extremoCerrado = true;
+#endif
+        if (leidos <= 0) return false;
+    }
+    *datos = bufferLectura + inicio;
+    *longitud = (size_t)(fin - inicio);
+    return true;
+}
+
+void SerialReader::consumirBytes(size_t cantidad) {
+    inicio += (int)cantidad;
+}
+
+void SerialReader::setTimeout(int milisegundos) {
+    timeoutMs = milisegundos;
+}
+
+bool SerialReader::seCerroElExtremo() const {
+    return extremoCerrado;
 }
 
+#ifndef _WIN32
+int SerialReader::getDescriptor() const {
+    return conectado ? fd : -1;
+}
+#endif
+
 bool SerialReader::estaConectado() const {
     return conectado;
 }
\ No newline at end of file
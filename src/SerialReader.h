@@ -8,10 +8,13 @@
 #ifndef SERIAL_READER_H
 #define SERIAL_READER_H
 
+#include <cstddef>
+
 #ifdef _WIN32
     #include <windows.h>
 #else
     #include <fcntl.h>
+    #include <poll.h>
     #include <termios.h>
     #include <unistd.h>
 #endif
@@ -31,11 +34,28 @@ private:
 #endif
     bool conectado; ///< Estado de la conexión
     
+    static const int TAMANIO_BUFFER = 1 << 16; ///< Capacidad del buffer de lectura (64 KB)
+    char* bufferLectura; ///< Bytes recibidos pendientes de entregar
+    int inicio;          ///< Primer byte pendiente en bufferLectura
+    int fin;             ///< Byte siguiente al último recibido en bufferLectura
+    int timeoutMs;       ///< Espera máxima de leerLinea() en milisegundos (-1 = sin límite)
+    bool extremoCerrado; ///< El otro extremo se desconectó o hubo un error de lectura
+    
+    /**
+     * @brief Lee del puerto todos los bytes disponibles en un solo bloque
+     * @return Número de bytes leídos (0 si no había datos, -1 en error)
+     * @details Antes de leer desplaza los bytes pendientes al inicio del buffer.
+     */
+    int rellenarBuffer();
+    
 public:
     /**
      * @brief Constructor
      * @param puerto Nombre del puerto (ej: "COM3" o "/dev/ttyUSB0")
      * @param baudRate Velocidad de comunicación (default: 9600)
+     * @details En Linux se aceptan las velocidades estándar hasta 4 Mbaud y
+     *          velocidades arbitrarias mediante termios2/BOTHER si el controlador
+     *          lo permite. Si la configuración falla, estaConectado() devuelve false.
      */
     SerialReader(const char* puerto, int baudRate = 9600);
     
@@ -50,10 +70,78 @@ public:
      * @param buffer Buffer donde se almacenará la línea leída
      * @param maxLength Tamaño máximo del buffer
      * @return true si se leyó correctamente, false en caso de error
-     * @details Lee hasta encontrar '\n' o alcanzar maxLength
+     * @details Lee hasta encontrar '\n' o alcanzar maxLength. Si la línea no cabe,
+     *          se entregan los primeros maxLength-1 caracteres y el resto queda
+     *          en el buffer para la siguiente llamada.
      */
     bool leerLinea(char* buffer, int maxLength);
     
+    /**
+     * @brief Lee una línea completa sin copiarla
+     * @param linea Recibe un puntero a la línea dentro del buffer interno (sin '\0')
+     * @param longitud Recibe la longitud de la línea sin '\n' ni '\r' final
+     * @return true si se obtuvo una línea, false en caso de error
+     * @details El puntero es válido hasta la siguiente lectura. El puerto se lee
+     *          en bloques de hasta 64 KB y los finales de línea se buscan con memchr.
+     *          Una línea más larga que el buffer se entrega en fragmentos.
+     *          Sin datos, el hilo se bloquea en poll() (sin consumir CPU) hasta
+     *          que lleguen bytes o venza el timeout configurado; en ese caso
+     *          devuelve false.
+     */
+    bool leerLinea(const char** linea, int* longitud);
+    
+    /**
+     * @brief Espera hasta que el puerto tenga datos para leer
+     * @param milisegundos Espera máxima (-1 = sin límite, 0 = sólo consultar)
+     * @return true si hay datos, false si venció el tiempo o el puerto se cerró
+     */
+    bool esperarDatos(int milisegundos);
+    
+    /**
+     * @brief Indica, sin bloquear, si hay al menos una línea completa disponible
+     * @return true si la siguiente llamada a leerLinea() no se bloqueará
+     * @details Lee lo que el controlador tenga disponible en ese momento, de modo
+     *          que un solo hilo puede atender el puerto intercalando otro trabajo.
+     */
+    bool hayLineaDisponible();
+    
+    /**
+     * @brief Expone, sin bloquear, los bytes pendientes del buffer sin consumirlos
+     * @param datos Recibe el inicio de los bytes pendientes
+     * @param longitud Recibe cuántos bytes hay
+     * @return true si hay al menos un byte
+     * @details Si el buffer está vacío lee lo que el controlador tenga en ese
+     *          momento. Sirve para detectar el formato del flujo y para leer
+     *          tramas binarias, que no se dividen en líneas.
+     */
+    bool asomarBytes(const char** datos, size_t* longitud);
+    
+    /**
+     * @brief Descarta bytes ya procesados del inicio del buffer
+     * @param cantidad Bytes a descartar (como máximo los devueltos por asomarBytes())
+     */
+    void consumirBytes(size_t cantidad);
+    
+    /**
+     * @brief Configura la espera máxima de leerLinea()
+     * @param milisegundos Milisegundos de espera (-1 = sin límite)
+     */
+    void setTimeout(int milisegundos);
+    
+    /**
+     * @brief Indica si el otro extremo se desconectó (o la lectura falló)
+     * @return true si ya no llegarán más datos por este puerto
+     */
+    bool seCerroElExtremo() const;
+    
+#ifndef _WIN32
+    /**
+     * @brief Obtiene el descriptor del puerto para integrarlo en poll/epoll externos
+     * @return File descriptor del puerto, o -1 si no está conectado
+     */
+    int getDescriptor() const;
+#endif
+    
     /**
      * @brief Verifica si la conexión está establecida
      * @return true si está conectado, false en caso contrario
@@ -0,0 +1,374 @@
+/**
+ * @file SesionDecodificacion.cpp
+ * @brief Implementación de la clase SesionDecodificacion
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "SesionDecodificacion.h"
+#include "FuenteDeLineas.h"
+#include "TramaCompacta.h"
+#include "ClasificacionLote.h"
+#include "DecodificacionLote.h"
+#include "Metricas.h"
+#include "PuntoDeControl.h"
+#include "CascadaDeRotores.h"
+#include "BufferDeReorden.h"
+#include <cstring>
+#include <iostream>
+
+SesionDecodificacion::SesionDecodificacion(const char* nombre, FuenteDeLineas* fuente)
+    : nombre(nombre), fuente(fuente), lineas(0), invalidas(0), terminada(false),
+      formato(FORMATO_DESCONOCIDO), punto(nullptr), cadaLineas(0), lineasGuardadas(0),
+      hayGuardado(false), reorden(nullptr), capacidadReorden(BufferDeReorden::CAPACIDAD_POR_DEFECTO),
+      esperaReorden(BufferDeReorden::ESPERA_POR_DEFECTO_MS), finRecibido(false), sinNumero(0) {}
+
+SesionDecodificacion::~SesionDecodificacion() {
+    delete reorden;
+}
+
+void SesionDecodificacion::decodificarRacha(const char* racha, int cantidad) {
+#if PRT7_METRICAS
+    long long inicio = Metricas::tocaMuestra(Metricas::ETAPA_CARGA) ? Metricas::ahoraNs() : 0;
+#endif
+    decodificarEInsertar(racha, cantidad, &rotor, &carga);
+#if PRT7_METRICAS
+    // La latencia se reparte entre las cargas de la racha
+    if (inicio != 0) {
+        Metricas::registrarLatencia(Metricas::ETAPA_CARGA, (Metricas::ahoraNs() - inicio) / cantidad);
+    }
+    Metricas::contarTramas(TRAMA_LOAD, cantidad);
+#endif
+}
+
+int SesionDecodificacion::procesarBinario(int maxLineas) {
+    const char* datos;
+    size_t disponibles;
+    int estado = fuente->asomarBytes(&datos, &disponibles);
+    if (estado == FuenteDeLineas::SIN_DATOS) return 0;
+    if (estado == FuenteDeLineas::FIN_DE_FUENTE) {
+        binario.finalizar();
+        invalidas = binario.getInvalidas();
+        terminada = true;
+        return 0;
+    }
+
+    size_t limite = (size_t)maxLineas * BYTES_POR_LINEA;
+    if (disponibles > limite) disponibles = limite;
+    long long tramas = binario.procesar(datos, disponibles, &rotor, &carga);
+    fuente->consumirBytes(disponibles);
+
+    lineas += tramas;
+    invalidas = binario.getInvalidas();
+    return (int)tramas;
+}
+
+int SesionDecodificacion::leerTramas(TramaCompacta* tramas, int capacidad, int* leidas) {
+    *leidas = 0;
+#if PRT7_METRICAS
+    long long inicio = Metricas::tocaMuestra(Metricas::ETAPA_PARSEO) ? Metricas::ahoraNs() : 0;
+    long long asomado = 0;
+#endif
+    const char* datos;
+    size_t disponibles;
+    int estado = fuente->asomarBytes(&datos, &disponibles);
+    if (estado == FuenteDeLineas::SIN_DATOS) return 0;
+    if (estado == FuenteDeLineas::FIN_DE_FUENTE) {
+        terminada = true;
+        return 0;
+    }
+#if PRT7_METRICAS
+    if (inicio != 0) asomado = Metricas::ahoraNs();
+#endif
+
+    ResultadoLote lote = clasificarLote(datos, disponibles, tramas, capacidad);
+    if (lote.lineas > 0) {
+        fuente->consumirBytes(lote.consumidos);
+    } else {
+        // Sólo hay una línea incompleta: la fuente la completa o la entrega al final
+        const char* linea;
+        int longitud;
+        estado = fuente->leerLineaDisponible(&linea, &longitud);
+        if (estado == FuenteDeLineas::SIN_DATOS) return 0;
+        if (estado == FuenteDeLineas::FIN_DE_FUENTE) {
+            terminada = true;
+            return 0;
+        }
+        lote.lineas = 1;
+        lote.tramas = 0;
+        lote.fin = (longitud == 3 && memcmp(linea, "END", 3) == 0);
+        if (longitud > 0 && !lote.fin) tramas[lote.tramas++] = clasificarTrama(linea, longitud);
+    }
+    if (lote.fin) terminada = true;
+
+#if PRT7_METRICAS
+    // La latencia de la lectura y de la clasificación se reparte entre las líneas del lote
+    if (inicio != 0) {
+        Metricas::registrarLatencia(Metricas::ETAPA_LECTURA, (asomado - inicio) / lote.lineas);
+        Metricas::registrarLatencia(Metricas::ETAPA_PARSEO, (Metricas::ahoraNs() - asomado) / lote.lineas);
+    }
+#endif
+    *leidas = lote.lineas;
+    return lote.tramas;
+}
+
+int SesionDecodificacion::leerTramasSecuenciadas(TramaCompacta* tramas, int capacidad, int* leidas) {
+    *leidas = 0;
+    reorden->revisarEspera();
+    int escritas = reorden->extraer(tramas, capacidad);
+    while (!finRecibido && *leidas < capacidad && escritas < capacidad && reorden->admiteTramas()) {
+        // Dónde empieza la línea: un punto de control puede tener que volver a leerla
+        OrigenTrama origen;
+        origen.byte = fuente->getBytesConsumidos();
+        origen.linea = lineas + *leidas;
+        origen.sinNumero = sinNumero;
+
+        const char* linea;
+        int longitud;
+        int estado = fuente->leerLineaDisponible(&linea, &longitud);
+        if (estado == FuenteDeLineas::SIN_DATOS) break;
+        if (estado == FuenteDeLineas::FIN_DE_FUENTE) {
+            finRecibido = true;
+            break;
+        }
+        (*leidas)++;
+        if (longitud == 0) continue;
+        if (longitud == 3 && memcmp(linea, "END", 3) == 0) {
+            finRecibido = true;
+            break;
+        }
+
+        unsigned int secuencia;
+        ErrorTrama error;
+        TramaCompacta trama = clasificarTramaSecuenciada(linea, longitud, &secuencia, &error);
+        if (error == ERROR_SECUENCIA_FORMATO) {
+            // Sin número no hay lugar en el orden: se cuenta como inválida al llegar
+            tramas[escritas++] = trama;
+            sinNumero++;
+            continue;
+        }
+        reorden->insertar(secuencia, trama, origen);
+        escritas += reorden->extraer(tramas + escritas, capacidad - escritas);
+    }
+
+    if (finRecibido) {
+        reorden->finalizar();
+        escritas += reorden->extraer(tramas + escritas, capacidad - escritas);
+        if (reorden->estaVacio()) terminada = true;
+    }
+    return escritas;
+}
+
+int SesionDecodificacion::procesarDisponibles(int maxLineas) {
+    if (terminada) return 0;
+    int consumidas = procesarFuente(maxLineas);
+    if (punto != nullptr) guardarSiToca();
+    return consumidas;
+}
+
+void SesionDecodificacion::guardarSiToca() {
+    bool toca = terminada ? (!hayGuardado || lineas != lineasGuardadas)
+                          : lineas - lineasGuardadas >= cadaLineas;
+    if (!toca || (formato == FORMATO_BINARIO && !binario.enReposo())) return;
+
+    EstadoSesion estado;
+    estado.secuencia = lineas;
+    estado.invalidas = invalidas;
+    estado.bytesEntrada = fuente->getBytesConsumidos();
+    estado.bytesCarga = carga.getTotal();
+    estado.posicionRotor = rotor.getPosicion();
+    estado.tamanioRotor = rotor.getTamanio();
+    estado.formato = (int)formato;
+    estado.secuenciaIniciada = false;
+    estado.siguienteSecuencia = 0;
+    if (reorden != nullptr) {
+        estado.secuenciaIniciada = reorden->estaIniciado();
+        estado.siguienteSecuencia = reorden->getSiguiente();
+        // Las tramas en espera ya se leyeron pero no se aplicaron: al reanudar se
+        // vuelve a leer desde la más antigua. Las entregadas que se relean llegan
+        // tarde y se descartan; sólo las líneas sin número se contarían dos veces.
+        OrigenTrama origen;
+        if (reorden->getOrigenMasAntiguo(&origen) && origen.byte >= 0 && estado.bytesEntrada >= 0) {
+            estado.bytesEntrada = origen.byte;
+            estado.secuencia = origen.linea;
+            estado.invalidas = invalidas - (sinNumero - origen.sinNumero);
+        }
+    }
+    if (!punto->guardar(estado, &carga)) {
+        std::cerr << "Error: No se pudo escribir el punto de control de " << nombre
+                  << "; se desactivan los puntos de control" << std::endl;
+        punto = nullptr;
+        return;
+    }
+    lineasGuardadas = lineas;
+    hayGuardado = true;
+}
+
+void SesionDecodificacion::setPuntoDeControl(PuntoDeControl* destino, long long lineasEntrePuntos) {
+    punto = destino;
+    cadaLineas = lineasEntrePuntos > 0 ? lineasEntrePuntos : 1;
+}
+
+bool SesionDecodificacion::restaurar(const EstadoSesion& estado, PuntoDeControl* origen) {
+    if (estado.tamanioRotor != rotor.getTamanio() || estado.formato < FORMATO_DESCONOCIDO ||
+        estado.formato > FORMATO_SECUENCIADO) {
+        std::cerr << "Error: El punto de control de " << nombre << " no corresponde a este decodificador"
+                  << std::endl;
+        return false;
+    }
+    if (estado.bytesEntrada >= 0 && fuente->getBytesConsumidos() >= 0 &&
+        !fuente->posicionarEn(estado.bytesEntrada)) {
+        std::cerr << "Error: No se pudo avanzar " << nombre << " al byte " << estado.bytesEntrada
+                  << " del punto de control" << std::endl;
+        return false;
+    }
+    carga.reanudarDesde(origen, estado.bytesCarga);
+
+    rotor.setPosicion(estado.posicionRotor);
+    lineas = estado.secuencia;
+    invalidas = estado.invalidas;
+    formato = (Formato)estado.formato;
+    binario.restaurarContadores(estado.secuencia, estado.invalidas);
+    if (formato == FORMATO_SECUENCIADO) {
+        delete reorden;
+        reorden = new BufferDeReorden(capacidadReorden, esperaReorden);
+        if (estado.secuenciaIniciada) reorden->fijarInicio(estado.siguienteSecuencia);
+    }
+    lineasGuardadas = lineas;
+    hayGuardado = true;
+    return true;
+}
+
+int SesionDecodificacion::procesarFuente(int maxLineas) {
+    if (formato == FORMATO_DESCONOCIDO) {
+        const char* datos;
+        size_t disponibles;
+        int estado = fuente->asomarBytes(&datos, &disponibles);
+        if (estado == FuenteDeLineas::SIN_DATOS) return 0;
+        if (estado == FuenteDeLineas::FIN_DE_FUENTE) {
+            terminada = true;
+            return 0;
+        }
+        if (esInicioBinario(datos[0])) {
+            formato = FORMATO_BINARIO;
+        } else if (datos[0] == 'S' || datos[0] == 's') {
+            formato = FORMATO_SECUENCIADO;
+        } else {
+            formato = FORMATO_TEXTO;
+        }
+    }
+    if (formato == FORMATO_BINARIO) return procesarBinario(maxLineas);
+    if (formato == FORMATO_SECUENCIADO && reorden == nullptr) {
+        reorden = new BufferDeReorden(capacidadReorden, esperaReorden);
+    }
+
+    char racha[TAMANIO_RACHA];
+    TramaCompacta tramas[TAMANIO_LOTE];
+    int enRacha = 0;
+    int tamanioRotor = rotor.getTamanio();
+    int consumidas = 0;
+    long long mapas = 0;
+    long long giros = 0;
+
+    while (consumidas < maxLineas && !terminada) {
+        int capacidad = maxLineas - consumidas;
+        if (capacidad > TAMANIO_LOTE) capacidad = TAMANIO_LOTE;
+        int leidas;
+        int cantidad = (reorden != nullptr) ? leerTramasSecuenciadas(tramas, capacidad, &leidas)
+                                            : leerTramas(tramas, capacidad, &leidas);
+        if (leidas == 0 && cantidad == 0) break;
+        consumidas += leidas;
+        lineas += leidas;
+
+        for (int i = 0; i < cantidad; i++) {
+            const TramaCompacta& trama = tramas[i];
+            if (trama.tipo == TRAMA_LOAD) {
+                racha[enRacha++] = (char)trama.valor;
+                if (enRacha == TAMANIO_RACHA) {
+                    decodificarRacha(racha, enRacha);
+                    enRacha = 0;
+                }
+            } else if (trama.tipo == TRAMA_MAP) {
+                if (enRacha > 0) {
+                    decodificarRacha(racha, enRacha);
+                    enRacha = 0;
+                }
+                PRT7_METRICA_MUESTREO(Metricas::ETAPA_ROTOR, medir);
+                PRT7_METRICA_INICIO_SI(medir, inicioRotor);
+                if (tamanioRotor > 0) {
+                    rotor.setPosicion(rotor.getPosicion() + trama.valor % tamanioRotor);
+                }
+                PRT7_METRICA_FIN(Metricas::ETAPA_ROTOR, inicioRotor);
+                mapas++;
+            } else if (trama.tipo == TRAMA_ROTOR) {
+                // Las cargas pendientes se decodifican con la cascada anterior al giro
+                if (enRacha > 0) {
+                    decodificarRacha(racha, enRacha);
+                    enRacha = 0;
+                }
+                CascadaDeRotores* cascada = rotor.getCascada();
+                if (cascada != nullptr && cascada->rotar(trama.indice, trama.valor)) {
+                    giros++;
+                } else {
+                    invalidas++;
+                    PRT7_METRICA_ERROR(ERROR_ROTOR_INEXISTENTE);
+                }
+            } else {
+                invalidas++;
+                PRT7_METRICA_ERROR((ErrorTrama)trama.valor);
+            }
+        }
+    }
+    if (enRacha > 0) {
+        decodificarRacha(racha, enRacha);
+    }
+    if (mapas > 0) PRT7_METRICA_TRAMAS(TRAMA_MAP, mapas);
+    if (giros > 0) PRT7_METRICA_TRAMAS(TRAMA_ROTOR, giros);
+
+    return consumidas;
+}
+
+bool SesionDecodificacion::esBinaria() const {
+    return formato == FORMATO_BINARIO;
+}
+
+void SesionDecodificacion::setReorden(int capacidad, int esperaMs) {
+    capacidadReorden = capacidad;
+    esperaReorden = esperaMs;
+}
+
+const BufferDeReorden* SesionDecodificacion::getReorden() const {
+    return reorden;
+}
+
+bool SesionDecodificacion::tieneTramasEnEspera() const {
+    return reorden != nullptr && !reorden->estaVacio();
+}
+
+bool SesionDecodificacion::estaTerminada() const {
+    return terminada;
+}
+
+const char* SesionDecodificacion::getNombre() const {
+    return nombre;
+}
+
+FuenteDeLineas* SesionDecodificacion::getFuente() const {
+    return fuente;
+}
+
+ListaDeCarga* SesionDecodificacion::getCarga() {
+    return &carga;
+}
+
+RotorDeMapeo* SesionDecodificacion::getRotor() {
+    return &rotor;
+}
+
+long long SesionDecodificacion::getLineas() const {
+    return lineas;
+}
+
+long long SesionDecodificacion::getInvalidas() const {
+    return invalidas;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file SesionDecodificacion.h
+ * @brief Sesión de decodificación independiente: una fuente, un rotor y una lista de carga
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef SESION_DECODIFICACION_H
+#define SESION_DECODIFICACION_H
+
+#include "RotorDeMapeo.h"
+#include "ListaDeCarga.h"
+#include "TramaBinaria.h"
+
+class FuenteDeLineas;
+class PuntoDeControl;
+class BufferDeReorden;
+struct EstadoSesion;
+
+/**
+ * @class SesionDecodificacion
+ * @brief Decodifica las tramas de una fuente con su propio rotor y su propia carga
+ * @details Las sesiones no comparten estado entre sí, por lo que varias pueden
+ *          avanzar en paralelo sin sincronización. Cada llamada a
+ *          procesarDisponibles() consume sólo las líneas que ya están listas.
+ *          El formato (texto, texto con secuencia o binario) se detecta con el
+ *          primer byte recibido.
+ */
+class SesionDecodificacion {
+private:
+    /**
+     * @brief Formato del flujo de la fuente
+     */
+    enum Formato { FORMATO_DESCONOCIDO, FORMATO_TEXTO, FORMATO_BINARIO, FORMATO_SECUENCIADO };
+
+    const char* nombre;           ///< Nombre descriptivo (puerto o ruta)
+    FuenteDeLineas* fuente;       ///< Origen de las tramas (no se libera)
+    RotorDeMapeo rotor;           ///< Rotor propio de la sesión
+    ListaDeCarga carga;           ///< Carga propia de la sesión
+    long long lineas;             ///< Líneas (o tramas binarias) leídas
+    long long invalidas;          ///< Líneas que no son tramas válidas
+    bool terminada;               ///< La fuente terminó o llegó "END"
+    Formato formato;              ///< Formato detectado
+    DecodificadorBinario binario; ///< Estado del flujo binario
+    PuntoDeControl* punto;        ///< Destino de los puntos de control (no se libera), o nullptr
+    long long cadaLineas;         ///< Líneas entre puntos de control
+    long long lineasGuardadas;    ///< Líneas al escribir el último punto de control
+    bool hayGuardado;             ///< Ya existe un punto de control de esta sesión
+    BufferDeReorden* reorden;     ///< Reorden de las tramas numeradas (sólo FORMATO_SECUENCIADO)
+    int capacidadReorden;         ///< Ranuras del buffer de reorden
+    int esperaReorden;            ///< Milisegundos que un hueco detiene la entrega
+    bool finRecibido;             ///< Llegó "END" o terminó la fuente; falta vaciar el reorden
+    long long sinNumero;          ///< Líneas sin número de secuencia (inválidas) en FORMATO_SECUENCIADO
+
+    /**
+     * @brief Decodifica una racha de cargas con el kernel por lotes
+     * @param racha Caracteres de las cargas
+     * @param cantidad Número de cargas
+     */
+    void decodificarRacha(const char* racha, int cantidad);
+
+    /**
+     * @brief Decodifica los bytes disponibles de una fuente binaria
+     * @param maxLineas Presupuesto de la llamada (se traduce a bytes)
+     * @return Tramas decodificadas
+     */
+    int procesarBinario(int maxLineas);
+
+    /**
+     * @brief Clasifica las líneas de texto completas que la fuente ya tiene
+     * @param tramas Destino de las tramas clasificadas
+     * @param capacidad Máximo de líneas a consumir
+     * @param leidas Recibe las líneas consumidas (0 si no había ninguna completa)
+     * @return Entradas escritas en tramas; las líneas vacías y "END" no escriben
+     * @details Pasa los bytes expuestos por la fuente a clasificarLote(), sin
+     *          copiarlos; si no contienen ninguna línea completa recurre a
+     *          leerLineaDisponible(), que sabe rellenar, esperar o entregar la
+     *          última línea sin '\n'. Marca la sesión como terminada con "END"
+     *          o al final de la fuente.
+     */
+    int leerTramas(TramaCompacta* tramas, int capacidad, int* leidas);
+
+    /**
+     * @brief Lee líneas "S,n,TRAMA" y entrega en orden las tramas listas
+     * @param tramas Destino de las tramas en orden de secuencia
+     * @param capacidad Máximo de líneas a consumir y de tramas a entregar
+     * @param leidas Recibe las líneas consumidas
+     * @return Entradas escritas en tramas; puede haber tramas sin líneas nuevas
+     *         (un hueco que venció) y líneas sin tramas (esperan a una anterior)
+     * @details Las líneas sin prefijo de secuencia se entregan al llegar como
+     *          inválidas. "END" o el final de la fuente vacían el buffer sin
+     *          esperar los huecos; la sesión termina cuando ya no queda nada.
+     */
+    int leerTramasSecuenciadas(TramaCompacta* tramas, int capacidad, int* leidas);
+
+    /**
+     * @brief Detecta el formato y decodifica lo disponible, sin puntos de control
+     * @param maxLineas Máximo de líneas a consumir
+     * @return Líneas (o tramas binarias) consumidas
+     */
+    int procesarFuente(int maxLineas);
+
+    /**
+     * @brief Escribe un punto de control si ya toca y el estado es consistente
+     */
+    void guardarSiToca();
+
+public:
+    static const int TAMANIO_RACHA = 4096; ///< Cargas acumuladas antes de decodificar en lote
+    static const int BYTES_POR_LINEA = 64; ///< Bytes binarios que equivalen a una línea de presupuesto
+    static const int TAMANIO_LOTE = 1024;  ///< Líneas de texto clasificadas por llamada a clasificarLote()
+
+    /**
+     * @brief Constructor
+     * @param nombre Nombre descriptivo de la sesión
+     * @param fuente Origen de las tramas
+     */
+    SesionDecodificacion(const char* nombre, FuenteDeLineas* fuente);
+
+    /**
+     * @brief Destructor: libera el buffer de reorden
+     */
+    ~SesionDecodificacion();
+
+    /**
+     * @brief Decodifica las líneas que la fuente tenga disponibles
+     * @param maxLineas Máximo de líneas a consumir en esta llamada
+     * @return Número de líneas consumidas (0 si no había datos)
+     * @details Las líneas de texto se clasifican por lotes sobre el buffer de
+     *          la fuente, las cargas consecutivas se decodifican con el kernel
+     *          por lotes y las tramas MAP sólo mueven la posición del rotor. Una línea "END"
+     *          termina la sesión, igual que en el puerto serial. En formato
+     *          binario se consumen hasta maxLineas * BYTES_POR_LINEA bytes y se
+     *          devuelve el número de tramas decodificadas.
+     */
+    int procesarDisponibles(int maxLineas);
+
+    /**
+     * @brief Activa los puntos de control periódicos
+     * @param destino Punto de control donde escribir (no se libera)
+     * @param lineasEntrePuntos Líneas (o tramas binarias) entre dos puntos de control
+     * @details También se escribe uno al terminar la sesión. En formato binario
+     *          se espera a que no quede una trama a medias.
+     */
+    void setPuntoDeControl(PuntoDeControl* destino, long long lineasEntrePuntos);
+
+    /**
+     * @brief Continúa la sesión desde un punto de control
+     * @param estado Estado guardado
+     * @param origen Punto de control que contiene la carga guardada
+     * @return false si la fuente no se pudo posicionar o el estado no corresponde
+     * @details Debe llamarse antes de procesar. No se vuelve a decodificar
+     *          ninguna trama: se restauran el rotor y los contadores, la carga
+     *          continúa tras la guardada (que queda en el archivo, sin leerse)
+     *          y la fuente salta al byte siguiente al último
+     *          consumido (si la fuente no se puede posicionar, como un puerto,
+     *          se sigue con lo que llegue).
+     */
+    bool restaurar(const EstadoSesion& estado, PuntoDeControl* origen);
+
+    /**
+     * @brief Configura el buffer de reorden para las fuentes con tramas numeradas
+     * @param capacidad Tramas que pueden esperar a una anterior
+     * @param esperaMs Milisegundos que una trama faltante puede detener la entrega
+     * @details Debe llamarse antes de procesar. Sólo tiene efecto si la fuente
+     *          envía la variante "S,n,TRAMA"; por defecto se usan
+     *          BufferDeReorden::CAPACIDAD_POR_DEFECTO y ESPERA_POR_DEFECTO_MS.
+     */
+    void setReorden(int capacidad, int esperaMs);
+
+    /**
+     * @brief Indica si la fuente envía tramas en formato binario
+     * @return true si el flujo se detectó como binario
+     */
+    bool esBinaria() const;
+
+    /**
+     * @brief Obtiene el buffer de reorden de la sesión
+     * @return Buffer con las estadísticas de orden y pérdida, o nullptr si la
+     *         fuente no envía tramas numeradas
+     */
+    const BufferDeReorden* getReorden() const;
+
+    /**
+     * @brief Indica si hay tramas numeradas esperando a una anterior
+     * @return true si la sesión debe volver a procesarse aunque la fuente no
+     *         traiga datos, para que el hueco pueda vencer
+     */
+    bool tieneTramasEnEspera() const;
+
+    /**
+     * @brief Indica si la sesión ya no recibirá más tramas
+     * @return true si terminó
+     */
+    bool estaTerminada() const;
+
+    /**
+     * @brief Obtiene el nombre de la sesión
+     * @return Nombre descriptivo
+     */
+    const char* getNombre() const;
+
+    /**
+     * @brief Obtiene la fuente de la sesión
+     * @return Puntero a la fuente
+     */
+    FuenteDeLineas* getFuente() const;
+
+    /**
+     * @brief Obtiene la lista de carga de la sesión
+     * @return Puntero a la lista de carga
+     */
+    ListaDeCarga* getCarga();
+
+    /**
+     * @brief Obtiene el rotor de la sesión
+     * @return Puntero al rotor
+     */
+    RotorDeMapeo* getRotor();
+
+    /**
+     * @brief Obtiene el número de líneas leídas
+     * @return Líneas leídas
+     */
+    long long getLineas() const;
+
+    /**
+     * @brief Obtiene el número de líneas inválidas
+     * @return Líneas inválidas
+     */
+    long long getInvalidas() const;
+};
+
+#endif // SESION_DECODIFICACION_H
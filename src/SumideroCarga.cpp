@@ -0,0 +1,118 @@
+/**
+ * @file SumideroCarga.cpp
+ * @brief Implementación de SumideroArchivo
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "SumideroCarga.h"
+#include <iostream>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+SumideroArchivo::SumideroArchivo(const char* ruta)
+    : archivo(nullptr), descriptor(-1), propietario(false), escritos(0), abierto(false) {
+    bool esStdout = (strcmp(ruta, "-") == 0);
+
+#ifdef _WIN32
+    if (esStdout) {
+        archivo = stdout;
+    } else {
+        archivo = fopen(ruta, "wb");
+        propietario = true;
+    }
+    if (archivo != nullptr) {
+        setvbuf(archivo, nullptr, _IOFBF, 1 << 20);
+        abierto = true;
+    }
+#else
+    if (esStdout) {
+        descriptor = STDOUT_FILENO;
+    } else {
+        descriptor = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        propietario = true;
+    }
+    abierto = (descriptor != -1);
+#endif
+
+    if (!abierto) {
+        std::cerr << "Error: No se pudo crear el destino de la carga " << ruta << std::endl;
+    }
+}
+
+SumideroArchivo::~SumideroArchivo() {
+    vaciar();
+#ifdef _WIN32
+    if (archivo != nullptr && propietario) fclose(archivo);
+#else
+    if (descriptor != -1 && propietario) close(descriptor);
+#endif
+}
+
+bool SumideroArchivo::escribir(const char* const* fragmentos, const int* longitudes, int cantidad) {
+    if (!abierto) return false;
+
+#ifdef _WIN32
+    for (int i = 0; i < cantidad; i++) {
+        if (fwrite(fragmentos[i], 1, (size_t)longitudes[i], archivo) != (size_t)longitudes[i]) return false;
+        escritos += longitudes[i];
+    }
+    return true;
+#else
+    struct iovec vectores[MAX_FRAGMENTOS];
+    int i = 0;
+    while (i < cantidad) {
+        int n = 0;
+        while (n < MAX_FRAGMENTOS && i + n < cantidad) {
+            vectores[n].iov_base = (void*)fragmentos[i + n];
+            vectores[n].iov_len = (size_t)longitudes[i + n];
+            n++;
+        }
+
+        // writev puede escribir menos de lo pedido: avanzar sobre lo escrito y repetir
+        struct iovec* pendiente = vectores;
+        int restantes = n;
+        while (restantes > 0) {
+            ssize_t r = writev(descriptor, pendiente, restantes);
+            if (r < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            escritos += r;
+            while (restantes > 0 && (size_t)r >= pendiente->iov_len) {
+                r -= (ssize_t)pendiente->iov_len;
+                pendiente++;
+                restantes--;
+            }
+            if (restantes > 0) {
+                pendiente->iov_base = (char*)pendiente->iov_base + r;
+                pendiente->iov_len -= (size_t)r;
+            }
+        }
+        i += n;
+    }
+    return true;
+#endif
+}
+
+bool SumideroArchivo::vaciar() {
+#ifdef _WIN32
+    return archivo == nullptr || fflush(archivo) == 0;
+#else
+    return true;
+#endif
+}
+
+bool SumideroArchivo::estaAbierto() const {
+    return abierto;
+}
+
+long long SumideroArchivo::getEscritos() const {
+    return escritos;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file SumideroCarga.h
+ * @brief Destinos de la carga decodificada en modo de flujo continuo
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef SUMIDERO_CARGA_H
+#define SUMIDERO_CARGA_H
+
+#include <cstdio>
+
+/**
+ * @class SumideroCarga
+ * @brief Recibe la carga que ListaDeCarga ya no conserva en memoria
+ * @details ListaDeCarga entrega varios bloques completos por llamada, en
+ *          orden, para que cada implementación los escriba con el menor
+ *          número de llamadas al sistema.
+ */
+class SumideroCarga {
+public:
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~SumideroCarga() {}
+
+    /**
+     * @brief Escribe varios fragmentos consecutivos de la carga
+     * @param fragmentos Inicio de cada fragmento
+     * @param longitudes Bytes de cada fragmento
+     * @param cantidad Número de fragmentos
+     * @return false si no se pudo escribir todo
+     */
+    virtual bool escribir(const char* const* fragmentos, const int* longitudes, int cantidad) = 0;
+
+    /**
+     * @brief Envía al destino lo que la implementación tenga pendiente
+     * @return false si hubo un error de escritura
+     */
+    virtual bool vaciar() { return true; }
+};
+
+/**
+ * @class SumideroArchivo
+ * @brief Escribe la carga en un archivo, una tubería o la salida estándar
+ * @details En POSIX usa writev() sobre el descriptor, sin copiar los bloques;
+ *          en Windows, fwrite() con un buffer grande.
+ */
+class SumideroArchivo : public SumideroCarga {
+private:
+    FILE* archivo;        ///< Flujo de salida (Windows)
+    int descriptor;       ///< Descriptor de salida (POSIX)
+    bool propietario;     ///< true si hay que cerrar el destino al destruir
+    long long escritos;   ///< Bytes escritos
+    bool abierto;         ///< Estado de apertura
+
+public:
+    static const int MAX_FRAGMENTOS = 64; ///< Fragmentos por llamada a writev()
+
+    /**
+     * @brief Constructor
+     * @param ruta Archivo a crear (se trunca), o "-" para la salida estándar
+     */
+    SumideroArchivo(const char* ruta);
+
+    /**
+     * @brief Destructor: vacía y cierra el destino
+     */
+    virtual ~SumideroArchivo();
+
+    virtual bool escribir(const char* const* fragmentos, const int* longitudes, int cantidad) override;
+    virtual bool vaciar() override;
+
+    /**
+     * @brief Verifica si el destino se abrió correctamente
+     * @return true si se puede escribir
+     */
+    bool estaAbierto() const;
+
+    /**
+     * @brief Obtiene los bytes escritos
+     * @return Bytes escritos desde la apertura
+     */
+    long long getEscritos() const;
+};
+
+#endif // SUMIDERO_CARGA_H
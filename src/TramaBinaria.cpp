@@ -0,0 +1,200 @@
+/**
+ * @file TramaBinaria.cpp
+ * @brief Implementación del formato binario de tramas PRT-7
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "TramaBinaria.h"
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include "ListaDeCarga.h"
+#include "DecodificacionLote.h"
+#include "CodificacionEnteros.h"
+#include "Metricas.h"
+
+int codificarTramaBinaria(const TramaCompacta& trama, char* destino) {
+    if (trama.tipo == TRAMA_LOAD) {
+        destino[0] = (char)ETIQUETA_LOAD;
+        destino[1] = (char)trama.valor;
+        return 2;
+    }
+    // Zigzag: las rotaciones pequeñas negativas también ocupan un solo byte
+    unsigned int zigzag = codificarZigzag(trama.valor);
+    unsigned char* bytes = (unsigned char*)destino;
+    if (trama.tipo == TRAMA_MAP) {
+        destino[0] = (char)ETIQUETA_MAP;
+        return 1 + escribirVarint(zigzag, bytes + 1);
+    }
+    if (trama.tipo == TRAMA_ROTOR && trama.indice >= 0) {
+        destino[0] = (char)ETIQUETA_ROTOR;
+        int n = 1 + escribirVarint((unsigned int)trama.indice, bytes + 1);
+        return n + escribirVarint(zigzag, bytes + n);
+    }
+    return 0;
+}
+
+int codificarCabeceraLote(int cantidad, char* destino) {
+    destino[0] = (char)ETIQUETA_LOTE;
+    return 1 + escribirVarint((unsigned int)cantidad, (unsigned char*)destino + 1);
+}
+
+DecodificadorBinario::DecodificadorBinario()
+    : estado(ESPERANDO_ETIQUETA), acumulado(0), desplazamiento(0), restantesLote(0),
+      indiceRotor(0), tramas(0), invalidas(0) {}
+
+long long DecodificadorBinario::procesar(const char* datos, size_t cantidad,
+                                         RotorDeMapeo* rotor, ListaDeCarga* carga) {
+    char racha[TAMANIO_RACHA];
+    int enRacha = 0;
+    long long completadas = 0;
+    long long rotaciones = 0;
+    long long giros = 0;
+    int tamanioRotor = rotor->getTamanio();
+
+    size_t i = 0;
+    while (i < cantidad) {
+        unsigned char byte = (unsigned char)datos[i];
+
+        switch (estado) {
+        case ESPERANDO_ETIQUETA:
+            i++;
+            acumulado = 0;
+            desplazamiento = 0;
+            if (byte == ETIQUETA_LOAD) {
+                estado = LEYENDO_CARGA;
+            } else if (byte == ETIQUETA_MAP) {
+                estado = LEYENDO_ROTACION;
+            } else if (byte == ETIQUETA_LOTE) {
+                estado = LEYENDO_LONGITUD_LOTE;
+            } else if (byte == ETIQUETA_ROTOR) {
+                estado = LEYENDO_INDICE_ROTOR;
+            } else {
+                invalidas++;
+                PRT7_METRICA_ERROR(ERROR_BINARIO_INVALIDO);
+            }
+            break;
+
+        case LEYENDO_CARGA:
+            i++;
+            racha[enRacha++] = (char)byte;
+            if (enRacha == TAMANIO_RACHA) {
+                decodificarEInsertar(racha, enRacha, rotor, carga);
+                enRacha = 0;
+            }
+            completadas++;
+            estado = ESPERANDO_ETIQUETA;
+            break;
+
+        case LEYENDO_ROTACION:
+        case LEYENDO_LONGITUD_LOTE:
+        case LEYENDO_INDICE_ROTOR:
+        case LEYENDO_ROTACION_ROTOR: {
+            i++;
+            // El quinto byte sólo aporta 4 bits y no puede pedir continuación
+            if (desplazamiento == 28 && byte > 0x0F) {
+                invalidas++;
+                PRT7_METRICA_ERROR(ERROR_BINARIO_INVALIDO);
+                estado = ESPERANDO_ETIQUETA;
+                break;
+            }
+            acumulado |= (unsigned int)(byte & 0x7F) << desplazamiento;
+            desplazamiento += 7;
+            if (byte & 0x80) break;
+
+            if (estado == LEYENDO_ROTACION) {
+                int rotacion = decodificarZigzag(acumulado);
+                if (enRacha > 0) {
+                    decodificarEInsertar(racha, enRacha, rotor, carga);
+                    enRacha = 0;
+                }
+                if (tamanioRotor > 0) {
+                    rotor->setPosicion(rotor->getPosicion() + rotacion % tamanioRotor);
+                }
+                completadas++;
+                rotaciones++;
+                estado = ESPERANDO_ETIQUETA;
+            } else if (estado == LEYENDO_ROTACION_ROTOR) {
+                int rotacion = decodificarZigzag(acumulado);
+                if (enRacha > 0) {
+                    decodificarEInsertar(racha, enRacha, rotor, carga);
+                    enRacha = 0;
+                }
+                CascadaDeRotores* cascada = rotor->getCascada();
+                if (cascada != nullptr && cascada->rotar(indiceRotor, rotacion)) {
+                    completadas++;
+                    giros++;
+                } else {
+                    invalidas++;
+                    PRT7_METRICA_ERROR(ERROR_ROTOR_INEXISTENTE);
+                }
+                estado = ESPERANDO_ETIQUETA;
+            } else if (acumulado > 0x7FFFFFFFu) {
+                invalidas++;
+                PRT7_METRICA_ERROR(ERROR_BINARIO_INVALIDO);
+                estado = ESPERANDO_ETIQUETA;
+            } else if (estado == LEYENDO_INDICE_ROTOR) {
+                indiceRotor = (int)acumulado;
+                acumulado = 0;
+                desplazamiento = 0;
+                estado = LEYENDO_ROTACION_ROTOR;
+            } else {
+                restantesLote = (int)acumulado;
+                estado = restantesLote > 0 ? LEYENDO_LOTE : ESPERANDO_ETIQUETA;
+            }
+            break;
+        }
+
+        case LEYENDO_LOTE: {
+            // El lote se decodifica en el lugar, sin pasar por la racha
+            if (enRacha > 0) {
+                decodificarEInsertar(racha, enRacha, rotor, carga);
+                enRacha = 0;
+            }
+            size_t disponibles = cantidad - i;
+            int tomar = (size_t)restantesLote < disponibles ? restantesLote : (int)disponibles;
+            decodificarEInsertar(datos + i, tomar, rotor, carga);
+            i += (size_t)tomar;
+            restantesLote -= tomar;
+            completadas += tomar;
+            if (restantesLote == 0) estado = ESPERANDO_ETIQUETA;
+            break;
+        }
+        }
+    }
+
+    if (enRacha > 0) {
+        decodificarEInsertar(racha, enRacha, rotor, carga);
+    }
+    tramas += completadas;
+    PRT7_METRICA_TRAMAS(TRAMA_LOAD, completadas - rotaciones - giros);
+    PRT7_METRICA_TRAMAS(TRAMA_MAP, rotaciones);
+    PRT7_METRICA_TRAMAS(TRAMA_ROTOR, giros);
+    return completadas;
+}
+
+void DecodificadorBinario::finalizar() {
+    if (estado != ESPERANDO_ETIQUETA) {
+        invalidas++;
+        PRT7_METRICA_ERROR(ERROR_BINARIO_INVALIDO);
+    }
+    estado = ESPERANDO_ETIQUETA;
+    restantesLote = 0;
+}
+
+bool DecodificadorBinario::enReposo() const {
+    return estado == ESPERANDO_ETIQUETA;
+}
+
+void DecodificadorBinario::restaurarContadores(long long tramasPrevias, long long invalidasPrevias) {
+    tramas = tramasPrevias;
+    invalidas = invalidasPrevias;
+}
+
+long long DecodificadorBinario::getTramas() const {
+    return tramas;
+}
+
+long long DecodificadorBinario::getInvalidas() const {
+    return invalidas;
+}
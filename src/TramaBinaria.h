@@ -0,0 +1,146 @@
+/**
+ * @file TramaBinaria.h
+ * @brief Codificación binaria compacta de las tramas PRT-7
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef TRAMA_BINARIA_H
+#define TRAMA_BINARIA_H
+
+#include <cstddef>
+#include "TramaCompacta.h"
+
+class ListaDeCarga;
+class RotorDeMapeo;
+
+/**
+ * @brief Etiquetas del formato binario
+ * @details Formato de cada trama:
+ *          - 0x01 X            : LOAD con el byte X (2 bytes en lugar de "L,X\n")
+ *          - 0x02 varint(zz(N)): MAP con rotación N en zigzag + varint LEB128
+ *          - 0x03 varint(n) X1..Xn : lote de n cargas consecutivas
+ *          - 0x04 varint(k) varint(zz(N)): rotación N del rotor k de la cascada
+ *          Ninguna etiqueta es un carácter imprimible, así que el primer byte
+ *          de un flujo basta para distinguirlo de una captura de texto.
+ */
+enum EtiquetaBinaria {
+    ETIQUETA_LOAD = 0x01, ///< Una carga
+    ETIQUETA_MAP = 0x02,  ///< Una rotación
+    ETIQUETA_LOTE = 0x03, ///< Varias cargas con prefijo de longitud
+    ETIQUETA_ROTOR = 0x04 ///< Una rotación de un rotor de la cascada
+};
+
+static const int MAX_BYTES_VARINT = 5;                         ///< Un entero de 32 bits en LEB128
+static const int MAX_BYTES_TRAMA_BINARIA = 1 + 2 * MAX_BYTES_VARINT; ///< Trama o cabecera de lote más larga
+
+/**
+ * @brief Indica si un flujo que empieza con este byte está en formato binario
+ * @param primerByte Primer byte del flujo
+ * @return true si es una etiqueta binaria
+ */
+inline bool esInicioBinario(char primerByte) {
+    return primerByte >= ETIQUETA_LOAD && primerByte <= ETIQUETA_ROTOR;
+}
+
+/**
+ * @brief Codifica una trama LOAD, MAP o ROTOR en formato binario
+ * @param trama Trama a codificar
+ * @param destino Buffer de al menos MAX_BYTES_TRAMA_BINARIA bytes
+ * @return Bytes escritos, o 0 si la trama es inválida
+ */
+int codificarTramaBinaria(const TramaCompacta& trama, char* destino);
+
+/**
+ * @brief Codifica la cabecera de un lote de cargas
+ * @param cantidad Número de cargas que seguirán a la cabecera
+ * @param destino Buffer de al menos MAX_BYTES_TRAMA_BINARIA bytes
+ * @return Bytes escritos; los `cantidad` caracteres se escriben a continuación tal cual
+ */
+int codificarCabeceraLote(int cantidad, char* destino);
+
+/**
+ * @class DecodificadorBinario
+ * @brief Decodifica un flujo binario por bloques arbitrarios
+ * @details Es una máquina de estados, así que una trama puede quedar partida
+ *          entre dos bloques. Las cargas sueltas se acumulan en una racha y los
+ *          lotes se decodifican directamente desde el bloque de entrada con
+ *          decodificarEInsertar(), sin copiarlos. Las rotaciones sólo mueven
+ *          la posición del rotor, como en SesionDecodificacion. Una etiqueta
+ *          desconocida, un varint demasiado largo o una rotación para un rotor
+ *          que la cascada no tiene cuenta como trama inválida y la
+ *          decodificación continúa en el siguiente byte.
+ */
+class DecodificadorBinario {
+private:
+    /**
+     * @brief Parte de la trama que se espera a continuación
+     */
+    enum Estado {
+        ESPERANDO_ETIQUETA,
+        LEYENDO_CARGA,
+        LEYENDO_ROTACION,
+        LEYENDO_LONGITUD_LOTE,
+        LEYENDO_LOTE,
+        LEYENDO_INDICE_ROTOR,
+        LEYENDO_ROTACION_ROTOR
+    };
+
+    static const int TAMANIO_RACHA = 4096; ///< Cargas sueltas acumuladas antes de decodificar
+
+    Estado estado;            ///< Estado actual de la máquina
+    unsigned int acumulado;   ///< Varint en construcción
+    int desplazamiento;       ///< Bits ya leídos del varint
+    int restantesLote;        ///< Cargas que faltan del lote en curso
+    int indiceRotor;          ///< Rotor de la cascada de la trama ROTOR en curso
+    long long tramas;         ///< Tramas completas decodificadas
+    long long invalidas;      ///< Etiquetas o varints inválidos
+
+public:
+    /**
+     * @brief Constructor
+     */
+    DecodificadorBinario();
+
+    /**
+     * @brief Decodifica un bloque del flujo y aplica las tramas
+     * @param datos Bytes del flujo
+     * @param cantidad Número de bytes (se consumen todos)
+     * @param rotor Rotor de la sesión
+     * @param carga Lista donde se insertan los caracteres decodificados
+     * @return Tramas completadas en este bloque (cada carga de un lote cuenta como una)
+     */
+    long long procesar(const char* datos, size_t cantidad, RotorDeMapeo* rotor, ListaDeCarga* carga);
+
+    /**
+     * @brief Indica que el flujo terminó; una trama a medias cuenta como inválida
+     */
+    void finalizar();
+
+    /**
+     * @brief Indica si no hay ninguna trama a medias
+     * @return true si el siguiente byte del flujo debe ser una etiqueta
+     */
+    bool enReposo() const;
+
+    /**
+     * @brief Restablece los contadores al reanudar desde un punto de control
+     * @param tramasPrevias Tramas decodificadas antes del punto de control
+     * @param invalidasPrevias Tramas inválidas antes del punto de control
+     */
+    void restaurarContadores(long long tramasPrevias, long long invalidasPrevias);
+
+    /**
+     * @brief Obtiene el número de tramas decodificadas
+     * @return Tramas completas
+     */
+    long long getTramas() const;
+
+    /**
+     * @brief Obtiene el número de tramas inválidas
+     * @return Tramas inválidas
+     */
+    long long getInvalidas() const;
+};
+
+#endif // TRAMA_BINARIA_H
@@ -0,0 +1,133 @@
+/**
+ * @file TramaCompacta.cpp
+ * @brief Implementación de la clasificación compacta de tramas
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "TramaCompacta.h"
+#include <cstring>
+
+/**
+ * @brief Convierte un entero decimal estricto: [+-]?[0-9]+ dentro del rango de int
+ * @param texto Inicio del número
+ * @param longitud Bytes del número (todos deben formar parte de él)
+ * @param valor Recibe el valor convertido si no hay error
+ * @return ERROR_NINGUNO, ERROR_NUMERO_INVALIDO o ERROR_NUMERO_DESBORDADO
+ */
+static ErrorTrama convertirEntero(const char* texto, int longitud, int* valor) {
+    int i = 0;
+    bool negativo = false;
+    if (i < longitud && (texto[i] == '-' || texto[i] == '+')) {
+        negativo = (texto[i] == '-');
+        i++;
+    }
+    if (i == longitud) return ERROR_NUMERO_INVALIDO;
+
+    // El límite de la magnitud depende del signo: -2147483648 sí cabe
+    long long limite = negativo ? 2147483648LL : 2147483647LL;
+    long long magnitud = 0;
+    bool desbordado = false;
+    for (; i < longitud; i++) {
+        unsigned int digito = (unsigned int)(texto[i] - '0');
+        if (digito > 9) return ERROR_NUMERO_INVALIDO;
+        magnitud = magnitud * 10 + digito;
+        if (magnitud > limite) {
+            desbordado = true;
+            magnitud = limite;
+        }
+    }
+    if (desbordado) return ERROR_NUMERO_DESBORDADO;
+
+    *valor = (int)(negativo ? -magnitud : magnitud);
+    return ERROR_NINGUNO;
+}
+
+/**
+ * @brief Clasifica una línea de texto sin imprimir ni reservar memoria
+ * @param linea Inicio de la línea
+ * @param longitud Número de bytes de la línea
+ * @param error Recibe el motivo cuando la línea no es válida (opcional)
+ * @return Trama clasificada
+ */
+TramaCompacta clasificarTrama(const char* linea, int longitud, ErrorTrama* error) {
+    TramaCompacta trama;
+    trama.tipo = TRAMA_INVALIDA;
+    trama.valor = 0;
+    trama.indice = 0;
+
+    ErrorTrama motivo = ERROR_NINGUNO;
+    if (linea == nullptr || longitud < 3) {
+        motivo = ERROR_LINEA_CORTA;
+    } else if (linea[1] != ',') {
+        motivo = ERROR_SIN_COMA;
+    } else if (linea[0] == 'L' || linea[0] == 'l') {
+        if (longitud != 3) {
+            motivo = ERROR_LOAD_LONGITUD;
+        } else {
+            trama.tipo = TRAMA_LOAD;
+            trama.valor = (unsigned char)linea[2];
+        }
+    } else if (linea[0] == 'M' || linea[0] == 'm') {
+        motivo = convertirEntero(&linea[2], longitud - 2, &trama.valor);
+        if (motivo == ERROR_NINGUNO) trama.tipo = TRAMA_MAP;
+    } else if (linea[0] == 'R' || linea[0] == 'r') {
+        const char* coma = (const char*)memchr(&linea[2], ',', (size_t)(longitud - 2));
+        if (coma == nullptr) {
+            motivo = ERROR_ROTOR_FORMATO;
+        } else {
+            motivo = convertirEntero(&linea[2], (int)(coma - &linea[2]), &trama.indice);
+            if (motivo == ERROR_NINGUNO) {
+                motivo = convertirEntero(coma + 1, (int)(linea + longitud - coma - 1), &trama.valor);
+            }
+            if (motivo == ERROR_NINGUNO) trama.tipo = TRAMA_ROTOR;
+        }
+    } else {
+        motivo = ERROR_TIPO_DESCONOCIDO;
+    }
+
+    if (motivo != ERROR_NINGUNO) {
+        trama.tipo = TRAMA_INVALIDA;
+        trama.valor = motivo;
+        trama.indice = 0;
+    }
+    if (error != nullptr) *error = motivo;
+    return trama;
+}
+
+/**
+ * @brief Clasifica una línea "S,n,TRAMA"
+ * @param linea Inicio de la línea
+ * @param longitud Número de bytes de la línea
+ * @param secuencia Recibe n si el prefijo es válido
+ * @param error Recibe el motivo cuando la línea no es válida (opcional)
+ * @return Trama clasificada
+ */
+TramaCompacta clasificarTramaSecuenciada(const char* linea, int longitud, unsigned int* secuencia,
+                                         ErrorTrama* error) {
+    int i = 2;
+    unsigned long long numero = 0;
+    bool valido = linea != nullptr && longitud >= 4 && (linea[0] == 'S' || linea[0] == 's') && linea[1] == ',';
+    if (valido) {
+        for (; i < longitud && linea[i] != ','; i++) {
+            unsigned int digito = (unsigned int)(linea[i] - '0');
+            numero = numero * 10 + digito;
+            if (digito > 9 || numero > 0xFFFFFFFFULL) {
+                valido = false;
+                break;
+            }
+        }
+        valido = valido && i > 2 && i < longitud;
+    }
+
+    if (!valido) {
+        TramaCompacta trama;
+        trama.tipo = TRAMA_INVALIDA;
+        trama.valor = ERROR_SECUENCIA_FORMATO;
+        trama.indice = 0;
+        if (error != nullptr) *error = ERROR_SECUENCIA_FORMATO;
+        return trama;
+    }
+    *secuencia = (unsigned int)numero;
+    return clasificarTrama(linea + i + 1, longitud - i - 1, error);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file TramaCompacta.h
+ * @brief Representación compacta (sin herencia ni memoria dinámica) de una trama PRT-7
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef TRAMA_COMPACTA_H
+#define TRAMA_COMPACTA_H
+
+/**
+ * @brief Tipo de trama contenido en una TramaCompacta
+ */
+enum TipoTrama {
+    TRAMA_INVALIDA = 0, ///< La línea no es una trama válida
+    TRAMA_LOAD,         ///< Trama L,X: valor contiene el carácter
+    TRAMA_MAP,          ///< Trama M,N: valor contiene la rotación
+    TRAMA_ROTOR         ///< Trama R,k,N: indice contiene el rotor de la cascada y valor la rotación
+};
+
+/**
+ * @brief Motivo por el que una línea no es una trama válida
+ */
+enum ErrorTrama {
+    ERROR_NINGUNO = 0,      ///< La trama es válida
+    ERROR_LINEA_CORTA,      ///< Menos de 3 bytes
+    ERROR_SIN_COMA,         ///< Falta la coma en la segunda posición
+    ERROR_LOAD_LONGITUD,    ///< LOAD con un parámetro de más de un carácter
+    ERROR_TIPO_DESCONOCIDO, ///< El tipo no es L, M ni R
+    ERROR_BINARIO_INVALIDO, ///< Etiqueta o varint inválido en el formato binario
+    ERROR_ROTOR_FORMATO,    ///< Trama R sin la segunda coma
+    ERROR_ROTOR_INEXISTENTE,///< Trama R para un rotor que la cascada no tiene
+    ERROR_NUMERO_INVALIDO,  ///< Número de M o R vacío o con caracteres que no son dígitos
+    ERROR_NUMERO_DESBORDADO,///< Número de M o R fuera del rango de int
+    ERROR_SECUENCIA_FORMATO,///< Línea sin la forma S,n,TRAMA o con n fuera de 32 bits sin signo
+    ERROR_LINEA_LARGA,      ///< Línea más larga que cualquier trama válida (modo tubería)
+    NUM_ERRORES_TRAMA       ///< Número de motivos (no es un error)
+};
+
+/**
+ * @struct TramaCompacta
+ * @brief Trama clasificada por valor, apta para arreglos contiguos
+ * @details Se usa en los caminos de alto rendimiento que no necesitan crear
+ *          objetos TramaBase por cada línea.
+ */
+struct TramaCompacta {
+    TipoTrama tipo; ///< Tipo de la trama
+    int valor;      ///< Carácter (LOAD), rotación (MAP y ROTOR) o ErrorTrama (INVALIDA)
+    int indice;     ///< Rotor de la cascada (sólo ROTOR)
+};
+
+/**
+ * @brief Clasifica una línea de texto sin imprimir ni reservar memoria
+ * @param linea Inicio de la línea (no necesita terminar en '\0')
+ * @param longitud Número de bytes de la línea
+ * @param error Si no es nullptr, recibe el motivo cuando la línea no es válida
+ * @return Trama clasificada; tipo == TRAMA_INVALIDA si la línea no es válida
+ * @details Es la referencia de las reglas de parsearTrama() y de
+ *          clasificarLote(): longitud mínima 3, coma en la segunda posición,
+ *          un único carácter para LOAD y, para MAP y para los dos números de
+ *          ROTOR, un entero decimal estricto: signo opcional, al menos un
+ *          dígito, nada más, y dentro del rango de int.
+ */
+TramaCompacta clasificarTrama(const char* linea, int longitud, ErrorTrama* error = nullptr);
+
+/**
+ * @brief Clasifica una línea de la variante con número de secuencia: "S,n,TRAMA"
+ * @param linea Inicio de la línea (no necesita terminar en '\0')
+ * @param longitud Número de bytes de la línea
+ * @param secuencia Recibe n si el prefijo es válido
+ * @param error Si no es nullptr, recibe el motivo cuando la línea no es válida
+ * @return Trama TRAMA clasificada con clasificarTrama()
+ * @details n es un entero decimal sin signo de 32 bits (sólo dígitos) que el
+ *          emisor incrementa en cada trama y que puede dar la vuelta. Si el
+ *          prefijo es inválido el motivo es ERROR_SECUENCIA_FORMATO y secuencia
+ *          no se modifica; si sólo TRAMA es inválida, secuencia sí es válida.
+ */
+TramaCompacta clasificarTramaSecuenciada(const char* linea, int longitud, unsigned int* secuencia,
+                                         ErrorTrama* error = nullptr);
+
+#endif // TRAMA_COMPACTA_H
@@ -8,14 +8,23 @@
 #include "TramaLoad.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
-#include <iostream>
+#include "Registro.h"
+#include "Metricas.h"
 
 /**
  * @brief Constructor que almacena el carácter de la trama
  * @param c Carácter a almacenar
  */
 TramaLoad::TramaLoad(char c) : caracter(c) {
-    std::cout << "Creada TramaLoad con carácter: '" << c << "'" << std::endl;
+    PRT7_TRAZA("Creada TramaLoad con carácter: '" << c << "'\n");
+}
+
+/**
+ * @brief Reemplaza el carácter de la trama para reutilizar el objeto
+ * @param c Carácter a almacenar
+ */
+void TramaLoad::setCaracter(char c) {
+    caracter = c;
 }
 
 /**
@@ -24,8 +33,11 @@ TramaLoad::TramaLoad(char c) : caracter(c) {
  * @param rotor Rotor para el mapeo de caracteres
  */
 void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    PRT7_METRICA_INICIO(Metricas::ETAPA_CARGA, inicio);
     char caracterDecodificado = rotor->getMapeo(caracter);
-    std::cout << "Procesando TramaLoad: '" << caracter << "' -> '" << caracterDecodificado << "'" << std::endl;
     carga->insertarAlFinal(caracterDecodificado);
-    carga->imprimirEstado();
+    PRT7_METRICA_FIN(Metricas::ETAPA_CARGA, inicio);
+    PRT7_METRICA_TRAMAS(TRAMA_LOAD, 1);
+    PRT7_TRAZA("Procesando TramaLoad: '" << caracter << "' -> '" << caracterDecodificado
+               << "' (tamaño de carga=" << carga->getTamanio() << ")\n");
 }
\ No newline at end of file
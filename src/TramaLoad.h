@@ -26,6 +26,12 @@ public:
      */
     TramaLoad(char c);
     
+    /**
+     * @brief Reemplaza el carácter de la trama para reutilizar el objeto
+     * @param c Carácter a almacenar
+     */
+    void setCaracter(char c);
+    
     /**
      * @brief Procesa la trama LOAD: decodifica el carácter y lo agrega a la lista de carga
      * @param carga Lista donde se almacenan los datos decodificados
@@ -7,14 +7,23 @@
 
 #include "TramaMap.h"
 #include "RotorDeMapeo.h"
-#include <iostream>
+#include "Registro.h"
+#include "Metricas.h"
 
 /**
  * @brief Constructor que almacena la cantidad de rotación
  * @param n Número de posiciones a rotar
  */
 TramaMap::TramaMap(int n) : rotacion(n) {
-    std::cout << "Creada TramaMap con rotación: " << n << std::endl;
+    PRT7_TRAZA("Creada TramaMap con rotación: " << n << "\n");
+}
+
+/**
+ * @brief Reemplaza la cantidad de rotación para reutilizar el objeto
+ * @param n Número de posiciones a rotar
+ */
+void TramaMap::setRotacion(int n) {
+    rotacion = n;
 }
 
 /**
@@ -22,7 +31,10 @@ TramaMap::TramaMap(int n) : rotacion(n) {
  * @param carga Lista de carga (no se modifica por esta trama)
  * @param rotor Rotor a modificar
  */
-void TramaMap::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
-    std::cout << "Procesando TramaMap: rotando " << rotacion << " posiciones" << std::endl;
+void TramaMap::procesar(ListaDeCarga* /*carga*/, RotorDeMapeo* rotor) {
+    PRT7_TRAZA("Procesando TramaMap: rotando " << rotacion << " posiciones\n");
+    PRT7_METRICA_INICIO(Metricas::ETAPA_ROTOR, inicio);
     rotor->rotar(rotacion);
+    PRT7_METRICA_FIN(Metricas::ETAPA_ROTOR, inicio);
+    PRT7_METRICA_TRAMAS(TRAMA_MAP, 1);
 }
\ No newline at end of file
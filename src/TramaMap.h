@@ -26,6 +26,12 @@ public:
      */
     TramaMap(int n);
     
+    /**
+     * @brief Reemplaza la cantidad de rotación para reutilizar el objeto
+     * @param n Número de posiciones a rotar
+     */
+    void setRotacion(int n);
+    
     /**
      * @brief Procesa la trama MAP: rota el disco de cifrado
      * @param carga Lista de carga (no se modifica por esta trama)
@@ -0,0 +1,49 @@
+/**
+ * @file TramaRotor.cpp
+ * @brief Implementación de la clase TramaRotor
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#include "TramaRotor.h"
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include "Registro.h"
+#include "Metricas.h"
+
+/**
+ * @brief Constructor que almacena el rotor y la cantidad de rotación
+ * @param k Rotor de la cascada
+ * @param n Número de posiciones a rotar
+ */
+TramaRotor::TramaRotor(int k, int n) : indice(k), rotacion(n) {
+    PRT7_TRAZA("Creada TramaRotor para el rotor " << k << " con rotación: " << n << "\n");
+}
+
+/**
+ * @brief Reemplaza el rotor y la rotación para reutilizar el objeto
+ * @param k Rotor de la cascada
+ * @param n Número de posiciones a rotar
+ */
+void TramaRotor::setRotacion(int k, int n) {
+    indice = k;
+    rotacion = n;
+}
+
+/**
+ * @brief Procesa la trama: rota el rotor k de la cascada
+ * @param carga Lista de carga (no se modifica por esta trama)
+ * @param rotor Rotor principal, del que se toma la cascada
+ */
+void TramaRotor::procesar(ListaDeCarga* /*carga*/, RotorDeMapeo* rotor) {
+    PRT7_TRAZA("Procesando TramaRotor: rotando el rotor " << indice << " " << rotacion << " posiciones\n");
+    PRT7_METRICA_INICIO(Metricas::ETAPA_ROTOR, inicio);
+    CascadaDeRotores* cascada = rotor->getCascada();
+    if (cascada == nullptr || !cascada->rotar(indice, rotacion)) {
+        PRT7_RESUMEN("Error: La cascada no tiene el rotor " << indice << "\n");
+        PRT7_METRICA_ERROR(ERROR_ROTOR_INEXISTENTE);
+        return;
+    }
+    PRT7_METRICA_FIN(Metricas::ETAPA_ROTOR, inicio);
+    PRT7_METRICA_TRAMAS(TRAMA_ROTOR, 1);
+}
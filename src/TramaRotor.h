@@ -0,0 +1,50 @@
+/**
+ * @file TramaRotor.h
+ * @brief Trama de tipo MAP dirigida a un rotor concreto de la cascada
+ * @author Arturo Rosales Velázquez
+ * @date 2025
+ */
+
+#ifndef TRAMA_ROTOR_H
+#define TRAMA_ROTOR_H
+
+#include "TramaBase.h"
+
+/**
+ * @class TramaRotor
+ * @brief Trama de tipo MAP dirigida a un rotor concreto de la cascada
+ * @details Representa una trama R,k,N (ejemplo: R,1,5 o R,0,-3) que rota N
+ *          posiciones el rotor k de la CascadaDeRotores encadenada al rotor
+ *          principal. El rotor principal no cambia.
+ */
+class TramaRotor : public TramaBase {
+private:
+    int indice;    ///< Rotor de la cascada a rotar
+    int rotacion;  ///< Número de posiciones a rotar
+    
+public:
+    /**
+     * @brief Constructor que almacena el rotor y la cantidad de rotación
+     * @param k Rotor de la cascada
+     * @param n Número de posiciones a rotar
+     */
+    TramaRotor(int k, int n);
+    
+    /**
+     * @brief Reemplaza el rotor y la rotación para reutilizar el objeto
+     * @param k Rotor de la cascada
+     * @param n Número de posiciones a rotar
+     */
+    void setRotacion(int k, int n);
+    
+    /**
+     * @brief Procesa la trama: rota el rotor k de la cascada
+     * @param carga Lista de carga (no se modifica por esta trama)
+     * @param rotor Rotor principal, del que se toma la cascada
+     * @details Si el rotor no tiene cascada o ésta no tiene el rotor k, la
+     *          trama se descarta y se cuenta como inválida.
+     */
+    virtual void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+};
+
+#endif // TRAMA_ROTOR_H
@@ -8,86 +8,808 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <cstdio>
 #include "TramaBase.h"
 #include "TramaLoad.h"
 #include "TramaMap.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
 #include "SerialReader.h"
+#include "LectorCaptura.h"
+#include "PoolDeTramas.h"
+#include "FuenteDeLineas.h"
+#include "SesionDecodificacion.h"
+#include "GestorDeSesiones.h"
+#include "BucleEventos.h"
+#include "PipelineDecodificador.h"
+#include "TramaCompacta.h"
+#include "TramaBinaria.h"
+#include "ParserTramas.h"
+#include "Registro.h"
+#include "Metricas.h"
+#include "PuntoDeControl.h"
+#include "SumideroCarga.h"
+#include "CascadaDeRotores.h"
+#include "ProgramaDeTramas.h"
+#include "BufferDeReorden.h"
+#include "DecodificadorParalelo.h"
+#include <thread>
+
+/// Capacidad de las rutas compuestas por rutaDeFuente()
+static const int LONGITUD_MAXIMA_RUTA = 4096;
 
 /**
- * @brief Parsea una cadena de trama y crea el objeto correspondiente
- * @param linea Cadena a parsear (ej. "L,H" o "M,2")
- * @return Puntero a la trama creada, o nullptr si hay error
+ * @brief Procesa una secuencia de tramas desde un array de strings
+ * @param tramas Array de strings con las tramas
+ * @param cantidad Número de elementos en el array
+ * @param carga Lista de carga donde almacenar los resultados
+ * @param rotor Rotor para el mapeo
  */
-TramaBase* parsearTrama(const char* linea) {
-    if (linea == nullptr || strlen(linea) < 3) {
-        std::cout << "Error: Línea inválida o muy corta: " << (linea ? linea : "null") << std::endl;
-        return nullptr;
+void procesarSecuencia(const char* tramas[], int cantidad, ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    PRT7_RESUMEN("\n=== Procesando secuencia de " << cantidad << " tramas ===\n");
+    
+    // Las tramas se reciclan desde el pool: ninguna reserva de memoria por línea
+    PoolDeTramas pool;
+    
+    for (int i = 0; i < cantidad; i++) {
+        PRT7_TRAZA("\n--- Trama " << (i+1) << "/" << cantidad << " ---\n");
+        
+        TramaBase* trama = parsearTrama(tramas[i], &pool);
+        if (trama != nullptr) {
+            trama->procesar(carga, rotor);
+        } else {
+            PRT7_RESUMEN("ERROR: No se pudo procesar la trama: " << tramas[i] << "\n");
+        }
     }
     
-    if (linea[1] != ',') {
-        std::cout << "Error: Formato inválido (falta coma): " << linea << std::endl;
-        return nullptr;
+    PRT7_RESUMEN("\n=== Secuencia completada ===\n");
+}
+
+/**
+ * @brief Muestra las opciones de línea de comandos
+ * @param programa Nombre del ejecutable
+ */
+void mostrarUso(const char* programa) {
+    std::cerr << "Uso: " << programa << " [--nivel N]             (secuencia de ejemplo)\n"
+              << "     " << programa << " [--nivel N] [--hilos H] FUENTE...\n"
+              << "     " << programa << " --a-binario ENTRADA SALIDA  (convierte una captura de texto)\n"
+              << "FUENTE:\n"
+              << "     --archivo RUTA      captura de texto o binaria ('-' = entrada estándar)\n"
+              << "     --puerto DISP       puerto serial (p. ej. /dev/ttyUSB0)\n"
+              << "     --baudios B         velocidad de los puertos siguientes (default: 9600)\n"
+              << "     --eventos           un solo hilo atiende todas las fuentes con epoll, por turnos (Linux)\n"
+              << "     --hilos H           hilos que atienden las fuentes (default: todos los núcleos); con una\n"
+              << "                         sola captura de texto y H > 1, sus bloques se decodifican en paralelo\n"
+              << "                         (no con --cascada, --punto-control ni --eventos)\n"
+              << "     --pipeline          con una sola fuente de texto: lector, parser y decodificador en hilos separados\n"
+              << "     --programa RUTA     con una sola captura: la compila a RUTA (rotaciones netas y rachas de\n"
+              << "                         cargas) y la ejecuta; si RUTA ya corresponde a la captura, no la parsea\n"
+              << "     --metricas          resumen de métricas en stderr al terminar y con SIGUSR1\n"
+              << "     --metricas-cada MS  además, un resumen periódico cada MS milisegundos\n"
+              << "     --punto-control BASE       guarda el estado en BASE.ckpt y BASE.carga y, si ya\n"
+              << "                                existen y son de la misma captura, reanuda desde ahí\n"
+              << "                                (con varias fuentes: BASE.1, BASE.2...)\n"
+              << "     --punto-control-cada N     líneas entre puntos de control (default: 100000)\n"
+              << "     --flujo RUTA        modo de flujo: la carga se escribe en RUTA ('-' = salida estándar,\n"
+              << "                         RUTA.1, RUTA.2... con varias fuentes) a medida que se decodifica\n"
+              << "     --flujo-cola N      caracteres recientes que se conservan en memoria (default: 65536)\n"
+              << "     --ventana N         conserva e imprime sólo los últimos N caracteres decodificados\n"
+              << "     --cascada ROTORES   encadena rotores al rotor principal: ROTORES = CABLEADO[:MUESCAS],...\n"
+              << "                         (26 letras por cableado); el primero avanza con cada carga y los\n"
+              << "                         demás al pasar el anterior por una muesca. R,k,N rota el rotor k\n"
+              << "     --cascada-fija ROTORES     igual, pero los rotores sólo se mueven con R,k,N\n"
+              << "     --alfabeto NOMBRE   alfabeto del rotor: mayusculas (A-Z, default), minusculas (a-z),\n"
+              << "                         alfanumerico (A-Z0-9), base64 (A-Za-z0-9+/) o bytes (0-255);\n"
+              << "                         --cascada sólo admite mayusculas\n"
+              << "     --reorden N         fuentes con tramas numeradas (S,n,TRAMA): hasta N tramas pueden\n"
+              << "                         esperar a una anterior (default: 256)\n"
+              << "     --reorden-espera MS espera máxima por una trama numerada que falta (default: 50)\n"
+              << "N = silencioso | resumen | traza; cada fuente se decodifica en su propia sesión\n"
+              << "El formato (texto, texto numerado o binario) de cada fuente se detecta con su primer byte" << std::endl;
+}
+
+/**
+ * @brief Origen indicado en la línea de comandos
+ */
+struct OpcionFuente {
+    const char* ruta; ///< Ruta de la captura o del puerto
+    bool esPuerto;    ///< true para puerto serial
+    int baudios;      ///< Velocidad del puerto serial
+};
+
+/**
+ * @brief Opciones comunes a todas las sesiones
+ */
+struct OpcionesSesion {
+    int hilos;               ///< Hilos del gestor de sesiones o del decodificador paralelo (0 = todos los núcleos)
+    const char* basePunto;   ///< Ruta base de los puntos de control, o nullptr
+    long long cadaLineas;    ///< Líneas entre puntos de control
+    const char* rutaFlujo;   ///< Destino de la carga en modo de flujo, o nullptr
+    int colaFlujo;           ///< Caracteres que se conservan en memoria en modo de flujo
+    int ventana;             ///< Caracteres del modo ventana (0 = carga completa)
+    const char* cascada;     ///< Especificación de la cascada de rotores, o nullptr
+    bool cascadaFija;        ///< Los rotores de la cascada no avanzan con las cargas
+    const AlfabetoRotor* alfabeto; ///< Alfabeto del rotor de cada sesión
+    int reorden;             ///< Ranuras del buffer de reorden de las tramas numeradas
+    int esperaReorden;       ///< Milisegundos de espera por una trama numerada que falta
+    bool eventos;            ///< Atender las sesiones con BucleEventos en lugar del gestor
+};
+
+/**
+ * @brief Ruta propia de una fuente cuando hay varias
+ * @param base Ruta indicada en la línea de comandos
+ * @param indice Índice de la fuente
+ * @param cantidad Número de fuentes
+ * @param ruta Recibe base, o base.N con varias fuentes ("-" no cambia)
+ * @param capacidad Tamaño de ruta en bytes
+ * @return false si la ruta no cabe en el buffer
+ */
+bool rutaDeFuente(const char* base, int indice, int cantidad, char* ruta, int capacidad) {
+    int escritos;
+    if (cantidad > 1 && strcmp(base, "-") != 0) {
+        escritos = snprintf(ruta, (size_t)capacidad, "%s.%d", base, indice + 1);
+    } else {
+        escritos = snprintf(ruta, (size_t)capacidad, "%s", base);
     }
+    if (escritos < 0 || escritos >= capacidad) {
+        std::cerr << "Error: Ruta demasiado larga: " << base << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodifica varias fuentes, cada una en su propia sesión
+ * @param opciones Fuentes indicadas en la línea de comandos
+ * @param cantidad Número de fuentes
+ * @param comunes Opciones de las sesiones
+ * @return Código de salida del programa
+ */
+int ejecutarSesiones(const OpcionFuente* opciones, int cantidad, const OpcionesSesion& comunes) {
+    SerialReader** puertos = new SerialReader*[cantidad];
+    LectorCaptura** capturas = new LectorCaptura*[cantidad];
+    FuenteDeLineas** fuentes = new FuenteDeLineas*[cantidad];
+    SesionDecodificacion** sesiones = new SesionDecodificacion*[cantidad];
+    PuntoDeControl** puntos = new PuntoDeControl*[cantidad];
+    SumideroArchivo** sumideros = new SumideroArchivo*[cantidad];
+    CascadaDeRotores** cascadas = new CascadaDeRotores*[cantidad];
+    int abiertas = 0;
+    int codigo = 0;
     
-    char tipo = linea[0]; 
-    const char* parametro = &linea[2]; 
+    GestorDeSesiones gestor(comunes.hilos);
+    for (int i = 0; i < cantidad; i++) {
+        puertos[i] = nullptr;
+        capturas[i] = nullptr;
+        fuentes[i] = nullptr;
+        sesiones[i] = nullptr;
+        puntos[i] = nullptr;
+        sumideros[i] = nullptr;
+        cascadas[i] = nullptr;
+        
+        if (opciones[i].esPuerto) {
+            puertos[i] = new SerialReader(opciones[i].ruta, opciones[i].baudios);
+            if (!puertos[i]->estaConectado()) {
+                codigo = 1;
+                continue;
+            }
+            fuentes[i] = new FuenteSerial(puertos[i]);
+        } else {
+            capturas[i] = new LectorCaptura(opciones[i].ruta);
+            if (!capturas[i]->estaAbierto()) {
+                codigo = 1;
+                continue;
+            }
+            fuentes[i] = new FuenteCaptura(capturas[i]);
+        }
+        sesiones[i] = new SesionDecodificacion(opciones[i].ruta, fuentes[i]);
+        sesiones[i]->getRotor()->setAlfabeto(comunes.alfabeto);
+        sesiones[i]->setReorden(comunes.reorden, comunes.esperaReorden);
+        
+        if (comunes.basePunto != nullptr) {
+            char base[LONGITUD_MAXIMA_RUTA];
+            if (!rutaDeFuente(comunes.basePunto, i, cantidad, base, LONGITUD_MAXIMA_RUTA)) {
+                delete sesiones[i];
+                sesiones[i] = nullptr;
+                codigo = 1;
+                continue;
+            }
+            // Un puerto o la entrada estándar no tienen firma: bytes = -1
+            FirmaCaptura firma;
+            firma.bytes = -1;
+            firma.modificacion = 0;
+            if (!opciones[i].esPuerto) ProgramaDeTramas::leerFirma(opciones[i].ruta, &firma);
+            puntos[i] = new PuntoDeControl(base, firma);
+            if (puntos[i]->estaAbierto() && !puntos[i]->esDeLaCaptura()) {
+                std::cerr << "Error: " << base << ".ckpt es de otra versión de " << opciones[i].ruta
+                          << "; bórrelo (y " << base << ".carga) para empezar de nuevo" << std::endl;
+                delete sesiones[i];
+                sesiones[i] = nullptr;
+                codigo = 1;
+                continue;
+            }
+            EstadoSesion estado;
+            bool reanudar = puntos[i]->leerUltimo(&estado);
+            if (!puntos[i]->estaAbierto() || (reanudar && !sesiones[i]->restaurar(estado, puntos[i]))) {
+                delete sesiones[i];
+                sesiones[i] = nullptr;
+                codigo = 1;
+                continue;
+            }
+            if (reanudar) {
+                PRT7_RESUMEN("Reanudando " << opciones[i].ruta << " desde " << base << ".ckpt: "
+                             << estado.secuencia << " líneas, " << estado.bytesCarga << " caracteres\n");
+            }
+            sesiones[i]->setPuntoDeControl(puntos[i], comunes.cadaLineas);
+        }
+        if (comunes.rutaFlujo != nullptr) {
+            char ruta[LONGITUD_MAXIMA_RUTA];
+            if (!rutaDeFuente(comunes.rutaFlujo, i, cantidad, ruta, LONGITUD_MAXIMA_RUTA)) {
+                delete sesiones[i];
+                sesiones[i] = nullptr;
+                codigo = 1;
+                continue;
+            }
+            sumideros[i] = new SumideroArchivo(ruta);
+            if (!sumideros[i]->estaAbierto()) {
+                delete sesiones[i];
+                sesiones[i] = nullptr;
+                codigo = 1;
+                continue;
+            }
+            sesiones[i]->getCarga()->setSumidero(sumideros[i], comunes.colaFlujo);
+        }
+        if (comunes.ventana > 0) {
+            sesiones[i]->getCarga()->setVentana(comunes.ventana);
+        }
+        if (comunes.cascada != nullptr) {
+            // Cada sesión tiene su propia cascada: los rotores avanzan con sus cargas
+            cascadas[i] = new CascadaDeRotores();
+            if (!cascadas[i]->configurar(comunes.cascada, !comunes.cascadaFija)) {
+                delete sesiones[i];
+                sesiones[i] = nullptr;
+                codigo = 1;
+                continue;
+            }
+            sesiones[i]->getRotor()->setCascada(cascadas[i]);
+        }
+        gestor.agregarSesion(sesiones[i]);
+        abiertas++;
+    }
+    
+    if (abiertas > 0) {
+        // En modo de flujo la carga puede ir a stdout: primero lo ya registrado
+        Registro::vaciar();
+        if (comunes.eventos) {
+            BucleEventos bucle;
+            for (int i = 0; i < cantidad; i++) {
+                if (sesiones[i] != nullptr) bucle.agregarSesion(sesiones[i]);
+            }
+            if (!bucle.ejecutar()) codigo = 1;
+            PRT7_RESUMEN("Bucle de eventos: " << bucle.getTurnos() << " turnos en "
+                         << bucle.getEsperas() << " esperas\n");
+        } else {
+            gestor.ejecutar();
+        }
+    }
     
-    if (tipo == 'L' || tipo == 'l') {
-        if (strlen(parametro) != 1) {
-            std::cout << "Error: TramaLoad debe tener exactamente un carácter: " << linea << std::endl;
-            return nullptr;
+    for (int i = 0; i < cantidad; i++) {
+        if (sesiones[i] != nullptr) {
+            PRT7_RESUMEN("\n=== Sesión " << (i + 1) << ": " << sesiones[i]->getNombre() << " ===\n"
+                         << "Procesadas: " << sesiones[i]->getLineas()
+                         << (sesiones[i]->esBinaria() ? " tramas binarias, " : " líneas, ")
+                         << sesiones[i]->getInvalidas() << " inválidas, "
+                         << sesiones[i]->getCarga()->getTotal() << " caracteres\n");
+            const BufferDeReorden* reorden = sesiones[i]->getReorden();
+            if (reorden != nullptr) {
+                PRT7_RESUMEN("Reorden: " << reorden->getReordenadas() << " esperaron a una anterior, "
+                             << reorden->getPerdidas() << " perdidas, "
+                             << reorden->getTardias() << " tardías, "
+                             << reorden->getDuplicadas() << " duplicadas\n");
+            }
+            sesiones[i]->getCarga()->imprimirMensaje();
+        }
+        delete sesiones[i];
+        delete cascadas[i];
+        delete sumideros[i];
+        delete puntos[i];
+        delete fuentes[i];
+        delete capturas[i];
+        delete puertos[i];
+    }
+    
+    delete[] sesiones;
+    delete[] puntos;
+    delete[] sumideros;
+    delete[] cascadas;
+    delete[] fuentes;
+    delete[] capturas;
+    delete[] puertos;
+    return codigo;
+}
+
+/**
+ * @brief Convierte una captura de texto al formato binario
+ * @param entrada Ruta de la captura de texto ('-' = entrada estándar)
+ * @param salida Ruta del archivo binario a crear
+ * @return Código de salida del programa
+ * @details Las cargas consecutivas se agrupan en tramas de lote; una línea
+ *          "END" termina la conversión y las líneas inválidas se omiten.
+ */
+int convertirABinario(const char* entrada, const char* salida) {
+    LectorCaptura lector(entrada);
+    if (!lector.estaAbierto()) return 1;
+    
+    FILE* destino = fopen(salida, "wb");
+    if (destino == nullptr) {
+        std::cerr << "Error: No se pudo crear " << salida << std::endl;
+        return 1;
+    }
+    
+    static const int TAMANIO_LOTE = 4096;
+    char racha[TAMANIO_LOTE];
+    int enRacha = 0;
+    char cabecera[MAX_BYTES_TRAMA_BINARIA];
+    long long lineas = 0;
+    long long omitidas = 0;
+    
+    const char* linea;
+    int longitud;
+    while (true) {
+        bool hayLinea = lector.siguienteLinea(&linea, &longitud);
+        bool esFin = !hayLinea || (longitud == 3 && memcmp(linea, "END", 3) == 0);
+        TramaCompacta trama;
+        trama.tipo = TRAMA_INVALIDA;
+        if (!esFin) {
+            lineas++;
+            trama = clasificarTrama(linea, longitud);
+            if (trama.tipo == TRAMA_INVALIDA) {
+                omitidas++;
+                continue;
+            }
+            if (trama.tipo == TRAMA_LOAD && enRacha < TAMANIO_LOTE) {
+                racha[enRacha++] = (char)trama.valor;
+                continue;
+            }
         }
-        char caracter = parametro[0];
-        std::cout << "Parseando: [" << linea << "] -> TramaLoad('" << caracter << "')" << std::endl;
-        return new TramaLoad(caracter);
         
-    } else if (tipo == 'M' || tipo == 'm') {
-        int rotacion = atoi(parametro);
-        std::cout << "Parseando: [" << linea << "] -> TramaMap(" << rotacion << ")" << std::endl;
-        return new TramaMap(rotacion);
+        // Volcar la racha: una carga sola ocupa menos como trama LOAD que como lote
+        if (enRacha == 1) {
+            TramaCompacta suelta;
+            suelta.tipo = TRAMA_LOAD;
+            suelta.valor = (unsigned char)racha[0];
+            fwrite(cabecera, 1, (size_t)codificarTramaBinaria(suelta, cabecera), destino);
+        } else if (enRacha > 1) {
+            fwrite(cabecera, 1, (size_t)codificarCabeceraLote(enRacha, cabecera), destino);
+            fwrite(racha, 1, (size_t)enRacha, destino);
+        }
+        enRacha = 0;
         
-    } else {
-        std::cout << "Error: Tipo de trama desconocido: " << tipo << std::endl;
-        return nullptr;
+        if (esFin) break;
+        if (trama.tipo == TRAMA_LOAD) {
+            racha[enRacha++] = (char)trama.valor;
+        } else {
+            fwrite(cabecera, 1, (size_t)codificarTramaBinaria(trama, cabecera), destino);
+        }
     }
+    
+    bool error = ferror(destino) != 0;
+    if (fclose(destino) != 0 || error) {
+        std::cerr << "Error: No se pudo escribir " << salida << std::endl;
+        return 1;
+    }
+    PRT7_RESUMEN("Convertidas " << lineas << " líneas (" << omitidas << " inválidas omitidas) a "
+                 << salida << "\n");
+    return 0;
 }
 
 /**
- * @brief Procesa una secuencia de tramas desde un array de strings
- * @param tramas Array de strings con las tramas
- * @param cantidad Número de elementos en el array
- * @param carga Lista de carga donde almacenar los resultados
- * @param rotor Rotor para el mapeo
+ * @brief Espera el primer byte de una fuente sin consumirlo
+ * @param fuente Fuente a examinar
+ * @param puerto Puerto de la fuente, o nullptr si es una captura
+ * @param primerByte Destino del primer byte
+ * @return false si la fuente terminó sin datos
  */
-void procesarSecuencia(const char* tramas[], int cantidad, ListaDeCarga* carga, RotorDeMapeo* rotor) {
-    std::cout << "\n=== Procesando secuencia de " << cantidad << " tramas ===" << std::endl;
+bool asomarPrimerByte(FuenteDeLineas* fuente, SerialReader* puerto, char* primerByte) {
+    while (true) {
+        const char* datos;
+        size_t disponibles;
+        int estado = fuente->asomarBytes(&datos, &disponibles);
+        if (estado == FuenteDeLineas::FIN_DE_FUENTE) return false;
+        if (estado != FuenteDeLineas::SIN_DATOS) {
+            *primerByte = datos[0];
+            return true;
+        }
+        if (puerto != nullptr) puerto->esperarDatos(10);
+    }
+}
+
+/**
+ * @brief Verifica que una entrada sea de tramas de texto
+ * @param primerByte Primer byte de la entrada
+ * @param modo Opción que sólo admite texto, para el mensaje de error
+ * @return false (con el error ya impreso) si la entrada tiene otro formato
+ */
+bool esEntradaDeTexto(char primerByte, const char* modo) {
+    if (esInicioBinario(primerByte)) {
+        std::cerr << "Error: " << modo << " no admite capturas binarias" << std::endl;
+        return false;
+    }
+    if (primerByte == 'S' || primerByte == 's') {
+        std::cerr << "Error: " << modo << " no admite tramas numeradas (S,n,TRAMA)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodifica una fuente con la tubería lector -> parser -> decodificador
+ * @param opcion Fuente indicada en la línea de comandos
+ * @param comunes Opciones de la sesión (se usan las del modo de flujo)
+ * @return Código de salida del programa
+ * @details La tubería clasifica líneas de texto sin numerar: una entrada
+ *          binaria o de tramas numeradas se rechaza antes de arrancar las etapas.
+ */
+int ejecutarPipeline(const OpcionFuente& opcion, const OpcionesSesion& comunes) {
+    SerialReader* puerto = nullptr;
+    LectorCaptura* captura = nullptr;
+    FuenteDeLineas* fuente = nullptr;
     
-    for (int i = 0; i < cantidad; i++) {
-        std::cout << "\n--- Trama " << (i+1) << "/" << cantidad << " ---" << std::endl;
+    if (opcion.esPuerto) {
+        puerto = new SerialReader(opcion.ruta, opcion.baudios);
+        if (puerto->estaConectado()) fuente = new FuenteSerial(puerto);
+    } else {
+        captura = new LectorCaptura(opcion.ruta);
+        if (captura->estaAbierto()) fuente = new FuenteCaptura(captura);
+    }
+    
+    int codigo = 1;
+    char primerByte = 0;
+    if (fuente != nullptr && asomarPrimerByte(fuente, puerto, &primerByte) &&
+        !esEntradaDeTexto(primerByte, "--pipeline")) {
+        delete fuente;
+        fuente = nullptr;
+    }
+    if (fuente != nullptr) {
+        RotorDeMapeo rotor;
+        rotor.setAlfabeto(comunes.alfabeto);
+        ListaDeCarga carga;
+        SumideroArchivo* sumidero = nullptr;
+        if (comunes.rutaFlujo != nullptr) {
+            sumidero = new SumideroArchivo(comunes.rutaFlujo);
+            if (sumidero->estaAbierto()) carga.setSumidero(sumidero, comunes.colaFlujo);
+        }
+        if (comunes.ventana > 0) carga.setVentana(comunes.ventana);
+        CascadaDeRotores cascada;
+        bool cascadaValida = true;
+        if (comunes.cascada != nullptr) {
+            cascadaValida = cascada.configurar(comunes.cascada, !comunes.cascadaFija);
+            rotor.setCascada(&cascada);
+        }
         
-        TramaBase* trama = parsearTrama(tramas[i]);
-        if (trama != nullptr) {
-            trama->procesar(carga, rotor);
-            delete trama;
-        } else {
-            std::cout << "ERROR: No se pudo procesar la trama: " << tramas[i] << std::endl;
+        if ((sumidero == nullptr || sumidero->estaAbierto()) && cascadaValida) {
+            Registro::vaciar();
+            PipelineDecodificador pipeline(fuente, &carga, &rotor);
+            pipeline.ejecutar();
+            
+            if (Registro::habilitado(REGISTRO_RESUMEN)) pipeline.imprimirEstadisticas();
+            carga.imprimirMensaje();
+            codigo = 0;
+        }
+        delete sumidero;
+    }
+    
+    delete fuente;
+    delete captura;
+    delete puerto;
+    return codigo;
+}
+
+/**
+ * @brief Decodifica una captura a través de su programa compilado
+ * @param opcion Fuente indicada en la línea de comandos (una captura en un archivo)
+ * @param comunes Opciones de la sesión (flujo, ventana y cascada)
+ * @param rutaPrograma Archivo del programa: se reutiliza si corresponde a la captura
+ * @return Código de salida del programa
+ * @details Si el programa guardado no existe o es de otra versión de la
+ *          captura, se compila de nuevo y se reemplaza. Sólo admite capturas de
+ *          texto sin numerar; el primer byte se revisa aunque el programa esté
+ *          vigente.
+ */
+int ejecutarPrograma(const OpcionFuente& opcion, const OpcionesSesion& comunes, const char* rutaPrograma) {
+    FirmaCaptura firma;
+    if (opcion.esPuerto || !ProgramaDeTramas::leerFirma(opcion.ruta, &firma)) {
+        std::cerr << "Error: --programa requiere una captura en un archivo regular" << std::endl;
+        return 1;
+    }
+    
+    LectorCaptura captura(opcion.ruta);
+    if (!captura.estaAbierto()) return 1;
+    const char* inicio;
+    size_t disponibles;
+    if (captura.asomarBytes(&inicio, &disponibles) && !esEntradaDeTexto(inicio[0], "--programa")) {
+        return 1;
+    }
+    
+    RotorDeMapeo rotor;
+    rotor.setAlfabeto(comunes.alfabeto);
+    ListaDeCarga carga;
+    ProgramaDeTramas programa(rotor.getTamanio());
+    if (programa.cargar(rutaPrograma, firma)) {
+        PRT7_RESUMEN("Programa " << rutaPrograma << " vigente: " << programa.getNumInstrucciones()
+                     << " instrucciones, la captura no se parsea\n");
+    } else {
+        // La firma se tomó antes de leer: si la captura cambia mientras tanto, el programa queda viejo
+        programa.reservar(firma.bytes);
+        if (!programa.compilarCaptura(&captura)) {
+            std::cerr << "Error: --programa sólo admite capturas de texto sin numerar" << std::endl;
+            return 1;
+        }
+        if (!programa.guardar(rutaPrograma, firma)) {
+            std::cerr << "Aviso: No se pudo guardar el programa " << rutaPrograma << std::endl;
         }
+        PRT7_RESUMEN("Compiladas " << programa.getLineas() << " líneas a " << programa.getNumInstrucciones()
+                     << " instrucciones en " << rutaPrograma << "\n");
     }
     
-    std::cout << "\n=== Secuencia completada ===" << std::endl;
+    SumideroArchivo* sumidero = nullptr;
+    if (comunes.rutaFlujo != nullptr) {
+        sumidero = new SumideroArchivo(comunes.rutaFlujo);
+        if (sumidero->estaAbierto()) carga.setSumidero(sumidero, comunes.colaFlujo);
+    }
+    if (comunes.ventana > 0) carga.setVentana(comunes.ventana);
+    CascadaDeRotores cascada;
+    bool cascadaValida = true;
+    if (comunes.cascada != nullptr) {
+        cascadaValida = cascada.configurar(comunes.cascada, !comunes.cascadaFija);
+        rotor.setCascada(&cascada);
+    }
+    
+    int codigo = 1;
+    if ((sumidero == nullptr || sumidero->estaAbierto()) && cascadaValida) {
+        Registro::vaciar();
+        long long invalidas = programa.getInvalidas() + programa.ejecutar(&rotor, &carga);
+        PRT7_RESUMEN("\n=== Sesión 1: " << opcion.ruta << " ===\n"
+                     << "Procesadas: " << programa.getLineas() << " líneas, "
+                     << invalidas << " inválidas, "
+                     << carga.getTotal() << " caracteres\n");
+        carga.imprimirMensaje();
+        codigo = 0;
+    }
+    delete sumidero;
+    return codigo;
+}
+
+/**
+ * @brief Decodifica una sola captura repartiendo sus bloques entre varios hilos
+ * @param opcion Captura indicada en la línea de comandos
+ * @param comunes Opciones de la sesión (hilos, flujo y ventana; sin cascada ni punto de control)
+ * @return Código de salida del programa
+ * @details Usa DecodificadorParalelo sobre el mapeo de la captura. Si la
+ *          captura no está proyectada en memoria (entrada estándar, Windows)
+ *          o no es de texto sin numerar, se decodifica con una sesión normal.
+ */
+int ejecutarParalelo(const OpcionFuente& opcion, const OpcionesSesion& comunes) {
+    LectorCaptura* captura = new LectorCaptura(opcion.ruta);
+    if (!captura->estaAbierto()) {
+        delete captura;
+        return 1;
+    }
+    // Asomarse a la entrada estándar la consumiría: sólo se mira el mapeo
+    const char* datos = nullptr;
+    size_t disponibles = 0;
+    bool hayDatos = captura->estaMapeado() && captura->asomarBytes(&datos, &disponibles);
+    if (!captura->estaMapeado() || (hayDatos && (esInicioBinario(datos[0]) || datos[0] == 'S' || datos[0] == 's'))) {
+        delete captura;
+        return ejecutarSesiones(&opcion, 1, comunes);
+    }
+    
+    RotorDeMapeo rotor;
+    rotor.setAlfabeto(comunes.alfabeto);
+    ListaDeCarga carga;
+    SumideroArchivo* sumidero = nullptr;
+    if (comunes.rutaFlujo != nullptr) {
+        sumidero = new SumideroArchivo(comunes.rutaFlujo);
+        if (sumidero->estaAbierto()) carga.setSumidero(sumidero, comunes.colaFlujo);
+    }
+    if (comunes.ventana > 0) carga.setVentana(comunes.ventana);
+    
+    int codigo = 1;
+    if (sumidero == nullptr || sumidero->estaAbierto()) {
+        Registro::vaciar();
+        // Más hilos que núcleos no adelantan nada y cada bloque se clasifica dos veces
+        int hilos = comunes.hilos;
+        int nucleos = (int)std::thread::hardware_concurrency();
+        if (nucleos > 0 && hilos > nucleos) hilos = nucleos;
+        DecodificadorParalelo decodificador(hilos);
+        long long lineas = 0;
+        long long invalidas = hayDatos ? decodificador.procesar(datos, (long long)disponibles, &carga, &rotor, &lineas) : 0;
+        PRT7_RESUMEN("\n=== Sesión 1: " << opcion.ruta << " ===\n"
+                     << "Procesadas: " << lineas << " líneas, "
+                     << invalidas << " inválidas, "
+                     << carga.getTotal() << " caracteres\n");
+        carga.imprimirMensaje();
+        codigo = 0;
+    }
+    delete sumidero;
+    delete captura;
+    return codigo;
 }
 
 /**
  * @brief Función principal del programa
+ * @param argc Número de argumentos
+ * @param argv Argumentos; sin fuentes se ejecuta la secuencia de ejemplo
  */
-int main() {
-    std::cout << "=== Decodificador de Protocolo Industrial PRT-7 ===" << std::endl;
-    std::cout << "Autor: Arturo Rosales Velázquez" << std::endl;
-    std::cout << "Iniciando sistema..." << std::endl;
+int main(int argc, char* argv[]) {
+    OpcionFuente* fuentes = new OpcionFuente[argc];
+    int cantidadFuentes = 0;
+    int baudios = 9600;
+    bool nivelIndicado = false;
+    bool usarPipeline = false;
+    const char* rutaPrograma = nullptr;
+    bool usarMetricas = false;
+    int periodoMetricas = 0;
+    OpcionesSesion comunes;
+    comunes.hilos = 0;
+    comunes.basePunto = nullptr;
+    comunes.cadaLineas = 100000;
+    comunes.rutaFlujo = nullptr;
+    comunes.colaFlujo = 65536;
+    comunes.ventana = 0;
+    comunes.cascada = nullptr;
+    comunes.cascadaFija = false;
+    comunes.alfabeto = nullptr;
+    comunes.reorden = BufferDeReorden::CAPACIDAD_POR_DEFECTO;
+    comunes.esperaReorden = BufferDeReorden::ESPERA_POR_DEFECTO_MS;
+    comunes.eventos = false;
+    for (int i = 1; i < argc; i++) {
+        NivelRegistro nivel;
+        if ((strcmp(argv[i], "--archivo") == 0 || strcmp(argv[i], "--puerto") == 0) && i + 1 < argc) {
+            fuentes[cantidadFuentes].esPuerto = (strcmp(argv[i], "--puerto") == 0);
+            fuentes[cantidadFuentes].ruta = argv[++i];
+            fuentes[cantidadFuentes].baudios = baudios;
+            cantidadFuentes++;
+        } else if (strcmp(argv[i], "--baudios") == 0 && i + 1 < argc) {
+            baudios = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            comunes.hilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--eventos") == 0) {
+            comunes.eventos = true;
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            usarPipeline = true;
+        } else if (strcmp(argv[i], "--programa") == 0 && i + 1 < argc) {
+            rutaPrograma = argv[++i];
+        } else if (strcmp(argv[i], "--metricas") == 0) {
+            usarMetricas = true;
+        } else if (strcmp(argv[i], "--metricas-cada") == 0 && i + 1 < argc) {
+            usarMetricas = true;
+            periodoMetricas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--punto-control") == 0 && i + 1 < argc) {
+            comunes.basePunto = argv[++i];
+        } else if (strcmp(argv[i], "--punto-control-cada") == 0 && i + 1 < argc) {
+            comunes.cadaLineas = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--flujo") == 0 && i + 1 < argc) {
+            comunes.rutaFlujo = argv[++i];
+        } else if (strcmp(argv[i], "--flujo-cola") == 0 && i + 1 < argc) {
+            comunes.colaFlujo = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ventana") == 0 && i + 1 < argc) {
+            comunes.ventana = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "--cascada") == 0 || strcmp(argv[i], "--cascada-fija") == 0) && i + 1 < argc) {
+            comunes.cascadaFija = (strcmp(argv[i], "--cascada-fija") == 0);
+            comunes.cascada = argv[++i];
+        } else if (strcmp(argv[i], "--alfabeto") == 0 && i + 1 < argc) {
+            comunes.alfabeto = RotorDeMapeo::buscarAlfabeto(argv[++i]);
+            if (comunes.alfabeto == nullptr) {
+                std::cerr << "Error: Alfabeto desconocido: " << argv[i]
+                          << " (mayusculas, minusculas, alfanumerico, base64 o bytes)" << std::endl;
+                delete[] fuentes;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--reorden") == 0 && i + 1 < argc) {
+            comunes.reorden = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reorden-espera") == 0 && i + 1 < argc) {
+            comunes.esperaReorden = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--a-binario") == 0 && i + 2 < argc) {
+            int codigo = convertirABinario(argv[i + 1], argv[i + 2]);
+            delete[] fuentes;
+            return codigo;
+        } else if (strcmp(argv[i], "--nivel") == 0 && i + 1 < argc &&
+                   Registro::interpretarNivel(argv[i + 1], &nivel)) {
+            Registro::setNivel(nivel);
+            nivelIndicado = true;
+            i++;
+        } else {
+            mostrarUso(argv[0]);
+            delete[] fuentes;
+            return 1;
+        }
+    }
+    
+    if (usarPipeline && cantidadFuentes != 1) {
+        std::cerr << "Error: --pipeline requiere exactamente una fuente" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    if (rutaPrograma != nullptr && (cantidadFuentes != 1 || usarPipeline || comunes.basePunto != nullptr)) {
+        std::cerr << "Error: --programa requiere exactamente una captura y no es compatible con "
+                  << "--pipeline ni con --punto-control" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    if (comunes.eventos && (usarPipeline || rutaPrograma != nullptr)) {
+        std::cerr << "Error: --eventos no es compatible con --pipeline ni con --programa" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    if (comunes.eventos && !BucleEventos::estaDisponible()) {
+        std::cerr << "Error: --eventos requiere epoll, que este sistema no tiene" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    if (usarPipeline && comunes.basePunto != nullptr) {
+        std::cerr << "Error: --punto-control no es compatible con --pipeline" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    if (comunes.basePunto != nullptr && comunes.rutaFlujo != nullptr) {
+        // El punto de control guarda la carga completa en BASE.carga, que ya es un flujo
+        std::cerr << "Error: --punto-control no es compatible con --flujo" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    if (comunes.ventana > 0 && (comunes.basePunto != nullptr || comunes.rutaFlujo != nullptr)) {
+        // Ambos necesitan la carga completa, y la ventana la descarta
+        std::cerr << "Error: --ventana no es compatible con --punto-control ni con --flujo" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    
+    if (comunes.cascada != nullptr && comunes.basePunto != nullptr) {
+        // El registro del punto de control sólo guarda la posición del rotor principal
+        std::cerr << "Error: --cascada no es compatible con --punto-control" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    
+    if (comunes.cascada != nullptr && comunes.alfabeto != nullptr &&
+        comunes.alfabeto != RotorDeMapeo::buscarAlfabeto("mayusculas")) {
+        // Los cableados de la cascada son permutaciones de A-Z
+        std::cerr << "Error: --cascada sólo admite el alfabeto mayusculas" << std::endl;
+        delete[] fuentes;
+        return 1;
+    }
+    
+    if (usarMetricas && !PRT7_METRICAS) {
+        std::cerr << "Aviso: el programa se compiló sin métricas (PRT7_METRICAS=OFF)" << std::endl;
+        usarMetricas = false;
+    }
+    if (usarMetricas) Metricas::iniciarReportes(periodoMetricas);
+    
+    if (cantidadFuentes > 0) {
+        // Por defecto las sesiones no registran nada por trama
+        if (!nivelIndicado) Registro::setNivel(REGISTRO_RESUMEN);
+        // Con una sola captura de texto, los hilos sobrantes del gestor decodifican sus bloques
+        bool usarParalelo = cantidadFuentes == 1 && comunes.hilos > 1 && !fuentes[0].esPuerto &&
+                            comunes.cascada == nullptr && comunes.basePunto == nullptr && !comunes.eventos;
+        int codigo = usarPipeline ? ejecutarPipeline(fuentes[0], comunes)
+                   : rutaPrograma != nullptr ? ejecutarPrograma(fuentes[0], comunes, rutaPrograma)
+                   : usarParalelo ? ejecutarParalelo(fuentes[0], comunes)
+                                  : ejecutarSesiones(fuentes, cantidadFuentes, comunes);
+        delete[] fuentes;
+        if (usarMetricas) {
+            Metricas::detenerReportes();
+            Metricas::imprimirEnError();
+        }
+        return codigo;
+    }
+    delete[] fuentes;
+    
+    PRT7_RESUMEN("=== Decodificador de Protocolo Industrial PRT-7 ===\n");
+    PRT7_RESUMEN("Autor: Arturo Rosales Velázquez\n");
+    PRT7_RESUMEN("Iniciando sistema...\n");
     
     RotorDeMapeo rotor;
+    rotor.setAlfabeto(comunes.alfabeto);
     ListaDeCarga carga;
     
     // Secuencia de ejemplo con tus datos originales
@@ -114,7 +836,7 @@ int main() {
     // Mostrar el mensaje final
     carga.imprimirMensaje();
     
-    std::cout << "\n--- Probando parser con casos de error ---" << std::endl;
+    PRT7_RESUMEN("\n--- Probando parser con casos de error ---\n");
     TramaBase* tramaError1 = parsearTrama("X,A");      
     TramaBase* tramaError2 = parsearTrama("L");        
     TramaBase* tramaError3 = parsearTrama("L;A");      
@@ -125,15 +847,16 @@ int main() {
     if (tramaError3) delete tramaError3;
     if (tramaError4) delete tramaError4;
     
-    std::cout << "\n--- Probando comunicación serial (comentado por seguridad) ---" << std::endl;
+    PRT7_RESUMEN("\n--- Probando comunicación serial (comentado por seguridad) ---\n");
     /*
     // Código para comunicación serial real (descomentado cuando se conecte Arduino)
     const char* puerto = "/dev/ttyUSB0";  // Cambiar según el sistema
     SerialReader serial(puerto, 9600);
     
     if (serial.estaConectado()) {
-        std::cout << "Esperando tramas del Arduino..." << std::endl;
+        PRT7_RESUMEN("Esperando tramas del Arduino...\n");
         char buffer[256];
+        PoolDeTramas pool;
         bool transmisionActiva = true;
         
         while (transmisionActiva) {
@@ -143,20 +866,24 @@ int main() {
                     continue;
                 }
                 
-                TramaBase* trama = parsearTrama(buffer);
+                TramaBase* trama = parsearTrama(buffer, &pool);
                 if (trama) {
                     trama->procesar(&carga, &rotor);
-                    delete trama;
                 }
             }
         }
         
         carga.imprimirMensaje();
     } else {
-        std::cout << "No se pudo conectar al puerto serial." << std::endl;
+        std::cerr << "No se pudo conectar al puerto serial." << std::endl;
     }
     */
     
-    std::cout << "\n--- Sistema finalizado ---" << std::endl;
+    PRT7_RESUMEN("\n--- Sistema finalizado ---\n");
+    if (usarMetricas) {
+        Metricas::detenerReportes();
+        Registro::vaciar();
+        Metricas::imprimirEnError();
+    }
     return 0;
 }
\ No newline at end of file